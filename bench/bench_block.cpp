@@ -0,0 +1,85 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_block.cpp
+ *
+ * @brief Block benchmarks.
+ */
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "bench_util.h"
+#include "cfdcore/cfdcore_block.h"
+#include "cfdcore/cfdcore_bytedata.h"
+
+using cfd::core::Block;
+using cfd::core::BlockView;
+using cfd::core::ByteData;
+using cfd::core::bench::AllocationRecorder;
+using cfd::core::bench::CreateBenchBlockData;
+
+static void BM_BlockParse(benchmark::State& state) {
+  uint32_t tx_count = static_cast<uint32_t>(state.range(0));
+  ByteData block_data = CreateBenchBlockData(tx_count, 2, 2);
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    Block block(block_data);
+    benchmark::DoNotOptimize(block);
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(tx_count));
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(block_data.GetDataSize()));
+}
+BENCHMARK(BM_BlockParse)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_BlockViewGetTxids(benchmark::State& state) {
+  uint32_t tx_count = static_cast<uint32_t>(state.range(0));
+  std::vector<uint8_t> buffer =
+      CreateBenchBlockData(tx_count, 2, 2).GetBytes();
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    BlockView view(buffer.data(), buffer.size());
+    benchmark::DoNotOptimize(view.GetTxids());
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(tx_count));
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_BlockViewGetTxids)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_BlockViewVerifyMerkleRoot(benchmark::State& state) {
+  uint32_t tx_count = static_cast<uint32_t>(state.range(0));
+  uint32_t thread_count = static_cast<uint32_t>(state.range(1));
+  std::vector<uint8_t> buffer =
+      CreateBenchBlockData(tx_count, 2, 2).GetBytes();
+  for (auto _ : state) {
+    BlockView view(buffer.data(), buffer.size());
+    benchmark::DoNotOptimize(view.VerifyMerkleRoot(thread_count));
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(tx_count));
+}
+BENCHMARK(BM_BlockViewVerifyMerkleRoot)
+    ->Args({1000, 1})
+    ->Args({1000, 2})
+    ->Args({1000, 4})
+    ->Args({4000, 1})
+    ->Args({4000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
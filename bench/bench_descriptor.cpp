@@ -0,0 +1,51 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_descriptor.cpp
+ *
+ * @brief Output descriptor benchmarks.
+ */
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "bench_util.h"
+#include "cfdcore/cfdcore_descriptor.h"
+#include "cfdcore/cfdcore_script.h"
+
+using cfd::core::Descriptor;
+using cfd::core::Script;
+using cfd::core::bench::AllocationRecorder;
+
+/// descriptor: single key.
+static const std::string kBenchDescriptorWpkh =
+    "wpkh([d34db33f/44'/0'/0']xpub6ERApfZwUNrhLCkDtcHTcxd75RbzS1ed54G1LkBUHQVHQKqhMkhgbmJbZRkrgZw4koxb5JaHWkY4ALHY2grBGRjaDMzQLcgJvLJuZZvRcEL/1/*)";  // NOLINT
+/// descriptor: multisig.
+static const std::string kBenchDescriptorMulti =
+    "sh(wsh(sortedmulti(2,xpub661MyMwAqRbcFW31YEwpkMuc5THy2PSt5bDMsktWQcFF8syAmRUapSCGu8ED9W6oDMSgv6Zz8idoc4a6mr8BDzTJY47LJhkJ8UB7WEGuduB/1/0/*,xpub69H7F5d8KSRgmmdJg2KhpAK8SR3DjMwAdkxj3ZuxV27CprR9LgpeyGmXUbC6wb7ERfvrnKZjXoUmmDznezpbZb7ap6r1D3tgFxHmwMkQTPH/0/0/*,[1422fcb3/0'/0'/68']02bedf98a38247c1718fdff7e07561b4dc15f10323ebb0accab581778e72c2e995)))";  // NOLINT
+
+static void BM_DescriptorParse(benchmark::State& state) {
+  const std::string& descriptor =
+      (state.range(0) == 0) ? kBenchDescriptorWpkh : kBenchDescriptorMulti;
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    Descriptor desc = Descriptor::Parse(descriptor);
+    benchmark::DoNotOptimize(desc);
+  }
+}
+BENCHMARK(BM_DescriptorParse)->Arg(0)->Arg(1);
+
+static void BM_DescriptorGetLockingScriptAll(benchmark::State& state) {
+  const std::string& descriptor =
+      (state.range(0) == 0) ? kBenchDescriptorWpkh : kBenchDescriptorMulti;
+  Descriptor desc = Descriptor::Parse(descriptor);
+  std::vector<std::string> args;
+  // one argument per '*' key (wpkh: 1, multi: 2)
+  args.emplace_back("1");
+  if (state.range(0) != 0) args.emplace_back("1");
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    std::vector<Script> scripts = desc.GetLockingScriptAll(&args);
+    benchmark::DoNotOptimize(scripts);
+  }
+}
+BENCHMARK(BM_DescriptorGetLockingScriptAll)->Arg(0)->Arg(1);
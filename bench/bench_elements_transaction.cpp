@@ -0,0 +1,89 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_elements_transaction.cpp
+ *
+ * @brief Elements transaction benchmarks.
+ */
+#ifndef CFD_DISABLE_ELEMENTS
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "bench_util.h"
+#include "cfdcore/cfdcore_amount.h"
+#include "cfdcore/cfdcore_elements_transaction.h"
+#include "cfdcore/cfdcore_key.h"
+#include "cfdcore/cfdcore_script.h"
+
+using cfd::core::Amount;
+using cfd::core::BlindFactor;
+using cfd::core::BlindParameter;
+using cfd::core::ConfidentialAssetId;
+using cfd::core::ConfidentialTransaction;
+using cfd::core::ConfidentialValue;
+using cfd::core::IssuanceBlindingKeyPair;
+using cfd::core::Pubkey;
+using cfd::core::Script;
+using cfd::core::ScriptUtil;
+using cfd::core::bench::AllocationRecorder;
+using cfd::core::bench::CreateBenchTxid;
+
+/// asset id
+static const std::string kBenchAsset =
+    "5ac9f65c0efcc4775e0baec4ec03abdde22473cd3cf33c0419ca290e0751b225";
+/// blinding pubkey
+static const std::string kBenchBlindingPubkey =
+    "0213c4451645063e1edd5fe76e5194864c2246d4c4e6c8df5a305224046e1ea2c4";
+
+static void BM_ConfidentialTransactionBlind(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  const int64_t kOutputAmount = 10000;
+  const int64_t kFeeAmount = 500;
+  ConfidentialAssetId asset(kBenchAsset);
+  Pubkey blinding_pubkey(kBenchBlindingPubkey);
+  Script locking_script =
+      ScriptUtil::CreateP2wpkhLockingScript(blinding_pubkey);
+
+  ConfidentialTransaction base_tx(2, 0);
+  base_tx.AddTxIn(CreateBenchTxid(0), 0, 0xffffffff);
+  std::vector<Pubkey> pubkeys;
+  for (uint32_t index = 0; index < count; ++index) {
+    base_tx.AddTxOut(Amount(kOutputAmount), asset, locking_script);
+    pubkeys.push_back(blinding_pubkey);
+  }
+  base_tx.AddTxOutFee(Amount(kFeeAmount), asset);
+  pubkeys.push_back(Pubkey());
+
+  BlindParameter param;
+  param.asset = asset;
+  param.abf = BlindFactor(
+      "95e6e0912047f088394be103f3a1761adcbd92466abfe41f0964a3aa2fc201e5");
+  param.vbf = BlindFactor(
+      "55bf185ddc2d1c747da2a82b8c9954179edec0af886daaf98d8a7b862e78bcee");
+  param.value = ConfidentialValue(
+      Amount(kOutputAmount * static_cast<int64_t>(count) + kFeeAmount));
+  std::vector<BlindParameter> blind_list(1, param);
+  std::vector<IssuanceBlindingKeyPair> issuance_keys;
+
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    recorder.Pause();
+    ConfidentialTransaction tx(base_tx);
+    recorder.Resume();
+    state.ResumeTiming();
+    tx.BlindTransaction(blind_list, issuance_keys, pubkeys);
+    benchmark::DoNotOptimize(tx);
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_ConfidentialTransactionBlind)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(5)
+    ->Arg(10)
+    ->Arg(20)
+    ->Unit(benchmark::kMillisecond);
+
+#endif  // CFD_DISABLE_ELEMENTS
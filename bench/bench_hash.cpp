@@ -0,0 +1,68 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_hash.cpp
+ *
+ * @brief Hash benchmarks.
+ */
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "cfdcore/cfdcore_util.h"
+
+using cfd::core::ByteDataView;
+using cfd::core::Sha256Hasher;
+using cfd::core::Sha256Implementation;
+
+static void BM_Sha256(benchmark::State& state) {
+  auto implementation = static_cast<Sha256Implementation>(state.range(1));
+  if (!Sha256Hasher::IsSupportedImplementation(implementation)) {
+    state.SkipWithError("unsupported sha256 implementation.");
+    return;
+  }
+  Sha256Implementation current = Sha256Hasher::GetImplementation();
+  Sha256Hasher::SetImplementation(implementation);
+  std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x5a);
+  uint8_t output[Sha256Hasher::kOutputSize];
+  for (auto _ : state) {
+    Sha256Hasher().Write(data.data(), data.size()).Finalize(output);
+    benchmark::DoNotOptimize(output);
+  }
+  Sha256Hasher::SetImplementation(current);
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_Sha256)
+    ->ArgNames({"size", "impl"})
+    ->ArgsProduct({{64, 1024, 65536}, {0, 1, 2}});
+
+static void BM_Sha256Batch(benchmark::State& state) {
+  auto implementation = static_cast<Sha256Implementation>(state.range(1));
+  if (!Sha256Hasher::IsSupportedImplementation(implementation)) {
+    state.SkipWithError("unsupported sha256 implementation.");
+    return;
+  }
+  Sha256Implementation current = Sha256Hasher::GetImplementation();
+  Sha256Hasher::SetImplementation(implementation);
+  static constexpr size_t kMessageCount = 256;
+  std::vector<uint8_t> data(
+      static_cast<size_t>(state.range(0)) * kMessageCount, 0x5a);
+  std::vector<ByteDataView> inputs;
+  for (size_t index = 0; index < kMessageCount; ++index) {
+    inputs.emplace_back(
+        data.data() + (index * static_cast<size_t>(state.range(0))),
+        static_cast<size_t>(state.range(0)));
+  }
+  std::vector<uint8_t> output(kMessageCount * Sha256Hasher::kOutputSize);
+  for (auto _ : state) {
+    Sha256Hasher::HashBatch(inputs.data(), inputs.size(), output.data());
+    benchmark::DoNotOptimize(output.data());
+  }
+  Sha256Hasher::SetImplementation(current);
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_Sha256Batch)
+    ->ArgNames({"size", "impl"})
+    ->ArgsProduct({{64, 250}, {0, 1, 3}});
@@ -0,0 +1,42 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_hdwallet.cpp
+ *
+ * @brief HD wallet benchmarks.
+ */
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "bench_util.h"
+#include "cfdcore/cfdcore_hdwallet.h"
+
+using cfd::core::ExtPubkey;
+using cfd::core::bench::AllocationRecorder;
+
+/// base extended pubkey.
+static const std::string kBenchExtPubkey =
+    "xpub661MyMwAqRbcGB88KaFbLGiYAat55APKhtWg4uYMkXAmfuSTbq2QYsn9sKJCj1YqZPafsboef4h4YbXXhNhPwMbkHTpkf3zLhx7HvFw1NDy";  // NOLINT
+
+static void BM_ExtPubkeyDerivePubkey(benchmark::State& state) {
+  uint32_t depth = static_cast<uint32_t>(state.range(0));
+  ExtPubkey ext_pubkey(kBenchExtPubkey);
+  std::vector<uint32_t> path(depth);
+  for (uint32_t index = 0; index < depth; ++index) path[index] = index;
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    ExtPubkey child = ext_pubkey.DerivePubkey(path);
+    benchmark::DoNotOptimize(child);
+  }
+}
+BENCHMARK(BM_ExtPubkeyDerivePubkey)->Arg(1)->Arg(3)->Arg(5);
+
+static void BM_ExtPubkeyDerivePubkeyString(benchmark::State& state) {
+  ExtPubkey ext_pubkey(kBenchExtPubkey);
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    ExtPubkey child = ext_pubkey.DerivePubkey("0/1/2/3/4");
+    benchmark::DoNotOptimize(child);
+  }
+}
+BENCHMARK(BM_ExtPubkeyDerivePubkeyString);
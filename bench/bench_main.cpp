@@ -0,0 +1,83 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_main.cpp
+ *
+ * @brief Benchmark entry point and allocation counter.
+ */
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark/benchmark.h"
+#include "bench_util.h"
+
+/// operator new call count.
+static std::atomic<uint64_t> g_allocation_count(0);
+/// operator new request bytes.
+static std::atomic<uint64_t> g_allocation_bytes(0);
+
+/**
+ * @brief Allocate memory and record the request.
+ * @param[in] size    allocate size
+ * @return allocated pointer (nullptr on failure)
+ */
+static void* AllocateWithCount(std::size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  g_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc((size == 0) ? 1 : size);
+}
+
+void* operator new(std::size_t size) {
+  void* ptr = AllocateWithCount(size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](std::size_t size) {
+  void* ptr = AllocateWithCount(size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return AllocateWithCount(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return AllocateWithCount(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+namespace cfd {
+namespace core {
+namespace bench {
+
+uint64_t GetAllocationCount() {
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+uint64_t GetAllocationBytes() {
+  return g_allocation_bytes.load(std::memory_order_relaxed);
+}
+
+}  // namespace bench
+}  // namespace core
+}  // namespace cfd
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_string_util.cpp
+ *
+ * @brief String encoding benchmarks.
+ */
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "cfdcore/cfdcore_util.h"
+
+using cfd::core::ByteData;
+using cfd::core::CryptoUtil;
+using cfd::core::StringUtil;
+
+static void BM_HexEncode(benchmark::State& state) {
+  std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x5a);
+  std::vector<char> output(data.size() * 2);
+  for (auto _ : state) {
+    StringUtil::ByteToString(data.data(), data.size(), output.data());
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_HexEncode)->Arg(32)->Arg(1024)->Arg(65536);
+
+static void BM_HexDecode(benchmark::State& state) {
+  std::string hex(static_cast<size_t>(state.range(0)) * 2, 'a');
+  std::vector<uint8_t> output(hex.size() / 2);
+  for (auto _ : state) {
+    StringUtil::StringToByte(hex.data(), hex.size(), output.data());
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(output.size()));
+}
+BENCHMARK(BM_HexDecode)->Arg(32)->Arg(1024)->Arg(65536);
+
+static void BM_EncodeBase58Check(benchmark::State& state) {
+  ByteData data(
+      std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5a));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CryptoUtil::EncodeBase58Check(data));
+  }
+}
+BENCHMARK(BM_EncodeBase58Check)->Arg(21)->Arg(78);
+
+static void BM_DecodeBase58Check(benchmark::State& state) {
+  ByteData data(
+      std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5a));
+  std::string str = CryptoUtil::EncodeBase58Check(data);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CryptoUtil::DecodeBase58Check(str));
+  }
+}
+BENCHMARK(BM_DecodeBase58Check)->Arg(21)->Arg(78);
+
+static void BM_EncodeBase64(benchmark::State& state) {
+  ByteData data(
+      std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5a));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CryptoUtil::EncodeBase64(data));
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_EncodeBase64)->Arg(1024)->Arg(65536);
+
+static void BM_DecodeBase64(benchmark::State& state) {
+  ByteData data(
+      std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5a));
+  std::string str = CryptoUtil::EncodeBase64(data);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CryptoUtil::DecodeBase64(str));
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_DecodeBase64)->Arg(1024)->Arg(65536);
@@ -0,0 +1,254 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_transaction.cpp
+ *
+ * @brief Transaction benchmarks (parse / sighash).
+ */
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "bench_util.h"
+#include "cfdcore/cfdcore_amount.h"
+#include "cfdcore/cfdcore_key.h"
+#include "cfdcore/cfdcore_script.h"
+#include "cfdcore/cfdcore_transaction.h"
+#include "cfdcore/cfdcore_transaction_stream.h"
+#include "cfdcore/cfdcore_util.h"
+
+using cfd::core::Amount;
+using cfd::core::ByteData;
+using cfd::core::ByteData256;
+using cfd::core::ByteDataView;
+using cfd::core::MemoryTransactionStreamSource;
+using cfd::core::Pubkey;
+using cfd::core::Script;
+using cfd::core::ScriptUtil;
+using cfd::core::SigHashAlgorithm;
+using cfd::core::SigHashType;
+using cfd::core::TaprootSigHashContext;
+using cfd::core::Transaction;
+using cfd::core::TransactionStreamReader;
+using cfd::core::TransactionView;
+using cfd::core::TxIn;
+using cfd::core::TxOut;
+using cfd::core::WitnessVersion;
+using cfd::core::bench::AllocationRecorder;
+using cfd::core::bench::CreateBenchTaprootTransaction;
+using cfd::core::bench::CreateBenchTransaction;
+
+static void BM_TransactionParseHex(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  std::string tx_hex = CreateBenchTransaction(count, count).GetHex();
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    Transaction tx(tx_hex);
+    benchmark::DoNotOptimize(tx);
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(tx_hex.size() / 2));
+}
+BENCHMARK(BM_TransactionParseHex)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_TransactionParseBytes(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  ByteData tx_data = CreateBenchTransaction(count, count).GetData();
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    Transaction tx(tx_data);
+    benchmark::DoNotOptimize(tx);
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(tx_data.GetDataSize()));
+}
+BENCHMARK(BM_TransactionParseBytes)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_TransactionViewParse(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  ByteData tx_data = CreateBenchTransaction(count, count).GetData();
+  const std::vector<uint8_t>& bytes = tx_data.GetBytes();
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    TransactionView view(bytes.data(), bytes.size());
+    benchmark::DoNotOptimize(view);
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_TransactionViewParse)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_TransactionStreamRead(benchmark::State& state) {
+  static constexpr uint32_t kTxCount = 1000;
+  ByteData tx_data =
+      CreateBenchTransaction(static_cast<uint32_t>(state.range(0)), 2)
+          .GetData();
+  std::vector<uint8_t> stream_bytes;
+  stream_bytes.reserve(tx_data.GetDataSize() * kTxCount);
+  for (uint32_t index = 0; index < kTxCount; ++index) {
+    stream_bytes.insert(
+        stream_bytes.end(), tx_data.GetBytes().begin(),
+        tx_data.GetBytes().end());
+  }
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    MemoryTransactionStreamSource source((ByteDataView(stream_bytes)));
+    TransactionStreamReader reader(&source);
+    TransactionView view;
+    while (reader.ReadNext(&view)) {
+      benchmark::DoNotOptimize(view);
+    }
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(stream_bytes.size()));
+}
+BENCHMARK(BM_TransactionStreamRead)->Arg(1)->Arg(10);
+
+static void BM_TransactionAddTxOut(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  Script script = ScriptUtil::CreateP2wpkhLockingScript(Pubkey(
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb"));
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    Transaction tx(2, 0);
+    for (uint32_t index = 0; index < count; ++index) {
+      tx.AddTxOut(Amount(static_cast<int64_t>(10000 + index)), script);
+    }
+    std::string tx_hex = tx.GetHex();
+    benchmark::DoNotOptimize(tx_hex);
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_TransactionAddTxOut)
+    ->Arg(100)
+    ->Arg(5000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TransactionAddTxOutList(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  Script script = ScriptUtil::CreateP2wpkhLockingScript(Pubkey(
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb"));
+  std::vector<TxOut> txout_list;
+  txout_list.reserve(count);
+  for (uint32_t index = 0; index < count; ++index) {
+    txout_list.emplace_back(
+        Amount(static_cast<int64_t>(10000 + index)), script);
+  }
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    Transaction tx(2, 0, std::vector<TxIn>(), txout_list);
+    std::string tx_hex = tx.GetHex();
+    benchmark::DoNotOptimize(tx_hex);
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_TransactionAddTxOutList)
+    ->Arg(100)
+    ->Arg(5000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TransactionGetSignatureHashLegacy(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  Transaction tx = CreateBenchTransaction(count, 2);
+  Script script = ScriptUtil::CreateP2pkhLockingScript(Pubkey(
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb"));
+  SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    for (uint32_t index = 0; index < count; ++index) {
+      ByteData256 sighash =
+          tx.GetSignatureHash(index, script.GetData(), sighash_type);
+      benchmark::DoNotOptimize(sighash);
+    }
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_TransactionGetSignatureHashLegacy)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TransactionGetSignatureHashWitnessV0(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  Transaction tx = CreateBenchTransaction(count, 2);
+  Script script = ScriptUtil::CreateP2pkhLockingScript(Pubkey(
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb"));
+  SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  Amount amount(static_cast<int64_t>(20000));
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    for (uint32_t index = 0; index < count; ++index) {
+      ByteData256 sighash = tx.GetSignatureHash(
+          index, script.GetData(), sighash_type, amount,
+          WitnessVersion::kVersion0);
+      benchmark::DoNotOptimize(sighash);
+    }
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_TransactionGetSignatureHashWitnessV0)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TransactionGetSchnorrSignatureHash(benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  std::vector<TxOut> utxo_list;
+  Transaction tx = CreateBenchTaprootTransaction(count, 2, &utxo_list);
+  SigHashType sighash_type(SigHashAlgorithm::kSigHashDefault);
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    for (uint32_t index = 0; index < count; ++index) {
+      ByteData256 sighash =
+          tx.GetSchnorrSignatureHash(index, sighash_type, utxo_list);
+      benchmark::DoNotOptimize(sighash);
+    }
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_TransactionGetSchnorrSignatureHash)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TransactionGetSchnorrSignatureHashContext(
+    benchmark::State& state) {
+  uint32_t count = static_cast<uint32_t>(state.range(0));
+  std::vector<TxOut> utxo_list;
+  Transaction tx = CreateBenchTaprootTransaction(count, 2, &utxo_list);
+  SigHashType sighash_type(SigHashAlgorithm::kSigHashDefault);
+  AllocationRecorder recorder(&state);
+  for (auto _ : state) {
+    TaprootSigHashContext context(tx, utxo_list);
+    for (uint32_t index = 0; index < count; ++index) {
+      ByteData256 sighash =
+          tx.GetSchnorrSignatureHash(index, sighash_type, context);
+      benchmark::DoNotOptimize(sighash);
+    }
+  }
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_TransactionGetSchnorrSignatureHashContext)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,124 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_util.cpp
+ *
+ * @brief Benchmark helper implementation.
+ */
+#include "bench_util.h"
+
+#include <vector>
+
+#include "cfdcore/cfdcore_amount.h"
+#include "cfdcore/cfdcore_key.h"
+#include "cfdcore/cfdcore_schnorrsig.h"
+#include "cfdcore/cfdcore_script.h"
+#include "cfdcore/cfdcore_util.h"
+
+namespace cfd {
+namespace core {
+namespace bench {
+
+/// pubkey used for dummy locking scripts.
+static constexpr const char* kBenchPubkey =
+    "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb";
+/// schnorr pubkey used for dummy taproot locking scripts.
+static constexpr const char* kBenchSchnorrPubkey =
+    "1777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb";
+
+AllocationRecorder::AllocationRecorder(benchmark::State* state)
+    : state_(state),
+      count_(0),
+      bytes_(0),
+      start_count_(GetAllocationCount()),
+      start_bytes_(GetAllocationBytes()),
+      paused_(false) {
+  // do nothing
+}
+
+AllocationRecorder::~AllocationRecorder() {
+  Pause();
+  state_->counters["allocs/op"] = benchmark::Counter(
+      static_cast<double>(count_), benchmark::Counter::kAvgIterations);
+  state_->counters["bytes/op"] = benchmark::Counter(
+      static_cast<double>(bytes_), benchmark::Counter::kAvgIterations);
+}
+
+void AllocationRecorder::Pause() {
+  if (!paused_) {
+    count_ += GetAllocationCount() - start_count_;
+    bytes_ += GetAllocationBytes() - start_bytes_;
+    paused_ = true;
+  }
+}
+
+void AllocationRecorder::Resume() {
+  if (paused_) {
+    start_count_ = GetAllocationCount();
+    start_bytes_ = GetAllocationBytes();
+    paused_ = false;
+  }
+}
+
+Txid CreateBenchTxid(uint32_t seed) {
+  Serializer builder;
+  builder.AddDirectNumber(seed);
+  return Txid(HashUtil::Sha256(builder.Output()));
+}
+
+Transaction CreateBenchTransaction(uint32_t txin_count, uint32_t txout_count) {
+  Transaction tx(2, 0);
+  for (uint32_t index = 0; index < txin_count; ++index) {
+    tx.AddTxIn(CreateBenchTxid(index), index % 4, 0xfffffffe);
+  }
+  Script locking_script =
+      ScriptUtil::CreateP2wpkhLockingScript(Pubkey(kBenchPubkey));
+  for (uint32_t index = 0; index < txout_count; ++index) {
+    tx.AddTxOut(Amount(static_cast<int64_t>(10000 + index)), locking_script);
+  }
+  return tx;
+}
+
+Transaction CreateBenchTaprootTransaction(
+    uint32_t txin_count, uint32_t txout_count, std::vector<TxOut>* utxo_list) {
+  Transaction tx = CreateBenchTransaction(txin_count, txout_count);
+  if (utxo_list != nullptr) {
+    Script locking_script = ScriptUtil::CreateTaprootLockingScript(
+        SchnorrPubkey(kBenchSchnorrPubkey).GetByteData256());
+    utxo_list->clear();
+    utxo_list->reserve(txin_count);
+    for (uint32_t index = 0; index < txin_count; ++index) {
+      utxo_list->emplace_back(
+          Amount(static_cast<int64_t>(20000 + index)), locking_script);
+    }
+  }
+  return tx;
+}
+
+ByteData CreateBenchBlockData(
+    uint32_t tx_count, uint32_t txin_per_tx, uint32_t txout_per_tx) {
+  Serializer builder;
+  builder.AddDirectNumber(static_cast<uint32_t>(0x20000000));
+  builder.AddDirectBytes(ByteData256());  // prev block hash
+  builder.AddDirectBytes(ByteData256());  // merkle root (not verified)
+  builder.AddDirectNumber(static_cast<uint32_t>(1600000000));
+  builder.AddDirectNumber(static_cast<uint32_t>(0x207fffff));
+  builder.AddDirectNumber(static_cast<uint32_t>(0));
+  builder.AddVariableInt(tx_count);
+  for (uint32_t index = 0; index < tx_count; ++index) {
+    Transaction tx(2, index);
+    for (uint32_t txin = 0; txin < txin_per_tx; ++txin) {
+      tx.AddTxIn(CreateBenchTxid(index * txin_per_tx + txin), txin, 0);
+    }
+    Script locking_script =
+        ScriptUtil::CreateP2wpkhLockingScript(Pubkey(kBenchPubkey));
+    for (uint32_t txout = 0; txout < txout_per_tx; ++txout) {
+      tx.AddTxOut(Amount(static_cast<int64_t>(1000 + txout)), locking_script);
+    }
+    builder.AddDirectBytes(tx.GetData());
+  }
+  return builder.Output();
+}
+
+}  // namespace bench
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,106 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file bench_util.h
+ *
+ * @brief Benchmark helper definitions.
+ */
+#ifndef CFD_CORE_BENCH_BENCH_UTIL_H_
+#define CFD_CORE_BENCH_BENCH_UTIL_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_transaction.h"
+
+namespace cfd {
+namespace core {
+namespace bench {
+
+/**
+ * @brief Total count of operator new calls since process start.
+ * @return allocation count
+ */
+uint64_t GetAllocationCount();
+
+/**
+ * @brief Total bytes requested by operator new since process start.
+ * @return allocation bytes
+ */
+uint64_t GetAllocationBytes();
+
+/**
+ * @brief Records heap allocations made inside a benchmark loop.
+ * @details The counters are reported as `allocs/op` and `bytes/op`
+ *   when this object is destroyed.
+ */
+class AllocationRecorder {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in,out] state   benchmark state
+   */
+  explicit AllocationRecorder(benchmark::State* state);
+  /**
+   * @brief destructor.
+   */
+  ~AllocationRecorder();
+  /**
+   * @brief Stop counting (use together with PauseTiming).
+   */
+  void Pause();
+  /**
+   * @brief Restart counting (use together with ResumeTiming).
+   */
+  void Resume();
+
+ private:
+  benchmark::State* state_;  //!< benchmark state
+  uint64_t count_;           //!< allocation count
+  uint64_t bytes_;           //!< allocation bytes
+  uint64_t start_count_;     //!< allocation count at start/resume
+  uint64_t start_bytes_;     //!< allocation bytes at start/resume
+  bool paused_;              //!< pause flag
+};
+
+/**
+ * @brief Create a deterministic dummy txid.
+ * @param[in] seed    seed value
+ * @return txid
+ */
+Txid CreateBenchTxid(uint32_t seed);
+
+/**
+ * @brief Create a transaction spending P2WPKH outputs.
+ * @param[in] txin_count    txin count
+ * @param[in] txout_count   txout count
+ * @return transaction
+ */
+Transaction CreateBenchTransaction(uint32_t txin_count, uint32_t txout_count);
+
+/**
+ * @brief Create a transaction spending P2TR outputs.
+ * @param[in] txin_count    txin count
+ * @param[in] txout_count   txout count
+ * @param[out] utxo_list    spent utxo list
+ * @return transaction
+ */
+Transaction CreateBenchTaprootTransaction(
+    uint32_t txin_count, uint32_t txout_count, std::vector<TxOut>* utxo_list);
+
+/**
+ * @brief Create a serialized block.
+ * @param[in] tx_count          transaction count
+ * @param[in] txin_per_tx       txin count per transaction
+ * @param[in] txout_per_tx      txout count per transaction
+ * @return block data
+ */
+ByteData CreateBenchBlockData(
+    uint32_t tx_count, uint32_t txin_per_tx, uint32_t txout_per_tx);
+
+}  // namespace bench
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_BENCH_BENCH_UTIL_H_
@@ -5,6 +5,7 @@ option(ENABLE_SHARED "enable shared library (ON or OFF. default:OFF)" OFF)
 endif()
 option(ENABLE_ELEMENTS "enable elements code (ON or OFF. default:ON)" ON)
 option(ENABLE_TESTS "enable code tests (ON or OFF. default:ON)" ON)
+option(ENABLE_BENCH "enable benchmark (ON or OFF. default:OFF)" OFF)
 option(ENABLE_EMSCRIPTEN "enable EMSCRIPTEN (ON or OFF. default:OFF)" OFF)
 option(STD_CPP_VERSION "c++ version (11/14/17. default:11)" "11")
 
@@ -161,6 +161,17 @@ class CFD_CORE_EXPORT Address {
    * @return object
    */
   Address& operator=(const Address& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  Address(Address&& object) noexcept;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  Address& operator=(Address&& object) noexcept;
 
   /**
    * @brief Constructor. (for string)
@@ -492,9 +503,15 @@ class CFD_CORE_EXPORT Address {
 
   /**
    * @brief Get address Hash.
+   * @return address hash reference
+   */
+  const ByteData& GetHash() const& { return hash_; }
+  /**
+   * @brief Get address Hash.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return address hash
    */
-  ByteData GetHash() const { return hash_; }
+  ByteData GetHash() const&& { return hash_; }
 
   /**
    * @brief Get PublicKey.
@@ -515,9 +532,15 @@ class CFD_CORE_EXPORT Address {
 
   /**
    * @brief Get Redeem Script.
+   * @return Script reference
+   */
+  const Script& GetScript() const& { return redeem_script_; }
+  /**
+   * @brief Get Redeem Script.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return Script
    */
-  Script GetScript() const { return redeem_script_; }
+  Script GetScript() const&& { return redeem_script_; }
 
   /**
    * @brief Get AddressFormatData.
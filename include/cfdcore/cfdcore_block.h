@@ -7,7 +7,9 @@
 #ifndef CFD_CORE_INCLUDE_CFDCORE_CFDCORE_BLOCK_H_
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_BLOCK_H_
 
+#include <mutex>  // NOLINT
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -31,51 +33,57 @@ struct BlockHeader {
 };
 
 /**
- * @brief block data class.
+ * @brief transaction byte range in the block data.
+ */
+struct BlockTxRange {
+  uint32_t offset = 0;          //!< transaction start offset
+  uint32_t size = 0;            //!< transaction size
+  uint32_t witness_offset = 0;  //!< witness start offset (0: no witness)
+  uint32_t witness_size = 0;    //!< witness size
+};
+
+/**
+ * @brief block view class.
+ * @details Holds the block buffer and the byte range of each transaction.
+ *   The buffer is not copied, so it must outlive this object
+ *   (e.g. memory mapped block file). Txids are calculated on first use,
+ *   and transaction objects are created only when requested.
+ *   The txid cache, txid index and merkle tree are guarded by
+ *   cache_mutex_, so all const functions (GetTxid, ExistTxid,
+ *   CalculateTxids, VerifyMerkleRoot, Block::GetTxOutProof, ...) can be
+ *   called concurrently on one object. Construction, assignment and Parse
+ *   are not thread-safe.
  */
-class CFD_CORE_EXPORT Block {
+class CFD_CORE_EXPORT BlockView {
  public:
   /**
    * @brief default constructor
    */
-  Block();
+  BlockView();
   /**
    * @brief constructor
-   * @param[in] hex     hex string
+   * @param[in] buffer    block buffer (not copied)
+   * @param[in] size      buffer size
    */
-  explicit Block(const std::string& hex);
-  /**
-   * @brief constructor
-   * @param[in] data    byte data
-   */
-  explicit Block(const ByteData& data);
+  BlockView(const uint8_t* buffer, size_t size);
   /**
    * @brief destructor.
    */
-  virtual ~Block() {
+  virtual ~BlockView() {
     // do nothing
   }
   /**
    * @brief copy constructor.
    * @param[in] object    object
    */
-  Block(const Block& object);
+  BlockView(const BlockView& object);
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
-  Block& operator=(const Block& object);
-  /**
-   * @brief Get a hex string.
-   * @return hex string
-   */
-  std::string GetHex() const;
-  /**
-   * @brief Get a ByteData object.
-   * @return ByteData object.
-   */
-  ByteData GetData() const;
+  BlockView& operator=(const BlockView& object);
+
   /**
    * @brief check valid data.
    * @retval true   valid.
@@ -87,20 +95,21 @@ class CFD_CORE_EXPORT Block {
    * @return block hash.
    */
   BlockHash GetBlockHash() const;
-
   /**
-   * @brief get txoutproof.
-   * @param[in] txid      target txid
-   * @return txoutproof.
+   * @brief get block header.
+   * @return block header.
    */
-  ByteData GetTxOutProof(const Txid& txid) const;
+  BlockHeader GetBlockHeader() const;
   /**
-   * @brief get txoutproof.
-   * @param[in] txids     target txid list
-   * @return txoutproof.
+   * @brief Serialize block header.
+   * @return Serialized block header.
    */
-  ByteData GetTxOutProof(const std::vector<Txid>& txids) const;
-
+  ByteData SerializeBlockHeader() const;
+  /**
+   * @brief Get the transaction count.
+   * @return transaction count
+   */
+  uint32_t GetTransactionCount() const;
   /**
    * @brief get txid.
    * @param[in] index   tx index
@@ -119,33 +128,184 @@ class CFD_CORE_EXPORT Block {
    * @retval false  not exist
    */
   bool ExistTxid(const Txid& txid) const;
+  /**
+   * @brief Get the transaction index.
+   * @param[in] txid    txid
+   * @return transaction index
+   */
+  uint32_t GetTransactionIndex(const Txid& txid) const;
+  /**
+   * @brief Get the transaction byte range.
+   * @param[in] index   tx index
+   * @return transaction byte range
+   */
+  const BlockTxRange& GetTransactionRange(uint32_t index) const;
+  /**
+   * @brief Get the transaction data.
+   * @param[in] index   tx index
+   * @return transaction data
+   */
+  ByteData GetTransactionData(uint32_t index) const;
+  /**
+   * @brief Get the transaction.
+   * @param[in] index   tx index
+   * @return transaction
+   */
+  Transaction GetTransaction(uint32_t index) const;
   /**
    * @brief Get the transaction.
    * @param[in] txid    txid
    * @return transaction
    */
   Transaction GetTransaction(const Txid& txid) const;
+
   /**
-   * @brief Get the transaction count.
-   * @return transaction count
+   * @brief Calculate all txids.
+   * @details The workers hash into a local list, which is then stored in
+   *   the txid cache under the lock.
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @return txid list.
    */
-  uint32_t GetTransactionCount() const;
+  std::vector<Txid> CalculateTxids(uint32_t thread_count = 1) const;
   /**
-   * @brief get block header.
-   * @return block header.
+   * @brief Calculate all witness hashes (wtxid).
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @return witness hash list.
    */
-  BlockHeader GetBlockHeader() const;
+  std::vector<ByteData256> CalculateWitnessHashes(
+      uint32_t thread_count = 1) const;
   /**
-   * @brief Serialize block header.
-   * @return Serialized block header.
+   * @brief Calculate the merkle root from the transactions.
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @return merkle root hash.
    */
-  ByteData SerializeBlockHeader() const;
+  BlockHash CalculateMerkleRoot(uint32_t thread_count = 1) const;
+  /**
+   * @brief Verify the merkle root in the block header.
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @retval true   match the block header.
+   * @retval false  unmatch the block header.
+   */
+  bool VerifyMerkleRoot(uint32_t thread_count = 1) const;
+  /**
+   * @brief Verify the witness commitment in the coinbase transaction.
+   * @details If the coinbase has no commitment, all transactions must
+   *   have no witness.
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @retval true   valid.
+   * @retval false  invalid.
+   * @see BIP-141
+   */
+  bool VerifyWitnessCommitment(uint32_t thread_count = 1) const;
+
+ protected:
+  const uint8_t* buffer_;                 ///< block buffer (not owned)
+  size_t buffer_size_;                    ///< block buffer size
+  BlockHeader header_;                    ///< block header
+  std::vector<BlockTxRange> tx_ranges_;   ///< transaction range list
+  //! Exclusive control object of the caches filled by const functions
+  mutable std::mutex cache_mutex_;
+  mutable std::vector<Txid> txids_;         ///< transaction id cache
+  mutable std::vector<uint8_t> has_txids_;  ///< transaction id cache flag
+  /// txid to transaction index map (built on first lookup)
+  mutable std::unordered_map<Txid, uint32_t> txid_index_map_;
+  /// merkle tree hash list per level (built on first use)
+  mutable std::vector<std::vector<ByteData256>> merkle_levels_;
+
+  /**
+   * @brief Parse the block header and transaction ranges.
+   * @param[in] buffer    block buffer (not copied)
+   * @param[in] size      buffer size
+   */
+  void Parse(const uint8_t* buffer, size_t size);
+  /**
+   * @brief Check the transaction index.
+   * @param[in] index   tx index
+   */
+  void CheckIndex(uint32_t index) const;
+  /**
+   * @brief Find the transaction index.
+   * @param[in] txid    txid
+   * @param[out] index  transaction index
+   * @retval true   found.
+   * @retval false  not found.
+   */
+  bool FindTransactionIndex(const Txid& txid, uint32_t* index) const;
+  /**
+   * @brief Get the merkle tree hash list per level.
+   * @details Level 0 is the txid list, the last level is the merkle root.
+   *   The list is built once and not changed by const functions after that,
+   *   so the returned reference stays valid until the object is modified.
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @return merkle tree hash list per level.
+   */
+  const std::vector<std::vector<ByteData256>>& GetMerkleLevels(
+      uint32_t thread_count = 1) const;
+};
+
+/**
+ * @brief block data class.
+ * @details Owns a copy of the block data. See also BlockView.
+ */
+class CFD_CORE_EXPORT Block : public BlockView {
+ public:
+  /**
+   * @brief default constructor
+   */
+  Block();
+  /**
+   * @brief constructor
+   * @param[in] hex     hex string
+   */
+  explicit Block(const std::string& hex);
+  /**
+   * @brief constructor
+   * @param[in] data    byte data
+   */
+  explicit Block(const ByteData& data);
+  /**
+   * @brief destructor.
+   */
+  virtual ~Block() {
+    // do nothing
+  }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  Block(const Block& object);
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  Block& operator=(const Block& object);
+
+  /**
+   * @brief Get a hex string.
+   * @return hex string
+   */
+  std::string GetHex() const;
+  /**
+   * @brief Get a ByteData object.
+   * @return ByteData object.
+   */
+  ByteData GetData() const;
+  /**
+   * @brief get txoutproof.
+   * @param[in] txid      target txid
+   * @return txoutproof.
+   */
+  ByteData GetTxOutProof(const Txid& txid) const;
+  /**
+   * @brief get txoutproof.
+   * @param[in] txids     target txid list
+   * @return txoutproof.
+   */
+  ByteData GetTxOutProof(const std::vector<Txid>& txids) const;
 
  private:
-  ByteData data_;              ///< byte data
-  BlockHeader header_;         ///< block header
-  std::vector<ByteData> txs_;  ///< transaction data list
-  std::vector<Txid> txids_;    ///< transaction id list
+  std::vector<uint8_t> data_;  ///< byte data
 };
 
 }  // namespace core
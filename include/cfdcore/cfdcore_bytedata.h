@@ -8,7 +8,9 @@
 #ifndef CFD_CORE_INCLUDE_CFDCORE_CFDCORE_BYTEDATA_H_
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_BYTEDATA_H_
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -37,6 +39,12 @@ class CFD_CORE_EXPORT ByteData {
    */
   ByteData(const std::vector<uint8_t>& vector);  // NOLINT
 
+  /**
+   * @brief constructor (move)
+   * @param[in] vector  byte array.
+   */
+  ByteData(std::vector<uint8_t>&& vector);  // NOLINT
+
   /**
    * @brief constructor
    * @param[in] hex  hex string.
@@ -64,9 +72,15 @@ class CFD_CORE_EXPORT ByteData {
 
   /**
    * @brief Get a byte array.
+   * @return byte array reference.
+   */
+  const std::vector<uint8_t>& GetBytes() const&;
+  /**
+   * @brief Get a byte array.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return byte array.
    */
-  std::vector<uint8_t> GetBytes() const;
+  std::vector<uint8_t> GetBytes() const&&;
 
   /**
    * @brief Get a byte data size.
@@ -74,6 +88,18 @@ class CFD_CORE_EXPORT ByteData {
    */
   size_t GetDataSize() const;
 
+  /**
+   * @brief Get the data pointer.
+   * @details No allocation or copy.
+   * @return data pointer
+   */
+  const uint8_t* data() const { return data_.data(); }
+  /**
+   * @brief Get the data size.
+   * @return data size
+   */
+  size_t size() const { return data_.size(); }
+
   /**
    * @brief Check is data empty.
    * @retval true   empty.
@@ -272,6 +298,13 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   explicit ByteData160(const ByteData& byte_data);
 
+  /**
+   * @brief constructor
+   * @param[in] buffer  buffer
+   * @param[in] size    buffer size (20byte)
+   */
+  explicit ByteData160(const uint8_t* buffer, size_t size);
+
   /**
    * @brief Get a hex string.
    * @return hex string.
@@ -284,6 +317,28 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   std::vector<uint8_t> GetBytes() const;
 
+  /**
+   * @brief Get the data pointer.
+   * @details No allocation or copy.
+   * @return data pointer (20 bytes)
+   */
+  const uint8_t* data() const { return data_.data(); }
+  /**
+   * @brief Get the data size.
+   * @return data size (always 20)
+   */
+  size_t size() const { return data_.size(); }
+  /**
+   * @brief Get the begin iterator.
+   * @return begin iterator
+   */
+  const uint8_t* begin() const { return data_.data(); }
+  /**
+   * @brief Get the end iterator.
+   * @return end iterator
+   */
+  const uint8_t* end() const { return data_.data() + data_.size(); }
+
   /**
    * @brief Check is data empty.
    * @retval true   empty.
@@ -327,7 +382,7 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   template <class ByteDataClass>
   ByteData Join(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -354,7 +409,7 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   template <class ByteDataClass>
   ByteData PushBack(const ByteDataClass& back_insert_data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = back_insert_data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -367,7 +422,7 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   template <class ByteDataClass>
   ByteData Concat(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -403,7 +458,7 @@ class CFD_CORE_EXPORT ByteData160 {
   /**
    * @brief 20byte fixed data.
    */
-  std::vector<uint8_t> data_;
+  std::array<uint8_t, 20> data_;
 };
 
 /**
@@ -435,6 +490,13 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   explicit ByteData256(const ByteData& byte_data);
 
+  /**
+   * @brief constructor
+   * @param[in] buffer  buffer
+   * @param[in] size    buffer size (32byte)
+   */
+  explicit ByteData256(const uint8_t* buffer, size_t size);
+
   /**
    * @brief Get a hex string.
    * @return hex string.
@@ -447,6 +509,28 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   std::vector<uint8_t> GetBytes() const;
 
+  /**
+   * @brief Get the data pointer.
+   * @details No allocation or copy.
+   * @return data pointer (32 bytes)
+   */
+  const uint8_t* data() const { return data_.data(); }
+  /**
+   * @brief Get the data size.
+   * @return data size (always 32)
+   */
+  size_t size() const { return data_.size(); }
+  /**
+   * @brief Get the begin iterator.
+   * @return begin iterator
+   */
+  const uint8_t* begin() const { return data_.data(); }
+  /**
+   * @brief Get the end iterator.
+   * @return end iterator
+   */
+  const uint8_t* end() const { return data_.data() + data_.size(); }
+
   /**
    * @brief Check is data empty.
    * @retval true   empty.
@@ -490,7 +574,7 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   template <class ByteDataClass>
   ByteData Join(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -517,7 +601,7 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   template <class ByteDataClass>
   ByteData PushBack(const ByteDataClass& back_insert_data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = back_insert_data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -530,7 +614,7 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   template <class ByteDataClass>
   ByteData Concat(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -561,12 +645,131 @@ class CFD_CORE_EXPORT ByteData256 {
    * @retval false  not equals
    */
   bool operator==(const ByteData256& object) const;
+  /**
+   * @brief Not equals operator.
+   * @param[in] object  target object.
+   * @retval true   not equals
+   * @retval false  equals
+   */
+  bool operator!=(const ByteData256& object) const;
+  /**
+   * @brief Compare operator. (byte order)
+   * @param[in] object  target object.
+   * @retval true   less than object
+   * @retval false  other
+   */
+  bool operator<(const ByteData256& object) const;
 
  private:
   /**
    * @brief 32byte fixed data.
    */
-  std::vector<uint8_t> data_;
+  std::array<uint8_t, 32> data_;
+};
+
+/**
+ * @class ByteDataView
+ * @brief Non-owning read-only view of a byte array.
+ * @details The referenced buffer must outlive this object.
+ */
+class CFD_CORE_EXPORT ByteDataView {
+ public:
+  /**
+   * @brief default constructor
+   */
+  ByteDataView() : data_(nullptr), size_(0) {}
+  /**
+   * @brief constructor
+   * @param[in] buffer  buffer
+   * @param[in] size    buffer size
+   */
+  ByteDataView(const uint8_t* buffer, size_t size)
+      : data_(buffer), size_(size) {}
+  /**
+   * @brief constructor
+   * @param[in] vector  byte array
+   */
+  explicit ByteDataView(const std::vector<uint8_t>& vector)
+      : data_(vector.data()), size_(vector.size()) {}
+  /**
+   * @brief constructor
+   * @param[in] byte_data   byte data
+   */
+  explicit ByteDataView(const ByteData& byte_data)
+      : data_(byte_data.data()), size_(byte_data.size()) {}
+  /**
+   * @brief constructor
+   * @param[in] byte_data   byte data
+   */
+  explicit ByteDataView(const ByteData160& byte_data)
+      : data_(byte_data.data()), size_(byte_data.size()) {}
+  /**
+   * @brief constructor
+   * @param[in] byte_data   byte data
+   */
+  explicit ByteDataView(const ByteData256& byte_data)
+      : data_(byte_data.data()), size_(byte_data.size()) {}
+
+  /**
+   * @brief Get the data pointer.
+   * @return data pointer
+   */
+  const uint8_t* data() const { return data_; }
+  /**
+   * @brief Get the data size.
+   * @return data size
+   */
+  size_t size() const { return size_; }
+  /**
+   * @brief Get the begin iterator.
+   * @return begin iterator
+   */
+  const uint8_t* begin() const { return data_; }
+  /**
+   * @brief Get the end iterator.
+   * @return end iterator
+   */
+  const uint8_t* end() const { return data_ + size_; }
+  /**
+   * @brief Check is data empty.
+   * @retval true   empty.
+   * @retval false  not empty.
+   */
+  bool IsEmpty() const { return size_ == 0; }
+
+  /**
+   * @brief Get a partial view.
+   * @param[in] offset  start offset
+   * @param[in] size    view size
+   * @return partial view
+   */
+  ByteDataView GetSubView(size_t offset, size_t size) const;
+  /**
+   * @brief Get a hex string.
+   * @return hex string.
+   */
+  std::string GetHex() const;
+  /**
+   * @brief Get a byte array (copy).
+   * @return byte array.
+   */
+  std::vector<uint8_t> GetBytes() const;
+  /**
+   * @brief Get a byte data object (copy).
+   * @return byte data
+   */
+  ByteData GetData() const;
+  /**
+   * @brief Check equals.
+   * @param[in] view  compare target object.
+   * @retval true   equals.
+   * @retval false  not equals.
+   */
+  bool Equals(const ByteDataView& view) const;
+
+ private:
+  const uint8_t* data_;  //!< buffer (not owned)
+  size_t size_;          //!< buffer size
 };
 
 /**
@@ -758,7 +961,7 @@ class CFD_CORE_EXPORT Deserializer {
   /**
    * @brief constructor.
    */
-  Deserializer() : offset_(0) {}
+  Deserializer() : buffer_(), view_(), offset_(0) {}
   /**
    * @brief constructor.
    * @param[in] buffer     buffer
@@ -769,6 +972,13 @@ class CFD_CORE_EXPORT Deserializer {
    * @param[in] buffer     buffer
    */
   explicit Deserializer(const ByteData& buffer);
+  /**
+   * @brief constructor.
+   * @details The buffer is not copied and must outlive this object.
+   *   A buffer larger than 4 GiB (UINT32_MAX) is rejected.
+   * @param[in] buffer   buffer view
+   */
+  explicit Deserializer(const ByteDataView& buffer);
   /**
    * @brief destructor.
    */
@@ -834,6 +1044,30 @@ class CFD_CORE_EXPORT Deserializer {
    * @return buffer
    */
   ByteData ReadVariableData();
+  /**
+   * @brief read buffer without copying.
+   * @details The view refers to the deserializer buffer.
+   * @param[in] size   read size.
+   * @return buffer view
+   */
+  ByteDataView ReadView(uint32_t size);
+  /**
+   * @brief read variable buffer without copying.
+   * @details The view refers to the deserializer buffer.
+   * @return buffer view
+   */
+  ByteDataView ReadVariableView();
+
+  /**
+   * @brief skip buffer without copying.
+   * @param[in] size   skip size.
+   */
+  void SkipBytes(uint64_t size);
+  /**
+   * @brief skip variable buffer without copying.
+   * @return skipped buffer size (excluding the size prefix).
+   */
+  uint64_t SkipVariableBuffer();
 
   /**
    * @brief get all read size.
@@ -849,7 +1083,8 @@ class CFD_CORE_EXPORT Deserializer {
   bool HasEof();
 
  protected:
-  std::vector<uint8_t> buffer_;  //!< buffer
+  std::vector<uint8_t> buffer_;  //!< owned buffer (empty if view)
+  ByteDataView view_;            //!< read target (buffer_ or external)
   uint32_t offset_;              //!< offset
 
   /**
@@ -862,4 +1097,24 @@ class CFD_CORE_EXPORT Deserializer {
 }  // namespace core
 }  // namespace cfd
 
+namespace std {
+
+/**
+ * @brief hash function of ByteData256.
+ * @details SipHash-2-4 with the key created once per process, so it is safe
+ *   for the keys from untrusted data. The hash value differs per process and
+ *   must not be stored or sent.
+ */
+template <>
+struct CFD_CORE_EXPORT hash<cfd::core::ByteData256> {
+  /**
+   * @brief calculate hash value.
+   * @param[in] data    byte data
+   * @return hash value
+   */
+  size_t operator()(const cfd::core::ByteData256& data) const;
+};
+
+}  // namespace std
+
 #endif  // CFD_CORE_INCLUDE_CFDCORE_CFDCORE_BYTEDATA_H_
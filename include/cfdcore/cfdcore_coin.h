@@ -8,6 +8,7 @@
 #ifndef CFD_CORE_INCLUDE_CFDCORE_CFDCORE_COIN_H_
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_COIN_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -63,6 +64,18 @@ class CFD_CORE_EXPORT Txid {
    * @return ByteData object.
    */
   const ByteData GetData() const;
+  /**
+   * @brief Get the internal byte data without copying.
+   * @details A default constructed object returns zero bytes.
+   * @return ByteData256 object.
+   */
+  const ByteData256& GetByteData256() const&;
+  /**
+   * @brief Get the internal byte data.
+   * @details Temporary objects return a copy to avoid a dangling reference.
+   * @return ByteData256 object.
+   */
+  ByteData256 GetByteData256() const&&;
   /**
    * @brief compare Txid.
    * @param txid  compare target.
@@ -76,9 +89,31 @@ class CFD_CORE_EXPORT Txid {
    * @retval false  invalid.
    */
   bool IsValid() const;
+  /**
+   * @brief Equals operator.
+   * @param[in] object  target object.
+   * @retval true   equals
+   * @retval false  not equals
+   */
+  bool operator==(const Txid& object) const;
+  /**
+   * @brief Not equals operator.
+   * @param[in] object  target object.
+   * @retval true   not equals
+   * @retval false  equals
+   */
+  bool operator!=(const Txid& object) const;
+  /**
+   * @brief Compare operator. (internal byte order)
+   * @param[in] object  target object.
+   * @retval true   less than object
+   * @retval false  other
+   */
+  bool operator<(const Txid& object) const;
 
  private:
-  ByteData data_;  ///< byte data
+  ByteData256 data_;  ///< byte data
+  bool is_valid_;     ///< valid flag (default constructed: false)
 };
 
 /**
@@ -89,9 +124,7 @@ class CFD_CORE_EXPORT BlockHash {
   /**
    * @brief default constructor
    */
-  BlockHash() {
-    // do nothing
-  }
+  BlockHash();
   /**
    * @brief constructor
    * @param[in] hex     hex string
@@ -129,18 +162,89 @@ class CFD_CORE_EXPORT BlockHash {
    * @return ByteData object.
    */
   const ByteData GetData() const;
+  /**
+   * @brief Get the internal byte data without copying.
+   * @details A default constructed object returns zero bytes.
+   * @return ByteData256 object.
+   */
+  const ByteData256& GetByteData256() const&;
+  /**
+   * @brief Get the internal byte data.
+   * @details Temporary objects return a copy to avoid a dangling reference.
+   * @return ByteData256 object.
+   */
+  ByteData256 GetByteData256() const&&;
+  /**
+   * @brief compare BlockHash.
+   * @param block_hash  compare target.
+   * @retval true   equals.
+   * @retval false  not equals.
+   */
+  bool Equals(const BlockHash& block_hash) const;
   /**
    * @brief check valid data.
    * @retval true   valid.
    * @retval false  invalid.
    */
   bool IsValid() const;
+  /**
+   * @brief Equals operator.
+   * @param[in] object  target object.
+   * @retval true   equals
+   * @retval false  not equals
+   */
+  bool operator==(const BlockHash& object) const;
+  /**
+   * @brief Not equals operator.
+   * @param[in] object  target object.
+   * @retval true   not equals
+   * @retval false  equals
+   */
+  bool operator!=(const BlockHash& object) const;
+  /**
+   * @brief Compare operator. (internal byte order)
+   * @param[in] object  target object.
+   * @retval true   less than object
+   * @retval false  other
+   */
+  bool operator<(const BlockHash& object) const;
 
  private:
-  ByteData data_;  ///< byte data
+  ByteData256 data_;  ///< byte data
+  bool is_valid_;     ///< valid flag (default constructed: false)
 };
 
 }  // namespace core
 }  // namespace cfd
 
+namespace std {
+
+/**
+ * @brief hash function of Txid.
+ */
+template <>
+struct CFD_CORE_EXPORT hash<cfd::core::Txid> {
+  /**
+   * @brief calculate hash value.
+   * @param[in] txid    txid
+   * @return hash value
+   */
+  size_t operator()(const cfd::core::Txid& txid) const;
+};
+
+/**
+ * @brief hash function of BlockHash.
+ */
+template <>
+struct CFD_CORE_EXPORT hash<cfd::core::BlockHash> {
+  /**
+   * @brief calculate hash value.
+   * @param[in] block_hash    block hash
+   * @return hash value
+   */
+  size_t operator()(const cfd::core::BlockHash& block_hash) const;
+};
+
+}  // namespace std
+
 #endif  // CFD_CORE_INCLUDE_CFDCORE_CFDCORE_COIN_H_
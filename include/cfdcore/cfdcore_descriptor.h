@@ -292,6 +292,17 @@ class CFD_CORE_EXPORT DescriptorKeyReference {
    * @return DescriptorKeyReference object
    */
   DescriptorKeyReference& operator=(const DescriptorKeyReference& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    DescriptorKeyReference object
+   */
+  DescriptorKeyReference(DescriptorKeyReference&& object) noexcept;
+  /**
+   * @brief move assignment.
+   * @param[in] object    DescriptorKeyReference object
+   * @return DescriptorKeyReference object
+   */
+  DescriptorKeyReference& operator=(DescriptorKeyReference&& object) noexcept;
 
   /**
    * @brief getting pubkey.
@@ -449,12 +460,30 @@ class CFD_CORE_EXPORT DescriptorScriptReference {
    */
   DescriptorScriptReference& operator=(
       const DescriptorScriptReference& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    DescriptorScriptReference object
+   */
+  DescriptorScriptReference(DescriptorScriptReference&& object) noexcept;
+  /**
+   * @brief move assignment.
+   * @param[in] object    DescriptorScriptReference object
+   * @return DescriptorScriptReference object
+   */
+  DescriptorScriptReference& operator=(
+      DescriptorScriptReference&& object) noexcept;
 
   /**
    * @brief getting locking script.
+   * @return locking script reference
+   */
+  const Script& GetLockingScript() const&;
+  /**
+   * @brief getting locking script.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return locking script
    */
-  Script GetLockingScript() const;
+  Script GetLockingScript() const&&;
   /**
    * @brief exist address data.
    * @retval true  exist
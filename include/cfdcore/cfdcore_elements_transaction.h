@@ -1067,11 +1067,25 @@ class CFD_CORE_EXPORT ConfidentialTransaction : public AbstractTransaction {
    * @param[in] byte_data   tx byte data
    */
   explicit ConfidentialTransaction(const ByteData& byte_data);
+  /**
+   * @brief constructor
+   * @details The buffer is parsed without an intermediate copy.
+   * @param[in] byte_data   tx byte data view
+   */
+  explicit ConfidentialTransaction(const ByteDataView& byte_data);
   /**
    * @brief copy constructor
    * @param[in] transaction   transaction object
    */
   explicit ConfidentialTransaction(const ConfidentialTransaction& transaction);
+  /**
+   * @brief move constructor
+   * @details The moved-from object holds no libwally tx. It has no TxIn
+   *   and TxOut, GetVersion and GetLockTime return 0, and serializing it
+   *   throws CfdException. Adding a TxIn or TxOut allocates a new one.
+   * @param[in,out] transaction   transaction object
+   */
+  ConfidentialTransaction(ConfidentialTransaction&& transaction) noexcept;
   /**
    * @brief destructor
    */
@@ -1085,6 +1099,13 @@ class CFD_CORE_EXPORT ConfidentialTransaction : public AbstractTransaction {
    */
   ConfidentialTransaction& operator=(
       const ConfidentialTransaction& transaction) &;
+  /**
+   * @brief move assignment.
+   * @param[in,out] transaction   transaction object
+   * @return Confidential Transaction
+   */
+  ConfidentialTransaction& operator=(
+      ConfidentialTransaction&& transaction) & noexcept;
   /**
    * @brief Get TxIn.
    * @param[in] index   index
@@ -1690,6 +1711,12 @@ class CFD_CORE_EXPORT ConfidentialTransaction : public AbstractTransaction {
    * @param[in] hex_string    HEX string.
    */
   void SetFromHex(const std::string& hex_string);
+  /**
+   * @brief Set Transaction information from byte data.
+   * @param[in] buffer        Transaction byte data
+   * @param[in] buffer_size   byte data size
+   */
+  void SetFromBytes(const uint8_t* buffer, size_t buffer_size);
 
  private:
   /**
@@ -1830,6 +1857,347 @@ class CFD_CORE_EXPORT ConfidentialTransaction : public AbstractTransaction {
       ExtPubkey* base_ext_pubkey, Address* descriptor_derive_address);
 };
 
+class ConfidentialTransactionView;
+
+/**
+ * @brief Confidential TxIn view class.
+ * @details Refers to the TxIn area of a ConfidentialTransactionView buffer.
+ */
+class CFD_CORE_EXPORT ConfidentialTxInView {
+ public:
+  /**
+   * @brief constructor.
+   */
+  ConfidentialTxInView();
+
+  /**
+   * @brief Get the txid bytes (internal byte order).
+   * @return txid view
+   */
+  ByteDataView GetTxidView() const;
+  /**
+   * @brief Get the txid.
+   * @return txid
+   */
+  Txid GetTxid() const;
+  /**
+   * @brief Get the vout. (issuance and pegin flags are excluded)
+   * @return vout
+   */
+  uint32_t GetVout() const;
+  /**
+   * @brief Get the outpoint.
+   * @return outpoint
+   */
+  OutPoint GetOutPoint() const;
+  /**
+   * @brief Get the unlocking script bytes.
+   * @return unlocking script view
+   */
+  ByteDataView GetUnlockingScriptView() const;
+  /**
+   * @brief Get the sequence.
+   * @return sequence
+   */
+  uint32_t GetSequence() const;
+  /**
+   * @brief Check coinbase input.
+   * @retval true   coinbase
+   * @retval false  other
+   */
+  bool IsCoinBase() const;
+  /**
+   * @brief Check pegin input.
+   * @retval true   pegin
+   * @retval false  other
+   */
+  bool IsPegin() const;
+  /**
+   * @brief Check issuance input.
+   * @retval true   issuance or reissuance
+   * @retval false  other
+   */
+  bool HasIssuance() const;
+  /**
+   * @brief Get the blinding nonce bytes. (empty if no issuance)
+   * @return blinding nonce view
+   */
+  ByteDataView GetBlindingNonceView() const;
+  /**
+   * @brief Get the asset entropy bytes. (empty if no issuance)
+   * @return asset entropy view
+   */
+  ByteDataView GetAssetEntropyView() const;
+  /**
+   * @brief Get the issuance amount bytes. (empty if no issuance)
+   * @return issuance amount view
+   */
+  ByteDataView GetIssuanceAmountView() const;
+  /**
+   * @brief Get the issuance amount.
+   * @return issuance amount
+   */
+  ConfidentialValue GetIssuanceAmount() const;
+  /**
+   * @brief Get the inflation keys bytes. (empty if no issuance)
+   * @return inflation keys view
+   */
+  ByteDataView GetInflationKeysView() const;
+  /**
+   * @brief Get the inflation keys.
+   * @return inflation keys
+   */
+  ConfidentialValue GetInflationKeys() const;
+  /**
+   * @brief Get the issuance amount rangeproof bytes.
+   * @return issuance amount rangeproof view
+   */
+  ByteDataView GetIssuanceAmountRangeproofView() const;
+  /**
+   * @brief Get the inflation keys rangeproof bytes.
+   * @return inflation keys rangeproof view
+   */
+  ByteDataView GetInflationKeysRangeproofView() const;
+  /**
+   * @brief Get the witness stack count.
+   * @return witness stack count
+   */
+  uint32_t GetScriptWitnessStackNum() const;
+  /**
+   * @brief Get the witness stack item.
+   * @param[in] index   stack index
+   * @return witness stack item view
+   */
+  ByteDataView GetScriptWitnessStack(uint32_t index) const;
+  /**
+   * @brief Get the pegin witness stack count.
+   * @return pegin witness stack count
+   */
+  uint32_t GetPeginWitnessStackNum() const;
+  /**
+   * @brief Get the pegin witness stack item.
+   * @param[in] index   stack index
+   * @return pegin witness stack item view
+   */
+  ByteDataView GetPeginWitnessStack(uint32_t index) const;
+
+ private:
+  friend class ConfidentialTransactionView;
+
+  const uint8_t* outpoint_;             //!< outpoint (txid + vout)
+  uint32_t vout_;                       //!< vout (serialized, with flags)
+  ByteDataView unlocking_script_;       //!< unlocking script
+  uint32_t sequence_;                   //!< sequence
+  ByteDataView blinding_nonce_;         //!< blinding nonce
+  ByteDataView asset_entropy_;          //!< asset entropy
+  ByteDataView issuance_amount_;        //!< issuance amount
+  ByteDataView inflation_keys_;         //!< inflation keys
+  ByteDataView issuance_amount_rangeproof_;  //!< issuance amount rangeproof
+  ByteDataView inflation_keys_rangeproof_;   //!< inflation keys rangeproof
+  ByteDataView witness_;                //!< witness area (count + items)
+  uint32_t witness_num_;                //!< witness stack count
+  ByteDataView pegin_witness_;          //!< pegin witness area
+  uint32_t pegin_witness_num_;          //!< pegin witness stack count
+};
+
+/**
+ * @brief Confidential TxOut view class.
+ * @details Refers to the TxOut area of a ConfidentialTransactionView buffer.
+ */
+class CFD_CORE_EXPORT ConfidentialTxOutView {
+ public:
+  /**
+   * @brief constructor.
+   */
+  ConfidentialTxOutView();
+
+  /**
+   * @brief Get the asset bytes.
+   * @return asset view (1 byte if it is empty)
+   */
+  ByteDataView GetAssetView() const;
+  /**
+   * @brief Get the asset.
+   * @return asset
+   */
+  ConfidentialAssetId GetAsset() const;
+  /**
+   * @brief Get the value bytes.
+   * @return value view (1 byte if it is empty)
+   */
+  ByteDataView GetConfidentialValueView() const;
+  /**
+   * @brief Get the value.
+   * @return value
+   */
+  ConfidentialValue GetConfidentialValue() const;
+  /**
+   * @brief Get the nonce bytes.
+   * @return nonce view (1 byte if it is empty)
+   */
+  ByteDataView GetNonceView() const;
+  /**
+   * @brief Get the nonce.
+   * @return nonce
+   */
+  ConfidentialNonce GetNonce() const;
+  /**
+   * @brief Get the locking script bytes.
+   * @return locking script view
+   */
+  ByteDataView GetLockingScriptView() const;
+  /**
+   * @brief Get the locking script.
+   * @return locking script
+   */
+  Script GetLockingScript() const;
+  /**
+   * @brief Get the surjection proof bytes.
+   * @return surjection proof view
+   */
+  ByteDataView GetSurjectionProofView() const;
+  /**
+   * @brief Get the range proof bytes.
+   * @return range proof view
+   */
+  ByteDataView GetRangeProofView() const;
+
+ private:
+  friend class ConfidentialTransactionView;
+
+  ByteDataView asset_;              //!< asset
+  ByteDataView value_;              //!< value
+  ByteDataView nonce_;              //!< nonce
+  ByteDataView locking_script_;     //!< locking script
+  ByteDataView surjection_proof_;   //!< surjection proof
+  ByteDataView range_proof_;        //!< range proof
+};
+
+/**
+ * @brief Confidential transaction view class.
+ * @details Validates a serialized confidential transaction once and gives
+ *   read-only access to its fields without copying them. The buffer is not
+ *   copied, so it must outlive this object (and its TxIn / TxOut views).
+ *   Use GetTransaction() to get a mutable ConfidentialTransaction.
+ */
+class CFD_CORE_EXPORT ConfidentialTransactionView {
+ public:
+  /**
+   * @brief default constructor
+   */
+  ConfidentialTransactionView();
+  /**
+   * @brief constructor
+   * @param[in] buffer    transaction buffer (not copied)
+   * @param[in] size      buffer size
+   */
+  ConfidentialTransactionView(const uint8_t* buffer, size_t size);
+  /**
+   * @brief constructor
+   * @param[in] buffer    transaction buffer (not copied)
+   */
+  explicit ConfidentialTransactionView(const ByteDataView& buffer);
+
+  /**
+   * @brief check valid data.
+   * @retval true   valid.
+   * @retval false  invalid. (default constructed)
+   */
+  bool IsValid() const;
+  /**
+   * @brief Get the version.
+   * @return version
+   */
+  int32_t GetVersion() const;
+  /**
+   * @brief Get the lock time.
+   * @return lock time
+   */
+  uint32_t GetLockTime() const;
+  /**
+   * @brief Get the TxIn count.
+   * @return TxIn count
+   */
+  uint32_t GetTxInCount() const;
+  /**
+   * @brief Get the TxIn view.
+   * @param[in] index   TxIn index
+   * @return TxIn view
+   */
+  const ConfidentialTxInView& GetTxIn(uint32_t index) const;
+  /**
+   * @brief Get the TxIn view list.
+   * @return TxIn view list
+   */
+  const std::vector<ConfidentialTxInView>& GetTxInList() const;
+  /**
+   * @brief Get the TxOut count.
+   * @return TxOut count
+   */
+  uint32_t GetTxOutCount() const;
+  /**
+   * @brief Get the TxOut view.
+   * @param[in] index   TxOut index
+   * @return TxOut view
+   */
+  const ConfidentialTxOutView& GetTxOut(uint32_t index) const;
+  /**
+   * @brief Get the TxOut view list.
+   * @return TxOut view list
+   */
+  const std::vector<ConfidentialTxOutView>& GetTxOutList() const;
+  /**
+   * @brief Whether it holds witness information.
+   * @retval true   witness exist.
+   * @retval false  witness not found.
+   */
+  bool HasWitness() const;
+  /**
+   * @brief Get the transaction bytes.
+   * @return transaction view
+   */
+  ByteDataView GetData() const;
+  /**
+   * @brief Get the total byte size.
+   * @return total byte size
+   */
+  uint32_t GetTotalSize() const;
+  /**
+   * @brief Get the vsize.
+   * @return vsize
+   */
+  uint32_t GetVsize() const;
+  /**
+   * @brief Get the weight.
+   * @return weight
+   */
+  uint32_t GetWeight() const;
+  /**
+   * @brief Get the txid.
+   * @return txid
+   */
+  Txid GetTxid() const;
+  /**
+   * @brief Get the witness hash (wtxid).
+   * @return witness hash
+   */
+  ByteData256 GetWitnessHash() const;
+  /**
+   * @brief Create a ConfidentialTransaction from the buffer.
+   * @return confidential transaction
+   */
+  ConfidentialTransaction GetTransaction() const;
+
+ private:
+  const uint8_t* buffer_;                   //!< transaction buffer
+  uint32_t size_;                           //!< buffer size
+  int32_t version_;                         //!< version
+  uint32_t lock_time_;                      //!< lock time
+  uint32_t witness_offset_;                 //!< witness area offset
+  std::vector<ConfidentialTxInView> vin_;   //!< TxIn view list
+  std::vector<ConfidentialTxOutView> vout_;  //!< TxOut view list
+};
+
 }  // namespace core
 }  // namespace cfd
 
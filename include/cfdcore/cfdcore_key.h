@@ -55,6 +55,12 @@ class CFD_CORE_EXPORT Pubkey {
    */
   explicit Pubkey(ByteData byte_data);
 
+  /**
+   * @brief constructor
+   * @param[in] byte_data   Public key byte data view
+   */
+  explicit Pubkey(const ByteDataView& byte_data);
+
   /**
    * @brief constructor
    * @param[in] hex_string Public Key HEX string
@@ -178,6 +184,13 @@ class CFD_CORE_EXPORT Pubkey {
    * @retval false  invalid format
    */
   static bool IsValid(const ByteData &byte_data);
+  /**
+   * @brief Verify that the public key is in the correct format.
+   * @param[in] byte_data pubkey bytedata view
+   * @retval true   valid format
+   * @retval false  invalid format
+   */
+  static bool IsValid(const ByteDataView &byte_data);
 
   /**
    * @brief Compare the HEX values ​​of the two specified public keys.
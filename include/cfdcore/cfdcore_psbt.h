@@ -197,6 +197,13 @@ class CFD_CORE_EXPORT Psbt {
    * @param[in] psbt   Psbt object.
    */
   Psbt(const Psbt& psbt);
+  /**
+   * @brief move constructor
+   * @details The moved-from object holds no libwally psbt. Its accessors
+   *   throw CfdException (kCfdIllegalStateError) until it is assigned.
+   * @param[in,out] psbt   Psbt object.
+   */
+  Psbt(Psbt&& psbt) noexcept;
   /**
    * @brief destructor
    */
@@ -208,6 +215,12 @@ class CFD_CORE_EXPORT Psbt {
    * @return Psbt object.
    */
   Psbt& operator=(const Psbt& psbt) &;
+  /**
+   * @brief move assignment.
+   * @param[in,out] psbt   Psbt object.
+   * @return Psbt object.
+   */
+  Psbt& operator=(Psbt&& psbt) & noexcept;
 
   /**
    * @brief Get base64 string.
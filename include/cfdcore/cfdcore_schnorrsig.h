@@ -214,6 +214,13 @@ class CFD_CORE_EXPORT SchnorrSignature {
    */
   explicit SchnorrSignature(const ByteData &data);
 
+  /**
+   * @brief Construct a new Schnorr Signature object from ByteDataView
+   *
+   * @param data the data representing the signature
+   */
+  explicit SchnorrSignature(const ByteDataView &data);
+
   /**
    * @brief Construct a new Schnorr Signature object from a string
    *
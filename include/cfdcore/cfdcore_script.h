@@ -9,6 +9,7 @@
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_SCRIPT_H_
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -875,6 +876,11 @@ class CFD_CORE_EXPORT Script {
    * @param[in] bytedata  byte data.
    */
   explicit Script(const ByteData &bytedata);
+  /**
+   * @brief constructor.
+   * @param[in] bytedata  byte data view.
+   */
+  explicit Script(const ByteDataView &bytedata);
   /**
    * @brief destructor.
    */
@@ -892,6 +898,17 @@ class CFD_CORE_EXPORT Script {
    * @return object
    */
   Script &operator=(const Script &object) &;
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  Script(Script &&object) noexcept = default;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  Script &operator=(Script &&object) & noexcept = default;
   /**
    * @brief get script.
    * @return script
@@ -909,9 +926,15 @@ class CFD_CORE_EXPORT Script {
   ScriptHash GetWitnessScriptHash() const;
   /**
    * @brief get script byte data.
+   * @return script byte data reference.
+   */
+  const ByteData &GetData() const &;
+  /**
+   * @brief get script byte data.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return script byte data.
    */
-  const ByteData GetData() const;
+  ByteData GetData() const &&;
   /**
    * @brief get script hex string.
    * @return script hex string.
@@ -930,6 +953,27 @@ class CFD_CORE_EXPORT Script {
    * @retval false  differ
    */
   bool Equals(const Script &script) const;
+  /**
+   * @brief Equals operator.
+   * @param[in] object  target object.
+   * @retval true   equals
+   * @retval false  not equals
+   */
+  bool operator==(const Script &object) const;
+  /**
+   * @brief Not equals operator.
+   * @param[in] object  target object.
+   * @retval true   not equals
+   * @retval false  equals
+   */
+  bool operator!=(const Script &object) const;
+  /**
+   * @brief Compare operator. (lexicographical byte order)
+   * @param[in] object  target object.
+   * @retval true   less than object
+   * @retval false  other
+   */
+  bool operator<(const Script &object) const;
   /**
    * @brief get element list.
    * @return element list
@@ -1365,4 +1409,21 @@ class CFD_CORE_EXPORT ScriptUtil {
 }  // namespace core
 }  // namespace cfd
 
+namespace std {
+
+/**
+ * @brief hash function of Script.
+ */
+template <>
+struct CFD_CORE_EXPORT hash<cfd::core::Script> {
+  /**
+   * @brief calculate hash value.
+   * @param[in] script    script
+   * @return hash value
+   */
+  size_t operator()(const cfd::core::Script &script) const;
+};
+
+}  // namespace std
+
 #endif  // CFD_CORE_INCLUDE_CFDCORE_CFDCORE_SCRIPT_H_
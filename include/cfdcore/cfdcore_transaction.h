@@ -9,7 +9,9 @@
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_TRANSACTION_H_
 
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cfdcore/cfdcore_address.h"
@@ -78,6 +80,28 @@ class CFD_CORE_EXPORT TxOut : public AbstractTxOut {
   virtual ~TxOut() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  TxOut(const TxOut& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  TxOut(TxOut&& object) noexcept = default;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  TxOut& operator=(const TxOut& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  TxOut& operator=(TxOut&& object) & noexcept = default;
 };
 
 /**
@@ -102,6 +126,28 @@ class CFD_CORE_EXPORT TxOutReference : public AbstractTxOutReference {
   virtual ~TxOutReference() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  TxOutReference(const TxOutReference& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  TxOutReference(TxOutReference&& object) noexcept = default;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  TxOutReference& operator=(const TxOutReference& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  TxOutReference& operator=(TxOutReference&& object) & noexcept = default;
 };
 
 /**
@@ -164,6 +210,28 @@ class CFD_CORE_EXPORT TxIn : public AbstractTxIn {
   virtual ~TxIn() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  TxIn(const TxIn& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  TxIn(TxIn&& object) noexcept = default;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  TxIn& operator=(const TxIn& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  TxIn& operator=(TxIn&& object) & noexcept = default;
 };
 
 /**
@@ -189,6 +257,114 @@ class CFD_CORE_EXPORT TxInReference : public AbstractTxInReference {
   virtual ~TxInReference() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  TxInReference(const TxInReference& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  TxInReference(TxInReference&& object) noexcept = default;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  TxInReference& operator=(const TxInReference& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  TxInReference& operator=(TxInReference&& object) & noexcept = default;
+};
+
+class Transaction;
+
+/**
+ * @brief BIP341 signature hash context.
+ * @details Holds the hashes shared by every input (sha_prevouts,
+ *   sha_amounts, sha_scriptpubkeys, sha_sequences and sha_outputs).
+ *   Build it once per transaction state and pass it to
+ *   Transaction::GetSchnorrSignatureHash for each input.
+ *   It records the state of the transaction it was built from, and is
+ *   rejected after a TxIn or TxOut of that transaction changes (adding
+ *   signatures or witness stacks does not change the state).
+ */
+class CFD_CORE_EXPORT TaprootSigHashContext {
+ public:
+  /**
+   * @brief default constructor.
+   */
+  TaprootSigHashContext();
+  /**
+   * @brief constructor.
+   * @param[in] transaction   transaction
+   * @param[in] utxo_list     utxo list (for amount & scriptPubkey)
+   */
+  TaprootSigHashContext(
+      const Transaction& transaction, const std::vector<TxOut>& utxo_list);
+
+  /**
+   * @brief Get the utxo list.
+   * @return utxo list
+   */
+  const std::vector<TxOut>& GetUtxoList() const;
+  /**
+   * @brief Get the TxIn count of the base transaction.
+   * @return TxIn count
+   */
+  uint32_t GetTxInCount() const;
+  /**
+   * @brief Get the TxOut count of the base transaction.
+   * @return TxOut count
+   */
+  uint32_t GetTxOutCount() const;
+  /**
+   * @brief Get sha_prevouts.
+   * @return sha_prevouts
+   */
+  const ByteData256& GetShaPrevouts() const;
+  /**
+   * @brief Get sha_amounts.
+   * @return sha_amounts
+   */
+  const ByteData256& GetShaAmounts() const;
+  /**
+   * @brief Get sha_scriptpubkeys.
+   * @return sha_scriptpubkeys
+   */
+  const ByteData256& GetShaScriptPubkeys() const;
+  /**
+   * @brief Get sha_sequences.
+   * @return sha_sequences
+   */
+  const ByteData256& GetShaSequences() const;
+  /**
+   * @brief Get sha_outputs.
+   * @return sha_outputs
+   */
+  const ByteData256& GetShaOutputs() const;
+  /**
+   * @brief Check that the context was built from this transaction state.
+   * @param[in] transaction   transaction
+   * @retval true   built from the current state.
+   * @retval false  built from another transaction or an older state.
+   */
+  bool IsMatch(const Transaction& transaction) const;
+
+ private:
+  std::vector<TxOut> utxo_list_;   //!< utxo list
+  uint32_t txin_count_;            //!< txin count
+  uint32_t txout_count_;           //!< txout count
+  uint64_t generation_;            //!< transaction state generation
+  ByteData256 sha_prevouts_;       //!< sha_prevouts
+  ByteData256 sha_amounts_;        //!< sha_amounts
+  ByteData256 sha_scriptpubkeys_;  //!< sha_scriptpubkeys
+  ByteData256 sha_sequences_;      //!< sha_sequences
+  ByteData256 sha_outputs_;        //!< sha_outputs
 };
 
 /**
@@ -206,11 +382,28 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @param[in] lock_time     lock time
    */
   explicit Transaction(int32_t version, uint32_t lock_time);
+  /**
+   * @brief constructor
+   * @details Takes the whole TxIn / TxOut lists at once.
+   * @param[in] version       version
+   * @param[in] lock_time     lock time
+   * @param[in] txin_list     TxIn list
+   * @param[in] txout_list    TxOut list
+   */
+  explicit Transaction(
+      int32_t version, uint32_t lock_time, const std::vector<TxIn>& txin_list,
+      const std::vector<TxOut>& txout_list);
   /**
    * @brief constructor
    * @param[in] byte_data   tx byte data
    */
   explicit Transaction(const ByteData& byte_data);
+  /**
+   * @brief constructor
+   * @details The buffer is parsed without an intermediate copy.
+   * @param[in] byte_data   tx byte data view
+   */
+  explicit Transaction(const ByteDataView& byte_data);
   /**
    * @brief constructor
    * @param[in] hex_string    HEX string
@@ -221,6 +414,14 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @param[in] transaction   transaction object.
    */
   Transaction(const Transaction& transaction);
+  /**
+   * @brief move constructor.
+   * @details The moved-from object holds no libwally tx. It reads as an
+   *   empty transaction with version 0 and lock time 0, and its first
+   *   update allocates a new libwally tx.
+   * @param[in,out] transaction   transaction object.
+   */
+  Transaction(Transaction&& transaction) noexcept;
   /**
    * @brief destructor.
    */
@@ -233,6 +434,12 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @return transaction object.
    */
   Transaction& operator=(const Transaction& transaction) &;
+  /**
+   * @brief move assignment.
+   * @param[in,out] transaction   transaction object.
+   * @return transaction object.
+   */
+  Transaction& operator=(Transaction&& transaction) & noexcept;
 
   /**
    * @brief Get the total byte size of Transaction.
@@ -249,6 +456,17 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @return weight
    */
   virtual uint32_t GetWeight() const;
+  /**
+   * @brief Get the total TxOut amount of Transaction.
+   * @return total TxOut amount
+   */
+  Amount GetValueOut() const;
+  /**
+   * @brief Determine if it is coinbase.
+   * @retval true   coinbase transaction
+   * @retval false  normaltransaction
+   */
+  bool IsCoinBase() const;
 
   /**
    * @brief Get TxIn.
@@ -284,6 +502,13 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
   uint32_t AddTxIn(
       const Txid& txid, uint32_t index, uint32_t sequence,
       const Script& unlocking_script = Script::Empty);
+  /**
+   * @brief Add the TxIn list.
+   * @details Appends the whole list with a single state change.
+   * @param[in] txin_list   TxIn list
+   * @return Index position of the first added TxIn
+   */
+  uint32_t AddTxInList(const std::vector<TxIn>& txin_list);
   /**
    * @brief Delete the TxIn information.
    * @param[in] index     index
@@ -408,6 +633,20 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @return Index position of added TxOut
    */
   uint32_t AddTxOut(const Amount& value, const Script& locking_script);
+  /**
+   * @brief Add the TxOut list.
+   * @details Appends the whole list with a single state change.
+   * @param[in] txout_list  TxOut list
+   * @return Index position of the first added TxOut
+   */
+  uint32_t AddTxOutList(const std::vector<TxOut>& txout_list);
+  /**
+   * @brief Reserve the capacity of the TxIn / TxOut lists.
+   * @details Call this before adding many TxIn / TxOut one by one.
+   * @param[in] txin_count    total TxIn count
+   * @param[in] txout_count   total TxOut count
+   */
+  void Reserve(uint32_t txin_count, uint32_t txout_count);
   /**
    * @brief set TxOut's value.
    * @param[in] index   target txout index
@@ -434,6 +673,8 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
       WitnessVersion version = WitnessVersion::kVersionNone) const;
   /**
    * @brief Get signature hash by schnorr.
+   * @details The shared hashes are cached for the utxo list until a TxIn
+   *   or TxOut changes, so signing every input is O(n).
    * @param[in] txin_index    TxIn's index
    * @param[in] sighash_type  SigHashType(@see cfdcore_util.h)
    * @param[in] utxo_list     utxo list (for amount & scriptPubkey)
@@ -446,6 +687,22 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
       const std::vector<TxOut>& utxo_list,
       const TapScriptData* script_data = nullptr,
       const ByteData& annex = ByteData()) const;
+  /**
+   * @brief Get signature hash by schnorr.
+   * @details Use this when signing many inputs of the same transaction.
+   *   A context built from another transaction state is rejected.
+   * @param[in] txin_index    TxIn's index
+   * @param[in] sighash_type  SigHashType(@see cfdcore_util.h)
+   * @param[in] context       sighash context created from this transaction
+   * @param[in] script_data   tap script data
+   * @param[in] annex         annex data
+   * @return signature hash
+   */
+  ByteData256 GetSchnorrSignatureHash(
+      uint32_t txin_index, SigHashType sighash_type,
+      const TaprootSigHashContext& context,
+      const TapScriptData* script_data = nullptr,
+      const ByteData& annex = ByteData()) const;
   /**
    * @brief Whether it holds witness information.
    * @retval true   witness exist.
@@ -469,8 +726,111 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @param[in] hex_string    HEX string of Transaction byte data
    */
   void SetFromHex(const std::string& hex_string);
+  /**
+   * @brief Set Transaction information from byte data.
+   * @param[in] buffer        Transaction byte data
+   * @param[in] buffer_size   byte data size
+   */
+  void SetFromBytes(const uint8_t* buffer, size_t buffer_size);
+  /**
+   * @brief This function is called by the state change.
+   * @details Clears the signature hash cache, the lookup index and
+   *   the txid / size cache, and marks the libwally structure as
+   *   outdated.
+   * @param[in] type    change type
+   */
+  virtual void CallbackStateChange(uint32_t type);
+  /**
+   * @brief Get the libwally tx structure address for reading.
+   * @details vin_ / vout_ are the canonical data. The TxIn / TxOut of
+   *   the structure are rebuilt from them here under cache_mutex_ only
+   *   when they changed since the last call; version and locktime are
+   *   always current. Only the legacy signature hash reads it.
+   * @return libwally tx structure address
+   */
+  virtual void* GetWallyTxAddress() const;
+  /**
+   * @brief Whether every state change calls CallbackStateChange.
+   * @retval true   always (every mutator reports its change)
+   */
+  virtual bool IsStateChangeReported() const;
 
  private:
+  friend class TaprootSigHashContext;
+
+  /**
+   * @brief BIP143 / BIP341 shared hash cache.
+   * @details Each hash is computed on first use and kept until the
+   *   transaction state changes, so signing every input is O(n).
+   *   It is filled and read under cache_mutex_, so the inputs can be
+   *   signed from several threads.
+   */
+  struct SigHashCache {
+    bool has_prevouts = false;   //!< hash_prevouts is valid
+    bool has_sequence = false;   //!< hash_sequence is valid
+    bool has_outputs = false;    //!< hash_outputs is valid
+    ByteData256 hash_prevouts;   //!< hashPrevouts
+    ByteData256 hash_sequence;   //!< hashSequence
+    ByteData256 hash_outputs;    //!< hashOutputs
+    //! BIP341 shared hashes of the last utxo list (null: not built)
+    std::shared_ptr<const TaprootSigHashContext> taproot;
+  };
+  mutable SigHashCache sighash_cache_;  //!< sighash cache (lazy)
+  //! state generation; renewed when a TxIn or TxOut changes
+  uint64_t sighash_generation_ = CreateSigHashGeneration();
+  /**
+   * @brief TxIn / TxOut lookup index.
+   * @details Built on the first lookup of a transaction with many
+   *   inputs or outputs, and dropped when an input or output is added
+   *   or removed. Like the sighash cache it is guarded by cache_mutex_.
+   */
+  struct TxIndexCache {
+    bool has_txin_index = false;   //!< txin_index is valid
+    bool has_txout_index = false;  //!< txout_index is valid
+    //! outpoint -> first TxIn index
+    std::unordered_map<OutPoint, uint32_t> txin_index;
+    //! locking script -> TxOut index list
+    std::unordered_map<Script, std::vector<uint32_t>> txout_index;
+  };
+  mutable TxIndexCache index_cache_;  //!< lookup index (lazy)
+  //! the TxIn / TxOut of the libwally structure are outdated
+  mutable bool is_wally_tx_stale_ = false;
+
+  /**
+   * @brief Create a new transaction state generation.
+   * @details The value is unique in the process, so a sighash context
+   *   never matches another transaction state.
+   * @return generation
+   */
+  static uint64_t CreateSigHashGeneration();
+  /**
+   * @brief Get the witness v0 (BIP143) signature hash.
+   * @param[in] txin_index    TxIn index
+   * @param[in] script_data   script code
+   * @param[in] sighash_type  SigHashType
+   * @param[in] value         TxIn Amount
+   * @return signature hash
+   */
+  ByteData256 GetWitnessV0SignatureHash(
+      uint32_t txin_index, const ByteData& script_data,
+      SigHashType sighash_type, const Amount& value) const;
+  /**
+   * @brief Get the serialized size from vin_ / vout_.
+   * @param[in] has_witness   Flag to include witness
+   * @return serialized size
+   */
+  uint32_t GetSerializeSize(bool has_witness) const;
+  /**
+   * @brief Get the TxOut index list of the locking script.
+   * @param[in] locking_script  locking script
+   * @return TxOut index list (empty: not found)
+   */
+  std::vector<uint32_t> FindTxOutIndexList(const Script& locking_script) const;
+  /**
+   * @brief Append vin_ / vout_ to the libwally tx structure.
+   * @param[in,out] wally_tx_pointer  libwally tx structure address
+   */
+  void AddWallyTxInOut(void* wally_tx_pointer) const;
   /**
    * @brief check TxIn array range.
    * @param[in] index     TxIn Index
@@ -531,6 +891,255 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
       std::vector<TxOut>* txout_list = nullptr);
 };
 
+class TransactionView;
+
+/**
+ * @brief TxIn view class.
+ * @details Refers to the TxIn area of a TransactionView buffer.
+ */
+class CFD_CORE_EXPORT TxInView {
+ public:
+  /**
+   * @brief constructor.
+   */
+  TxInView();
+
+  /**
+   * @brief Get the txid bytes (internal byte order).
+   * @return txid view
+   */
+  ByteDataView GetTxidView() const;
+  /**
+   * @brief Get the txid.
+   * @return txid
+   */
+  Txid GetTxid() const;
+  /**
+   * @brief Get the vout.
+   * @return vout
+   */
+  uint32_t GetVout() const;
+  /**
+   * @brief Get the outpoint.
+   * @return outpoint
+   */
+  OutPoint GetOutPoint() const;
+  /**
+   * @brief Get the unlocking script bytes.
+   * @return unlocking script view
+   */
+  ByteDataView GetUnlockingScriptView() const;
+  /**
+   * @brief Get the sequence.
+   * @return sequence
+   */
+  uint32_t GetSequence() const;
+  /**
+   * @brief Get the witness stack count.
+   * @return witness stack count
+   */
+  uint32_t GetScriptWitnessStackNum() const;
+  /**
+   * @brief Get the witness stack item.
+   * @param[in] index   stack index
+   * @return witness stack item view
+   */
+  ByteDataView GetScriptWitnessStack(uint32_t index) const;
+  /**
+   * @brief Get the witness data.
+   * @return script witness
+   */
+  ScriptWitness GetScriptWitness() const;
+  /**
+   * @brief Check coinbase input.
+   * @retval true   coinbase
+   * @retval false  other
+   */
+  bool IsCoinBase() const;
+
+ private:
+  friend class TransactionView;
+
+  const uint8_t* outpoint_;         //!< outpoint (txid + vout)
+  ByteDataView unlocking_script_;   //!< unlocking script
+  uint32_t sequence_;               //!< sequence
+  ByteDataView witness_;            //!< witness area (count + items)
+  uint32_t witness_num_;            //!< witness stack count
+};
+
+/**
+ * @brief TxOut view class.
+ * @details Refers to the TxOut area of a TransactionView buffer.
+ */
+class CFD_CORE_EXPORT TxOutView {
+ public:
+  /**
+   * @brief constructor.
+   */
+  TxOutView();
+
+  /**
+   * @brief Get the value.
+   * @return value
+   */
+  Amount GetValue() const;
+  /**
+   * @brief Get the locking script bytes.
+   * @return locking script view
+   */
+  ByteDataView GetLockingScriptView() const;
+  /**
+   * @brief Get the locking script.
+   * @return locking script
+   */
+  Script GetLockingScript() const;
+
+ private:
+  friend class TransactionView;
+
+  int64_t value_;                 //!< value (satoshi)
+  ByteDataView locking_script_;   //!< locking script
+};
+
+/**
+ * @brief Transaction view class.
+ * @details Validates a serialized transaction once and gives read-only
+ *   access to its fields without copying them. The buffer is not
+ *   copied, so it must outlive this object (and its TxIn / TxOut views).
+ *   Use GetTransaction() to get a mutable Transaction.
+ */
+class CFD_CORE_EXPORT TransactionView {
+ public:
+  /**
+   * @brief default constructor
+   */
+  TransactionView();
+  /**
+   * @brief constructor
+   * @param[in] buffer    transaction buffer (not copied)
+   * @param[in] size      buffer size
+   */
+  TransactionView(const uint8_t* buffer, size_t size);
+  /**
+   * @brief constructor
+   * @param[in] buffer    transaction buffer (not copied)
+   */
+  explicit TransactionView(const ByteDataView& buffer);
+
+  /**
+   * @brief check valid data.
+   * @retval true   valid.
+   * @retval false  invalid. (default constructed)
+   */
+  bool IsValid() const;
+  /**
+   * @brief Get the version.
+   * @return version
+   */
+  int32_t GetVersion() const;
+  /**
+   * @brief Get the lock time.
+   * @return lock time
+   */
+  uint32_t GetLockTime() const;
+  /**
+   * @brief Get the TxIn count.
+   * @return TxIn count
+   */
+  uint32_t GetTxInCount() const;
+  /**
+   * @brief Get the TxIn view.
+   * @param[in] index   TxIn index
+   * @return TxIn view
+   */
+  const TxInView& GetTxIn(uint32_t index) const;
+  /**
+   * @brief Get the TxIn view list.
+   * @return TxIn view list
+   */
+  const std::vector<TxInView>& GetTxInList() const;
+  /**
+   * @brief Get the TxOut count.
+   * @return TxOut count
+   */
+  uint32_t GetTxOutCount() const;
+  /**
+   * @brief Get the TxOut view.
+   * @param[in] index   TxOut index
+   * @return TxOut view
+   */
+  const TxOutView& GetTxOut(uint32_t index) const;
+  /**
+   * @brief Get the TxOut view list.
+   * @return TxOut view list
+   */
+  const std::vector<TxOutView>& GetTxOutList() const;
+  /**
+   * @brief Whether it holds witness information.
+   * @retval true   witness exist.
+   * @retval false  witness not found.
+   */
+  bool HasWitness() const;
+  /**
+   * @brief Get the transaction bytes.
+   * @return transaction view
+   */
+  ByteDataView GetData() const;
+  /**
+   * @brief Get the total byte size.
+   * @return total byte size
+   */
+  uint32_t GetTotalSize() const;
+  /**
+   * @brief Get the vsize.
+   * @return vsize
+   */
+  uint32_t GetVsize() const;
+  /**
+   * @brief Get the weight.
+   * @return weight
+   */
+  uint32_t GetWeight() const;
+  /**
+   * @brief Get the txid.
+   * @details The witness area is skipped without copying the body.
+   * @return txid
+   */
+  Txid GetTxid() const;
+  /**
+   * @brief Get the witness hash (wtxid).
+   * @return witness hash
+   */
+  ByteData256 GetWitnessHash() const;
+  /**
+   * @brief Create a Transaction from the buffer.
+   * @return transaction
+   */
+  Transaction GetTransaction() const;
+
+ private:
+  const uint8_t* buffer_;           //!< transaction buffer (not owned)
+  uint32_t size_;                   //!< buffer size
+  int32_t version_;                 //!< version
+  uint32_t lock_time_;              //!< lock time
+  uint32_t witness_offset_;         //!< witness area offset (0: none)
+  std::vector<TxInView> vin_;       //!< TxIn view list
+  std::vector<TxOutView> vout_;     //!< TxOut view list
+
+  /**
+   * @brief Parse the transaction.
+   * @param[in] buffer        transaction buffer
+   * @param[in] size          buffer size
+   * @param[in] has_witness   parse as the witness format
+   */
+  void Parse(const uint8_t* buffer, size_t size, bool has_witness);
+  /**
+   * @brief Get the byte size excluding witness information.
+   * @return byte size excluding witness
+   */
+  uint32_t GetWitnessExcludedSize() const;
+};
+
 }  // namespace core
 }  // namespace cfd
 
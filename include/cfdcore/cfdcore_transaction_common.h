@@ -9,6 +9,8 @@
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_TRANSACTION_COMMON_H_
 
 #include <cstddef>
+#include <functional>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
@@ -51,11 +53,39 @@ class CFD_CORE_EXPORT ScriptWitness {
   virtual ~ScriptWitness() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  ScriptWitness(const ScriptWitness& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  ScriptWitness(ScriptWitness&& object) noexcept = default;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  ScriptWitness& operator=(const ScriptWitness& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  ScriptWitness& operator=(ScriptWitness&& object) & noexcept = default;
+  /**
+   * @brief Get the witness stack.
+   * @return witness stack reference
+   */
+  const std::vector<ByteData>& GetWitness() const&;
   /**
    * @brief Get the witness stack.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return witness stack
    */
-  const std::vector<ByteData> GetWitness() const;
+  std::vector<ByteData> GetWitness() const&&;
   /**
    * @brief Get the number of witness stacks.
    * @return number of witness stacks.
@@ -114,9 +144,15 @@ class CFD_CORE_EXPORT OutPoint {
 
   /**
    * @brief get txid.
+   * @return Txid reference
+   */
+  const Txid& GetTxid() const&;
+  /**
+   * @brief get txid.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return Txid
    */
-  const Txid GetTxid() const;
+  Txid GetTxid() const&&;
   /**
    * @brief get vout.
    * @return vout
@@ -217,11 +253,39 @@ class CFD_CORE_EXPORT AbstractTxIn {
   virtual ~AbstractTxIn() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  AbstractTxIn(const AbstractTxIn& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  AbstractTxIn(AbstractTxIn&& object) noexcept;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxIn& operator=(const AbstractTxIn& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxIn& operator=(AbstractTxIn&& object) & noexcept;
   /**
    * @brief Get a txid.
+   * @return Txid reference
+   */
+  const Txid& GetTxid() const&;
+  /**
+   * @brief Get a txid.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return Txid
    */
-  Txid GetTxid() const;
+  Txid GetTxid() const&&;
   /**
    * @brief Get a vout.
    * @return vout
@@ -234,9 +298,15 @@ class CFD_CORE_EXPORT AbstractTxIn {
   OutPoint GetOutPoint() const;
   /**
    * @brief Get an unlocking script.
+   * @return unlocking script reference
+   */
+  const Script& GetUnlockingScript() const&;
+  /**
+   * @brief Get an unlocking script.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return unlocking script
    */
-  Script GetUnlockingScript() const;
+  Script GetUnlockingScript() const&&;
   /**
    * @brief Set an unlocking script.
    * @param[in] unlocking_script    unlocking script
@@ -254,9 +324,15 @@ class CFD_CORE_EXPORT AbstractTxIn {
   void SetSequence(uint32_t sequence);
   /**
    * @brief Get a script witness.
+   * @return ScriptWitness reference
+   */
+  const ScriptWitness& GetScriptWitness() const&;
+  /**
+   * @brief Get a script witness.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return ScriptWitness
    */
-  ScriptWitness GetScriptWitness() const;
+  ScriptWitness GetScriptWitness() const&&;
   /**
    * @brief Get the current stack number of script witness.
    * @return number of script witness.
@@ -312,11 +388,39 @@ class CFD_CORE_EXPORT AbstractTxInReference {
   virtual ~AbstractTxInReference() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  AbstractTxInReference(const AbstractTxInReference& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  AbstractTxInReference(AbstractTxInReference&& object) noexcept;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxInReference& operator=(const AbstractTxInReference& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxInReference& operator=(AbstractTxInReference&& object) & noexcept;
   /**
    * @brief Get a txid.
+   * @return Txid reference.
+   */
+  const Txid& GetTxid() const& { return txid_; }
+  /**
+   * @brief Get a txid.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return Txid object.
    */
-  Txid GetTxid() const { return txid_; }
+  Txid GetTxid() const&& { return txid_; }
   /**
    * @brief Get a vout.
    * @return vout
@@ -329,9 +433,15 @@ class CFD_CORE_EXPORT AbstractTxInReference {
   OutPoint GetOutPoint() const { return OutPoint(txid_, vout_); }
   /**
    * @brief Get an unlocking script.
+   * @return unlocking script reference
+   */
+  const Script& GetUnlockingScript() const& { return unlocking_script_; }
+  /**
+   * @brief Get an unlocking script.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return unlocking script
    */
-  Script GetUnlockingScript() const { return unlocking_script_; }
+  Script GetUnlockingScript() const&& { return unlocking_script_; }
   /**
    * @brief Get a sequence.
    * @return sequence
@@ -339,9 +449,15 @@ class CFD_CORE_EXPORT AbstractTxInReference {
   uint32_t GetSequence() const { return sequence_; }
   /**
    * @brief Get a script witness.
+   * @return ScriptWitness reference
+   */
+  const ScriptWitness& GetScriptWitness() const& { return script_witness_; }
+  /**
+   * @brief Get a script witness.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return ScriptWitness
    */
-  ScriptWitness GetScriptWitness() const { return script_witness_; }
+  ScriptWitness GetScriptWitness() const&& { return script_witness_; }
   /**
    * @brief Get a stack number of script witness.
    * @return stack number of script witness.
@@ -384,6 +500,28 @@ class CFD_CORE_EXPORT AbstractTxOut {
   virtual ~AbstractTxOut() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  AbstractTxOut(const AbstractTxOut& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  AbstractTxOut(AbstractTxOut&& object) noexcept = default;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxOut& operator=(const AbstractTxOut& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxOut& operator=(AbstractTxOut&& object) & noexcept = default;
   /**
    * @brief Get the amount.
    * @return amount
@@ -391,9 +529,15 @@ class CFD_CORE_EXPORT AbstractTxOut {
   const Amount GetValue() const;
   /**
    * @brief Get the locking script.
+   * @return locking script reference
+   */
+  const Script& GetLockingScript() const&;
+  /**
+   * @brief Get the locking script.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return locking script
    */
-  const Script GetLockingScript() const;
+  Script GetLockingScript() const&&;
   /**
    * @brief get value amount.
    * @param[in] value    amount.
@@ -421,6 +565,29 @@ class CFD_CORE_EXPORT AbstractTxOutReference {
   virtual ~AbstractTxOutReference() {
     // do nothing
   }
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  AbstractTxOutReference(const AbstractTxOutReference& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  AbstractTxOutReference(AbstractTxOutReference&& object) noexcept = default;
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxOutReference& operator=(const AbstractTxOutReference& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  AbstractTxOutReference& operator=(
+      AbstractTxOutReference&& object) & noexcept = default;
 
   /**
    * @brief Get an amount.
@@ -430,9 +597,15 @@ class CFD_CORE_EXPORT AbstractTxOutReference {
 
   /**
    * @brief Get a locking script.
+   * @return locking script reference
+   */
+  const Script& GetLockingScript() const& { return locking_script_; }
+  /**
+   * @brief Get a locking script.
+   * @details Temporary objects return a copy to avoid a dangling reference.
    * @return locking script
    */
-  const Script GetLockingScript() const { return locking_script_; }
+  Script GetLockingScript() const&& { return locking_script_; }
 
   /**
    * @brief Get a serialized size.
@@ -574,12 +747,42 @@ class CFD_CORE_EXPORT AbstractTransaction {
 
  protected:
   void* wally_tx_pointer_;  ///< libwally tx structure address
+  //! Exclusive control object of the caches filled by const functions
+  mutable std::mutex cache_mutex_;
+
+  /**
+   * @brief txid / wtxid / size cache.
+   * @details Each value is computed on first use and kept until
+   *   CallbackStateChange is called. It is read and written under
+   *   cache_mutex_.
+   */
+  struct MetricsCache {
+    bool has_txid = false;        //!< txid is valid
+    bool has_wtxid = false;       //!< wtxid is valid
+    bool has_total_size = false;  //!< total_size is valid
+    bool has_vsize = false;       //!< vsize is valid
+    bool has_weight = false;      //!< weight is valid
+    ByteData256 txid;             //!< hash without witness
+    ByteData256 wtxid;            //!< hash with witness
+    uint32_t total_size = 0;      //!< total size
+    uint32_t vsize = 0;           //!< vsize
+    uint32_t weight = 0;          //!< weight
+  };
+  mutable MetricsCache metrics_cache_;  //!< metrics cache (lazy)
 
   /**
    * @brief This function is called by the state change.
+   * @details Clears the txid / size cache.
    * @param[in] type    change type
    */
   virtual void CallbackStateChange(uint32_t type);
+  /**
+   * @brief Whether every state change calls CallbackStateChange.
+   * @details The txid / size cache is used only when this is true.
+   * @retval true   state changes are reported
+   * @retval false  state changes are not reported
+   */
+  virtual bool IsStateChangeReported() const;
   /**
    * @brief Add TxIn.
    * @param[in] txid                txid
@@ -710,6 +913,33 @@ class CFD_CORE_EXPORT AbstractTransaction {
    * @param[in] wally_tx_pointer  address
    */
   static void FreeWallyAddress(const void* wally_tx_pointer);
+  /**
+   * @brief Create a deep copy of the libwally tx object.
+   * @param[in] wally_tx_pointer  source address (nullable)
+   * @return copied address (nullptr if source is nullptr)
+   */
+  static void* CloneWallyAddress(const void* wally_tx_pointer);
+  /**
+   * @brief Allocate an empty libwally tx object.
+   * @param[in] version       version
+   * @param[in] lock_time     lock time
+   * @return allocated address
+   */
+  static void* AllocateWallyAddress(int32_t version, uint32_t lock_time);
+  /**
+   * @brief Get the libwally tx structure address for update.
+   * @details A moved-from object holds no libwally tx. An empty one
+   *   (version 0, lock time 0) is allocated here before its first update.
+   * @return libwally tx structure address
+   */
+  void* PrepareWallyTxAddress();
+  /**
+   * @brief Get the libwally tx structure address for reading.
+   * @details A class that keeps its own TxIn / TxOut list brings the
+   *   structure up to date here before returning it.
+   * @return libwally tx structure address
+   */
+  virtual void* GetWallyTxAddress() const;
 };
 
 /**
@@ -747,4 +977,21 @@ class CFD_CORE_EXPORT SignatureUtil {
 }  // namespace core
 }  // namespace cfd
 
+namespace std {
+
+/**
+ * @brief hash function of OutPoint.
+ */
+template <>
+struct CFD_CORE_EXPORT hash<cfd::core::OutPoint> {
+  /**
+   * @brief calculate hash value.
+   * @param[in] outpoint    outpoint
+   * @return hash value
+   */
+  size_t operator()(const cfd::core::OutPoint& outpoint) const;
+};
+
+}  // namespace std
+
 #endif  // CFD_CORE_INCLUDE_CFDCORE_CFDCORE_TRANSACTION_COMMON_H_
@@ -0,0 +1,212 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_transaction_stream.h
+ *
+ * @brief The transaction stream reader related class definition.
+ */
+#ifndef CFD_CORE_INCLUDE_CFDCORE_CFDCORE_TRANSACTION_STREAM_H_
+#define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_TRANSACTION_STREAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_common.h"
+#include "cfdcore/cfdcore_transaction.h"
+
+namespace cfd {
+namespace core {
+
+/**
+ * @brief transaction stream format.
+ */
+enum TransactionStreamFormat {
+  /// concatenated transactions.
+  kTxStreamConcatenated = 0,
+  /// transactions with a variable integer (CompactSize) length prefix.
+  kTxStreamLengthPrefixed = 1,
+  /// variable integer transaction count and transactions. (block tx section)
+  kTxStreamCountPrefixed = 2,
+};
+
+/**
+ * @brief Transaction stream input source.
+ * @details Implement this class to read from sockets and other sources.
+ */
+class CFD_CORE_EXPORT TransactionStreamSource {
+ public:
+  /**
+   * @brief destructor.
+   */
+  virtual ~TransactionStreamSource() {}
+  /**
+   * @brief Read the stream data.
+   * @param[out] buffer   output buffer
+   * @param[in] size      maximum read size
+   * @return read size. (0: end of stream)
+   */
+  virtual size_t Read(uint8_t* buffer, size_t size) = 0;
+};
+
+/**
+ * @brief Transaction stream source from memory.
+ * @details The buffer is not copied, so it must outlive this object.
+ */
+class CFD_CORE_EXPORT MemoryTransactionStreamSource
+    : public TransactionStreamSource {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] buffer    stream buffer (not copied)
+   */
+  explicit MemoryTransactionStreamSource(const ByteDataView& buffer);
+  /**
+   * @brief destructor.
+   */
+  virtual ~MemoryTransactionStreamSource() {}
+  /**
+   * @brief Read the stream data.
+   * @param[out] buffer   output buffer
+   * @param[in] size      maximum read size
+   * @return read size. (0: end of stream)
+   */
+  virtual size_t Read(uint8_t* buffer, size_t size);
+
+ private:
+  ByteDataView buffer_;  //!< stream buffer (not owned)
+  size_t offset_;        //!< read offset
+};
+
+/**
+ * @brief Transaction stream source from std::istream (files, etc).
+ * @details The stream is not owned, so it must outlive this object.
+ */
+class CFD_CORE_EXPORT IStreamTransactionStreamSource
+    : public TransactionStreamSource {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] stream    input stream (opened in binary mode)
+   */
+  explicit IStreamTransactionStreamSource(std::istream* stream);
+  /**
+   * @brief destructor.
+   */
+  virtual ~IStreamTransactionStreamSource() {}
+  /**
+   * @brief Read the stream data.
+   * @param[out] buffer   output buffer
+   * @param[in] size      maximum read size
+   * @return read size. (0: end of stream)
+   */
+  virtual size_t Read(uint8_t* buffer, size_t size);
+
+ private:
+  std::istream* stream_;  //!< input stream (not owned)
+};
+
+/**
+ * @brief Transaction stream reader class.
+ * @details Reads transactions one by one from a TransactionStreamSource.
+ *   Only unread data is kept in the buffer, and the buffer never grows
+ *   beyond the maximum buffer size, so a stream of any length can be
+ *   processed in constant memory.
+ */
+class CFD_CORE_EXPORT TransactionStreamReader {
+ public:
+  /**
+   * @brief default read chunk size.
+   */
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+  /**
+   * @brief default maximum buffer size. (maximum transaction size)
+   */
+  static constexpr size_t kDefaultMaxBufferSize = 8 * 1024 * 1024;
+
+  /**
+   * @brief constructor.
+   * @param[in] source            stream source (not owned)
+   * @param[in] format            stream format
+   * @param[in] chunk_size        read chunk size
+   * @param[in] max_buffer_size   maximum buffer size
+   */
+  explicit TransactionStreamReader(
+      TransactionStreamSource* source,
+      TransactionStreamFormat format = kTxStreamConcatenated,
+      size_t chunk_size = kDefaultChunkSize,
+      size_t max_buffer_size = kDefaultMaxBufferSize);
+
+  /**
+   * @brief Read the next transaction view.
+   * @details The view refers to the internal buffer, so it is valid
+   *   until the next read.
+   * @param[out] view   transaction view
+   * @retval true   read a transaction.
+   * @retval false  end of stream.
+   */
+  bool ReadNext(TransactionView* view);
+  /**
+   * @brief Read the next transaction.
+   * @param[out] transaction    transaction
+   * @retval true   read a transaction.
+   * @retval false  end of stream.
+   */
+  bool ReadNext(Transaction* transaction);
+  /**
+   * @brief Get the number of transactions read.
+   * @return read transaction count
+   */
+  uint64_t GetReadCount() const;
+  /**
+   * @brief Get the stream offset of the next transaction.
+   * @return stream offset
+   */
+  uint64_t GetStreamOffset() const;
+
+ private:
+  TransactionStreamSource* source_;  //!< stream source (not owned)
+  TransactionStreamFormat format_;   //!< stream format
+  size_t chunk_size_;                //!< read chunk size
+  size_t max_buffer_size_;           //!< maximum buffer size
+  std::vector<uint8_t> buffer_;      //!< read buffer
+  size_t begin_;                     //!< unread data start offset
+  size_t end_;                       //!< unread data end offset
+  bool is_eof_;                      //!< end of source
+  uint64_t stream_offset_;           //!< stream offset of begin_
+  uint64_t read_count_;              //!< read transaction count
+  uint64_t tx_count_;                //!< transaction count (count prefix)
+  bool has_tx_count_;                //!< read the count prefix
+
+  /**
+   * @brief Read the next transaction range from the stream.
+   * @param[out] data   transaction data view
+   * @retval true   read a transaction.
+   * @retval false  end of stream.
+   */
+  bool ReadNextData(ByteDataView* data);
+  /**
+   * @brief Read a variable integer from the stream.
+   * @param[out] value  variable integer
+   * @retval true   read a variable integer.
+   * @retval false  end of stream.
+   */
+  bool ReadVariableInt(uint64_t* value);
+  /**
+   * @brief Read more data from the source into the buffer.
+   * @retval true   read data.
+   * @retval false  end of stream.
+   */
+  bool Fill();
+  /**
+   * @brief Consume the buffered data.
+   * @param[in] size    consume size
+   */
+  void Consume(size_t size);
+};
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_INCLUDE_CFDCORE_CFDCORE_TRANSACTION_STREAM_H_
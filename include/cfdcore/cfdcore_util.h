@@ -178,6 +178,219 @@ class CFD_CORE_EXPORT SigHashType {
   bool is_fork_id_;
 };
 
+/**
+ * @brief Standard tag of the tagged hash. (BIP340/341/342)
+ */
+enum TaggedHashTag {
+  kTagTapLeaf = 0,          //!< TapLeaf
+  kTagTapBranch = 1,        //!< TapBranch
+  kTagTapTweak = 2,         //!< TapTweak
+  kTagTapSighash = 3,       //!< TapSighash
+  kTagBip340Challenge = 4,  //!< BIP0340/challenge
+  kTagBip340Aux = 5,        //!< BIP0340/aux
+  kTagBip340Nonce = 6,      //!< BIP0340/nonce
+  kTaggedHashTagCount = 7,  //!< tag count (not a tag)
+};
+
+/**
+ * @brief SHA256 block transform implementation.
+ */
+enum Sha256Implementation {
+  kSha256Portable = 0,  //!< portable C++
+  kSha256X86ShaNi = 1,  //!< x86 SHA extensions
+  kSha256ArmV8 = 2,     //!< ARMv8 crypto extensions
+  kSha256X86Avx2 = 3,   //!< portable + AVX2 multi-buffer batch
+};
+
+/**
+ * @brief Incremental SHA256 hasher.
+ * @details Holds the running state, so large inputs are hashed without
+ *   buffering. Copying the object clones the midstate.
+ */
+class CFD_CORE_EXPORT Sha256Hasher {
+ public:
+  //! block size
+  static constexpr size_t kBlockSize = 64;
+  //! output size
+  static constexpr size_t kOutputSize = 32;
+  //! midstate word count
+  static constexpr size_t kStateSize = 8;
+
+  /**
+   * @brief constructor.
+   */
+  Sha256Hasher();
+  /**
+   * @brief constructor from a midstate.
+   * @param[in] midstate    midstate words. (kStateSize)
+   * @param[in] length      hashed length. (multiple of kBlockSize)
+   */
+  Sha256Hasher(const uint32_t *midstate, uint64_t length);
+  /**
+   * @brief Create a tagged hasher. (sha256(tag) || sha256(tag) is hashed)
+   * @details The midstate of the standard tags is computed only once.
+   * @param[in] tag   standard tag
+   * @return hasher object.
+   */
+  static Sha256Hasher CreateTaggedHasher(TaggedHashTag tag);
+  /**
+   * @brief Create a tagged hasher. (sha256(tag) || sha256(tag) is hashed)
+   * @param[in] tag   tag string
+   * @return hasher object.
+   */
+  static Sha256Hasher CreateTaggedHasher(const std::string &tag);
+  /**
+   * @brief Get the current block transform implementation.
+   * @details The fastest supported one is selected on first use.
+   *   Hardware implementations require the CFDCORE_SHA256_HW build option.
+   * @return implementation
+   */
+  static Sha256Implementation GetImplementation();
+  /**
+   * @brief Check if the implementation is usable on this build and cpu.
+   * @param[in] implementation    implementation
+   * @retval true   supported
+   * @retval false  unsupported
+   */
+  static bool IsSupportedImplementation(Sha256Implementation implementation);
+  /**
+   * @brief Select the block transform implementation. (for test/benchmark)
+   * @param[in] implementation    implementation
+   */
+  static void SetImplementation(Sha256Implementation implementation);
+  /**
+   * @brief Hash many independent messages.
+   * @details With kSha256X86Avx2, messages of the same block count are
+   *   hashed 8 at a time. Otherwise each message is hashed in turn.
+   * @param[in] inputs    message list
+   * @param[in] count     message count
+   * @param[out] outputs  output buffer. (count * kOutputSize)
+   */
+  static void HashBatch(
+      const ByteDataView *inputs, size_t count, uint8_t *outputs);
+  /**
+   * @brief Reset to the initial state.
+   */
+  void Reset();
+  /**
+   * @brief Hash the data.
+   * @param[in] data    data pointer
+   * @param[in] size    data size
+   * @return hasher object.
+   */
+  Sha256Hasher &Write(const uint8_t *data, size_t size);
+  /**
+   * @brief Output the hash. The running state is not changed.
+   * @param[out] output   output buffer. (kOutputSize)
+   */
+  void Finalize(uint8_t *output) const;
+  /**
+   * @brief Output the hash. The running state is not changed.
+   * @return hashed data
+   */
+  ByteData256 Finalize() const;
+  /**
+   * @brief Get the midstate.
+   * @details Only valid when the hashed length is a multiple of kBlockSize.
+   * @param[out] midstate   midstate words. (kStateSize)
+   */
+  void GetMidstate(uint32_t *midstate) const;
+  /**
+   * @brief Get the hashed length.
+   * @return hashed length.
+   */
+  uint64_t GetLength() const { return length_; }
+
+ private:
+  uint32_t state_[kStateSize];  //!< running state
+  uint8_t buffer_[kBlockSize];  //!< pending block
+  uint64_t length_;             //!< hashed length
+};
+
+/**
+ * @brief Incremental SHA512 hasher.
+ */
+class CFD_CORE_EXPORT Sha512Hasher {
+ public:
+  //! block size
+  static constexpr size_t kBlockSize = 128;
+  //! output size
+  static constexpr size_t kOutputSize = 64;
+
+  /**
+   * @brief constructor.
+   */
+  Sha512Hasher();
+  /**
+   * @brief Reset to the initial state.
+   */
+  void Reset();
+  /**
+   * @brief Hash the data.
+   * @param[in] data    data pointer
+   * @param[in] size    data size
+   * @return hasher object.
+   */
+  Sha512Hasher &Write(const uint8_t *data, size_t size);
+  /**
+   * @brief Output the hash. The running state is not changed.
+   * @param[out] output   output buffer. (kOutputSize)
+   */
+  void Finalize(uint8_t *output) const;
+  /**
+   * @brief Output the hash. The running state is not changed.
+   * @return hashed data
+   */
+  ByteData Finalize() const;
+
+ private:
+  uint64_t state_[8];           //!< running state
+  uint8_t buffer_[kBlockSize];  //!< pending block
+  uint64_t length_;             //!< hashed length
+};
+
+/**
+ * @brief Incremental RIPEMD160 hasher.
+ */
+class CFD_CORE_EXPORT Ripemd160Hasher {
+ public:
+  //! block size
+  static constexpr size_t kBlockSize = 64;
+  //! output size
+  static constexpr size_t kOutputSize = 20;
+
+  /**
+   * @brief constructor.
+   */
+  Ripemd160Hasher();
+  /**
+   * @brief Reset to the initial state.
+   */
+  void Reset();
+  /**
+   * @brief Hash the data.
+   * @param[in] data    data pointer
+   * @param[in] size    data size
+   * @return hasher object.
+   */
+  Ripemd160Hasher &Write(const uint8_t *data, size_t size);
+  /**
+   * @brief Output the hash. The running state is not changed.
+   * @param[out] output   output buffer. (kOutputSize)
+   */
+  void Finalize(uint8_t *output) const;
+  /**
+   * @brief Output the hash. The running state is not changed.
+   * @return hashed data
+   */
+  ByteData160 Finalize() const;
+
+ private:
+  uint32_t state_[5];           //!< running state
+  uint8_t buffer_[kBlockSize];  //!< pending block
+  uint64_t length_;             //!< hashed length
+};
+
 /**
  * @brief Util class that defines the Hash function.
  */
@@ -214,6 +427,13 @@ class CFD_CORE_EXPORT HashUtil {
    * @return hashed data
    */
   static ByteData160 Ripemd160(const ByteData256 &data);
+  /**
+   * @brief Hash the byte data view.
+   * @details The buffer is hashed without copying.
+   * @param[in] data    byte array view
+   * @return hashed data
+   */
+  static ByteData160 Ripemd160(const ByteDataView &data);
   /**
    * @brief Hash the pubkey bytes with Ripemd160.
    * @param[in] pubkey Pubkey
@@ -258,6 +478,13 @@ class CFD_CORE_EXPORT HashUtil {
    * @return hashed data
    */
   static ByteData160 Hash160(const ByteData256 &data);
+  /**
+   * @brief Hash the byte data view.
+   * @details The buffer is hashed without copying.
+   * @param[in] data    byte array view
+   * @return hashed data
+   */
+  static ByteData160 Hash160(const ByteDataView &data);
   /**
    * @brief Hash the pubkey.
    * @param[in] pubkey Pubkey
@@ -302,6 +529,13 @@ class CFD_CORE_EXPORT HashUtil {
    * @return hashed data
    */
   static ByteData256 Sha256(const ByteData256 &data);
+  /**
+   * @brief Hash the byte data view.
+   * @details The buffer is hashed without copying.
+   * @param[in] data    byte array view
+   * @return hashed data
+   */
+  static ByteData256 Sha256(const ByteDataView &data);
   /**
    * @brief Hash the pubkey.
    * @param[in] pubkey Pubkey
@@ -346,6 +580,13 @@ class CFD_CORE_EXPORT HashUtil {
    * @return hashed data
    */
   static ByteData256 Sha256D(const ByteData256 &data);
+  /**
+   * @brief Hash the byte data view.
+   * @details The buffer is hashed without copying.
+   * @param[in] data    byte array view
+   * @return hashed data
+   */
+  static ByteData256 Sha256D(const ByteDataView &data);
   /**
    * @brief Hash the pubkey.
    * @param[in] pubkey Pubkey
@@ -359,6 +600,30 @@ class CFD_CORE_EXPORT HashUtil {
    */
   static ByteData256 Sha256D(const Script &script);
 
+  // Batch --------------------------------------------------------------
+  /**
+   * @brief Hash many independent messages with Sha256.
+   * @details Uses the multi-buffer implementation when available.
+   * @param[in] inputs  message list
+   * @return hashed data list (same order as inputs)
+   */
+  static std::vector<ByteData256> Sha256Batch(
+      const std::vector<ByteDataView> &inputs);
+  /**
+   * @brief Hash many independent messages with Sha256D.
+   * @param[in] inputs  message list
+   * @return hashed data list (same order as inputs)
+   */
+  static std::vector<ByteData256> Sha256DBatch(
+      const std::vector<ByteDataView> &inputs);
+  /**
+   * @brief Hash many independent messages with Hash160.
+   * @param[in] inputs  message list
+   * @return hashed data list (same order as inputs)
+   */
+  static std::vector<ByteData160> Hash160Batch(
+      const std::vector<ByteDataView> &inputs);
+
   // Sha512 ---------------------------------------------------------------
   /**
    * @brief Hash the string.
@@ -415,6 +680,19 @@ class CFD_CORE_EXPORT HashUtil {
   //! HashType: Sha512
   static constexpr uint8_t kSha512 = 5;
 
+  /**
+   * @brief Create the sha256 tagged hash builder.
+   * @param[in] tag   standard tag
+   * @return hash util object. (kSha256)
+   */
+  static HashUtil CreateTaggedHash(TaggedHashTag tag);
+  /**
+   * @brief Create the sha256 tagged hash builder.
+   * @param[in] tag   tag string
+   * @return hash util object. (kSha256)
+   */
+  static HashUtil CreateTaggedHash(const std::string &tag);
+
   /**
    * @brief constructor.
    * @param[in] hash_type       hash type.
@@ -471,6 +749,12 @@ class CFD_CORE_EXPORT HashUtil {
    * @return hash util object.
    */
   HashUtil &operator<<(const ByteData256 &data);
+  /**
+   * @brief Hash the byte data array.
+   * @param[in] data    byte array view
+   * @return hash util object.
+   */
+  HashUtil &operator<<(const ByteDataView &data);
   /**
    * @brief Hash the pubkey.
    * @param[in] pubkey Pubkey
@@ -483,8 +767,17 @@ class CFD_CORE_EXPORT HashUtil {
    * @return hash util object.
    */
   HashUtil &operator<<(const Script &script);
+  /**
+   * @brief Hash the data.
+   * @param[in] data    data pointer
+   * @param[in] size    data size
+   * @return hash util object.
+   */
+  HashUtil &Write(const uint8_t *data, size_t size);
   /**
    * @brief Output data.
+   * @details The running state is kept, so more data can be appended
+   *   after the output. Copy the object to branch from a common prefix.
    * @return hashed data
    */
   ByteData Output();
@@ -502,8 +795,10 @@ class CFD_CORE_EXPORT HashUtil {
  private:
   HashUtil();
 
-  uint8_t hash_type_;  //!< hash type
-  ByteData buffer_;    //!< buffer
+  uint8_t hash_type_;          //!< hash type
+  Sha256Hasher sha256_;        //!< sha256 state
+  Sha512Hasher sha512_;        //!< sha512 state
+  Ripemd160Hasher ripemd160_;  //!< ripemd160 state
 };
 
 /**
@@ -672,6 +967,43 @@ class CFD_CORE_EXPORT CryptoUtil {
    * @return Base58 encode string.
    */
   static std::string EncodeBase58Check(const ByteData &data);
+  /**
+   * @brief encode many byte data with Base58Check into one buffer.
+   * @param[in] inputs    byte data list
+   * @param[out] offsets  start offset of each string. The last entry is
+   *   the total size. (inputs.size() + 1 entries)
+   * @return concatenated Base58Check strings.
+   */
+  static std::string EncodeBase58CheckBatch(
+      const std::vector<ByteDataView> &inputs, std::vector<size_t> *offsets);
+  /**
+   * @brief decode many Base58Check strings into one buffer.
+   * @param[in] inputs    Base58Check string list
+   * @param[out] offsets  start offset of each data. The last entry is
+   *   the total size. (inputs.size() + 1 entries)
+   * @return concatenated decoded data.
+   */
+  static std::vector<uint8_t> DecodeBase58CheckBatch(
+      const std::vector<std::string> &inputs, std::vector<size_t> *offsets);
+  /**
+   * @brief Base64 encode many byte data into one buffer.
+   * @param[in] inputs    byte data list
+   * @param[out] offsets  start offset of each string. The last entry is
+   *   the total size. (inputs.size() + 1 entries)
+   * @return concatenated Base64 strings.
+   */
+  static std::string EncodeBase64Batch(
+      const std::vector<ByteDataView> &inputs, std::vector<size_t> *offsets);
+  /**
+   * @brief Base64 decode many strings into one buffer.
+   * @details An invalid string is decoded to empty data, as DecodeBase64.
+   * @param[in] inputs    Base64 string list
+   * @param[out] offsets  start offset of each data. The last entry is
+   *   the total size. (inputs.size() + 1 entries)
+   * @return concatenated decoded data.
+   */
+  static std::vector<uint8_t> DecodeBase64Batch(
+      const std::vector<std::string> &inputs, std::vector<size_t> *offsets);
 
   /**
    * @brief Perform a simple calculation of merkle root.
@@ -742,12 +1074,34 @@ class CFD_CORE_EXPORT StringUtil {
    * @return byte data array.
    */
   static std::vector<uint8_t> StringToByte(const std::string &hex_str);
+  /**
+   * @brief Convert from hex character buffer to the caller buffer.
+   * @details Upper and lower case characters are accepted.
+   * @param[in] hex_str   HEX character buffer
+   * @param[in] size      character count (must be even)
+   * @param[out] output   byte buffer (size / 2 bytes)
+   */
+  static void StringToByte(const char *hex_str, size_t size, uint8_t *output);
   /**
    * @brief Convert from byte data array to HEX character string.
    * @param[in] bytes byte data array
    * @return HEX string
    */
   static std::string ByteToString(const std::vector<uint8_t> &bytes);
+  /**
+   * @brief Convert from byte data view to HEX character string.
+   * @param[in] bytes byte data view
+   * @return HEX string
+   */
+  static std::string ByteToString(const ByteDataView &bytes);
+  /**
+   * @brief Convert from byte buffer to the caller character buffer.
+   * @details The output is lower case and is not null-terminated.
+   * @param[in] bytes     byte buffer
+   * @param[in] size      byte size
+   * @param[out] output   character buffer (size * 2 characters)
+   */
+  static void ByteToString(const uint8_t *bytes, size_t size, char *output);
   /**
    * @brief Convert to lower character.
    * @param[in] str     Character string
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_logger.h"
@@ -234,6 +235,37 @@ Address& Address::operator=(const Address& object) {
   return *this;
 }
 
+Address::Address(Address&& object) noexcept
+    : type_(object.type_),
+      addr_type_(object.addr_type_),
+      witness_ver_(object.witness_ver_),
+      address_(std::move(object.address_)),
+      hash_(std::move(object.hash_)),
+      pubkey_(std::move(object.pubkey_)),
+      schnorr_pubkey_(std::move(object.schnorr_pubkey_)),
+      script_tree_(std::move(object.script_tree_)),
+      redeem_script_(std::move(object.redeem_script_)),
+      format_data_(std::move(object.format_data_)) {
+  memcpy(checksum_, object.checksum_, sizeof(checksum_));
+}
+
+Address& Address::operator=(Address&& object) noexcept {
+  if (this != &object) {
+    type_ = object.type_;
+    addr_type_ = object.addr_type_;
+    witness_ver_ = object.witness_ver_;
+    address_ = std::move(object.address_);
+    hash_ = std::move(object.hash_);
+    pubkey_ = std::move(object.pubkey_);
+    schnorr_pubkey_ = std::move(object.schnorr_pubkey_);
+    script_tree_ = std::move(object.script_tree_);
+    redeem_script_ = std::move(object.redeem_script_);
+    memcpy(checksum_, object.checksum_, sizeof(checksum_));
+    format_data_ = std::move(object.format_data_);
+  }
+  return *this;
+}
+
 Address::Address(const std::string& address_string)
     : type_(kMainnet),
       addr_type_(kP2shAddress),
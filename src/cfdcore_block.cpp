@@ -8,7 +8,15 @@
  */
 #include "cfdcore/cfdcore_block.h"
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <mutex>  // NOLINT
 #include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
@@ -49,118 +57,519 @@ static ByteData BitsToBytes(const std::vector<bool>& bits) {
   return ByteData(ret);
 }
 
+/**
+ * @brief Read a transaction range without parsing it into a transaction.
+ * @details The deserializer advances to the next transaction.
+ * @param[in,out] dec   deserializer positioned at the transaction start.
+ * @return transaction byte range
+ */
+BlockTxRange ReadTransactionRange(Deserializer* dec) {
+  BlockTxRange range;
+  range.offset = dec->GetReadSize();
+  dec->SkipBytes(4);  // version
+  uint64_t txin_count = dec->ReadVariableInt();
+  bool has_witness = false;
+  if (txin_count == 0) {
+    uint8_t flag = dec->ReadUint8();
+    if (flag != 1) {
+      warn(CFD_LOG_SOURCE, "Invalid block transaction flag.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+    has_witness = true;
+    txin_count = dec->ReadVariableInt();
+  }
+  for (uint64_t index = 0; index < txin_count; ++index) {
+    dec->SkipBytes(36);  // outpoint
+    dec->SkipVariableBuffer();
+    dec->SkipBytes(4);  // sequence
+  }
+  uint64_t txout_count = dec->ReadVariableInt();
+  for (uint64_t index = 0; index < txout_count; ++index) {
+    dec->SkipBytes(8);  // amount
+    dec->SkipVariableBuffer();
+  }
+  if (has_witness) {
+    range.witness_offset = dec->GetReadSize();
+    for (uint64_t index = 0; index < txin_count; ++index) {
+      uint64_t stack_count = dec->ReadVariableInt();
+      for (uint64_t stack = 0; stack < stack_count; ++stack) {
+        dec->SkipVariableBuffer();
+      }
+    }
+    range.witness_size = dec->GetReadSize() - range.witness_offset;
+  }
+  dec->SkipBytes(4);  // locktime
+  range.size = dec->GetReadSize() - range.offset;
+  return range;
+}
+
+/**
+ * @brief Calculate txid from the transaction range.
+ * @details The marker, flag and witness area are excluded from the hash.
+ * @param[in] buffer    block data buffer
+ * @param[in] range     transaction byte range
+ * @return txid
+ */
+static Txid CalculateTxid(const uint8_t* buffer, const BlockTxRange& range) {
+  if (range.witness_offset == 0) {
+    return Txid(
+        HashUtil::Sha256D(ByteDataView(buffer + range.offset, range.size)));
+  }
+  static constexpr uint32_t kMarkerFlagSize = 2;
+  uint32_t body_offset = range.offset + 4 + kMarkerFlagSize;
+  uint8_t hash[Sha256Hasher::kOutputSize];
+  Sha256Hasher()
+      .Write(buffer + range.offset, 4)
+      .Write(buffer + body_offset, range.witness_offset - body_offset)
+      .Write(buffer + range.witness_offset + range.witness_size, 4)
+      .Finalize(hash);
+  return Txid(Sha256Hasher().Write(hash, sizeof(hash)).Finalize());
+}
+
+/// block header size
+static constexpr uint32_t kBlockHeaderSize = 80;
+/// minimum item count per worker thread
+static constexpr size_t kParallelMinimumChunkSize = 16;
+
+/**
+ * @brief Run the function over the index range on worker threads.
+ * @details The range is split into contiguous chunks. The calling thread
+ *   processes the first chunk. An exception thrown by any chunk is rethrown
+ *   after all workers have finished.
+ * @param[in] count           index count
+ * @param[in] thread_count    worker thread count (0: hardware concurrency)
+ * @param[in] function        function called with (begin, end).
+ */
+template <typename Function>
+static void ParallelForEach(
+    size_t count, uint32_t thread_count, const Function& function) {
+  if (thread_count == 0) thread_count = std::thread::hardware_concurrency();
+  size_t max_worker_count =
+      (count + kParallelMinimumChunkSize - 1) / kParallelMinimumChunkSize;
+  size_t worker_count = std::min<size_t>(thread_count, max_worker_count);
+  if (worker_count <= 1) {
+    function(0, count);
+    return;
+  }
+
+  size_t chunk_size = (count + worker_count - 1) / worker_count;
+  std::vector<std::exception_ptr> errors(worker_count);
+  auto task = [&function, &errors, count, chunk_size](size_t worker) {
+    size_t begin = std::min(count, worker * chunk_size);
+    size_t end = std::min(count, begin + chunk_size);
+    try {
+      function(begin, end);
+    } catch (...) {
+      errors[worker] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count - 1);
+  for (size_t worker = 1; worker < worker_count; ++worker) {
+    try {
+      workers.emplace_back(task, worker);
+    } catch (const std::system_error&) {
+      task(worker);  // thread creation failed. run on the current thread.
+    }
+  }
+  task(0);
+  for (auto& worker : workers) worker.join();
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Calculate the merkle tree hash list per level.
+ * @details An odd last node is paired with itself.
+ * @param[in] hashes          leaf hash list
+ * @param[in] thread_count    worker thread count (0: hardware concurrency)
+ * @return hash list per level (level 0 is the leaf list)
+ */
+static std::vector<std::vector<ByteData256>> CalculateMerkleLevels(
+    std::vector<ByteData256> hashes, uint32_t thread_count) {
+  std::vector<std::vector<ByteData256>> levels;
+  if (hashes.empty()) return levels;
+  levels.push_back(std::move(hashes));
+  while (levels.back().size() > 1) {
+    const std::vector<ByteData256>& children = levels.back();
+    std::vector<ByteData256> parents((children.size() + 1) / 2);
+    ParallelForEach(
+        parents.size(), thread_count,
+        [&children, &parents](size_t begin, size_t end) {
+          static constexpr size_t kHashSize = 32;
+          std::vector<uint8_t> pairs((end - begin) * kHashSize * 2);
+          std::vector<ByteDataView> inputs;
+          inputs.reserve(end - begin);
+          for (size_t index = begin; index < end; ++index) {
+            size_t left = index * 2;
+            size_t right = (left + 1 < children.size()) ? left + 1 : left;
+            uint8_t* pair = pairs.data() + ((index - begin) * kHashSize * 2);
+            memcpy(pair, children[left].data(), kHashSize);
+            memcpy(pair + kHashSize, children[right].data(), kHashSize);
+            inputs.emplace_back(pair, kHashSize * 2);
+          }
+          std::vector<ByteData256> digests = HashUtil::Sha256DBatch(inputs);
+          std::move(digests.begin(), digests.end(), parents.begin() + begin);
+        });
+    levels.push_back(std::move(parents));
+  }
+  return levels;
+}
+
+/**
+ * @brief Calculate the merkle root hash.
+ * @param[in] hashes          leaf hash list
+ * @param[in] thread_count    worker thread count (0: hardware concurrency)
+ * @return merkle root hash (empty hash if the list is empty)
+ */
+static ByteData256 CalculateMerkleRootHash(
+    const std::vector<ByteData256>& hashes, uint32_t thread_count) {
+  if (hashes.empty()) return ByteData256();
+  return CalculateMerkleLevels(hashes, thread_count).back()[0];
+}
+
 // -----------------------------------------------------------------------------
-// Block
+// BlockView
 // -----------------------------------------------------------------------------
-Block::Block() : data_() {
+BlockView::BlockView() : buffer_(nullptr), buffer_size_(0) {
   // do nothing
 }
 
-Block::Block(const ByteData& data) : data_(data) {
-  Deserializer dec(data);
+BlockView::BlockView(const uint8_t* buffer, size_t size)
+    : buffer_(nullptr), buffer_size_(0) {
+  Parse(buffer, size);
+}
+
+BlockView::BlockView(const BlockView& object)
+    : buffer_(object.buffer_),
+      buffer_size_(object.buffer_size_),
+      header_(object.header_),
+      tx_ranges_(object.tx_ranges_) {
+  std::lock_guard<std::mutex> lock(object.cache_mutex_);
+  txids_ = object.txids_;
+  has_txids_ = object.has_txids_;
+  txid_index_map_ = object.txid_index_map_;
+  merkle_levels_ = object.merkle_levels_;
+}
+
+BlockView& BlockView::operator=(const BlockView& object) {
+  if (this != &object) {
+    buffer_ = object.buffer_;
+    buffer_size_ = object.buffer_size_;
+    header_ = object.header_;
+    tx_ranges_ = object.tx_ranges_;
+    std::lock_guard<std::mutex> lock(object.cache_mutex_);
+    txids_ = object.txids_;
+    has_txids_ = object.has_txids_;
+    txid_index_map_ = object.txid_index_map_;
+    merkle_levels_ = object.merkle_levels_;
+  }
+  return *this;
+}
+
+void BlockView::Parse(const uint8_t* buffer, size_t size) {
+  if ((buffer == nullptr) || (size < kBlockHeaderSize) ||
+      (size > std::numeric_limits<uint32_t>::max())) {
+    warn(CFD_LOG_SOURCE, "Invalid block data size. size={}", size);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "block data invalid.");
+  }
+  Deserializer dec(ByteDataView(buffer, size));
   header_.version = dec.ReadUint32();
-  header_.prev_block_hash = BlockHash(dec.ReadBuffer(32));
-  header_.merkle_root_hash = BlockHash(dec.ReadBuffer(32));
+  ByteDataView hash = dec.ReadView(kByteData256Length);
+  header_.prev_block_hash = BlockHash(ByteData256(hash.data(), hash.size()));
+  hash = dec.ReadView(kByteData256Length);
+  header_.merkle_root_hash = BlockHash(ByteData256(hash.data(), hash.size()));
   header_.time = dec.ReadUint32();
   header_.bits = dec.ReadUint32();
   header_.nonce = dec.ReadUint32();
   uint64_t tx_count = dec.ReadVariableInt();
-  size_t read_size = data.GetDataSize() - dec.GetReadSize();
-  auto txs = ByteData(dec.ReadBuffer(static_cast<uint32_t>(read_size)));
+  // each transaction is at least 10 bytes; avoid trusting the count.
+  uint64_t max_count = (size - dec.GetReadSize()) / 10;
+
+  std::vector<BlockTxRange> tx_ranges;
+  tx_ranges.reserve(static_cast<size_t>(std::min(tx_count, max_count)));
   for (uint64_t index = 0; index < tx_count; ++index) {
-    Transaction tx(txs);
-    auto tx_data = tx.GetData();
-    uint32_t cur_size = static_cast<uint32_t>(tx_data.GetDataSize());
-    uint32_t unread_size = static_cast<uint32_t>(txs.GetDataSize()) - cur_size;
-    if (unread_size != 0) {
-      auto arr = txs.SplitData(std::vector<uint32_t>{cur_size, unread_size});
-      txs = arr[1];
-    }
-    txs_.emplace_back(tx_data);
-    txids_.emplace_back(tx.GetTxid());
+    tx_ranges.push_back(ReadTransactionRange(&dec));
   }
+
+  buffer_ = buffer;
+  buffer_size_ = size;
+  tx_ranges_.swap(tx_ranges);
+  txids_.assign(tx_ranges_.size(), Txid());
+  has_txids_.assign(tx_ranges_.size(), 0);
+  txid_index_map_.clear();
+  merkle_levels_.clear();
 }
 
-Block::Block(const std::string& hex) : Block(ByteData(hex)) {}
+void BlockView::CheckIndex(uint32_t index) const {
+  if (tx_ranges_.size() <= index) {
+    throw CfdException(
+        CfdError::kCfdOutOfRangeError,
+        "The index is outside the scope of the txid list.");
+  }
+}
 
-Block::Block(const Block& object) {
-  data_ = object.data_;
-  header_ = object.header_;
-  txs_ = object.txs_;
-  txids_ = object.txids_;
+bool BlockView::IsValid() const { return buffer_ != nullptr; }
+
+BlockHash BlockView::GetBlockHash() const {
+  return BlockHash(HashUtil::Sha256D(SerializeBlockHeader()));
 }
 
-Block& Block::operator=(const Block& object) {
-  if (this != &object) {
-    data_ = object.data_;
-    header_ = object.header_;
-    txs_ = object.txs_;
-    txids_ = object.txids_;
+BlockHeader BlockView::GetBlockHeader() const { return header_; }
+
+ByteData BlockView::SerializeBlockHeader() const {
+  Serializer obj(kBlockHeaderSize);
+  obj.AddDirectNumber(header_.version);
+  obj.AddDirectBytes(header_.prev_block_hash.GetData());
+  obj.AddDirectBytes(header_.merkle_root_hash.GetData());
+  obj.AddDirectNumber(header_.time);
+  obj.AddDirectNumber(header_.bits);
+  obj.AddDirectNumber(header_.nonce);
+  return obj.Output();
+}
+
+uint32_t BlockView::GetTransactionCount() const {
+  return static_cast<uint32_t>(tx_ranges_.size());
+}
+
+Txid BlockView::GetTxid(uint32_t index) const {
+  CheckIndex(index);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (has_txids_[index] != 0) return txids_[index];
   }
-  return *this;
+  Txid txid = CalculateTxid(buffer_, tx_ranges_[index]);
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  txids_[index] = txid;
+  has_txids_[index] = 1;
+  return txid;
 }
 
-std::string Block::GetHex() const { return data_.GetHex(); }
+std::vector<Txid> BlockView::GetTxids() const { return CalculateTxids(1); }
 
-ByteData Block::GetData() const { return data_; }
+bool BlockView::FindTransactionIndex(const Txid& txid, uint32_t* index) const {
+  bool has_index_map = true;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    has_index_map = !txid_index_map_.empty() || tx_ranges_.empty();
+  }
+  if (!has_index_map) {
+    std::vector<Txid> txids = GetTxids();
+    std::unordered_map<Txid, uint32_t> txid_index_map;
+    txid_index_map.reserve(txids.size());
+    for (uint32_t tx_index = 0; tx_index < txids.size(); ++tx_index) {
+      // keep the first index if the txid is duplicated.
+      txid_index_map.emplace(txids[tx_index], tx_index);
+    }
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (txid_index_map_.empty()) txid_index_map_.swap(txid_index_map);
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto iter = txid_index_map_.find(txid);
+  if (iter == txid_index_map_.end()) return false;
+  if (index != nullptr) *index = iter->second;
+  return true;
+}
 
-BlockHash Block::GetBlockHash() const {
-  return BlockHash(HashUtil::Sha256D(SerializeBlockHeader()));
+bool BlockView::ExistTxid(const Txid& txid) const {
+  return FindTransactionIndex(txid, nullptr);
 }
 
-Txid Block::GetTxid(uint32_t index) const {
-  if (static_cast<uint32_t>(txids_.size()) <= index) {
+uint32_t BlockView::GetTransactionIndex(const Txid& txid) const {
+  uint32_t index = 0;
+  if (!FindTransactionIndex(txid, &index)) {
+    warn(CFD_LOG_SOURCE, "target txid not found. txid={}", txid.GetHex());
     throw CfdException(
-        CfdError::kCfdOutOfRangeError,
-        "The index is outside the scope of the txid list.");
+        CfdError::kCfdIllegalArgumentError, "target txid not found.");
   }
-  return txids_[index];
+  return index;
 }
 
-std::vector<Txid> Block::GetTxids() const { return txids_; }
+const BlockTxRange& BlockView::GetTransactionRange(uint32_t index) const {
+  CheckIndex(index);
+  return tx_ranges_[index];
+}
+
+ByteData BlockView::GetTransactionData(uint32_t index) const {
+  const BlockTxRange& range = GetTransactionRange(index);
+  return ByteData(buffer_ + range.offset, range.size);
+}
+
+Transaction BlockView::GetTransaction(uint32_t index) const {
+  const BlockTxRange& range = GetTransactionRange(index);
+  return Transaction(ByteDataView(buffer_ + range.offset, range.size));
+}
 
-bool Block::ExistTxid(const Txid& txid) const {
-  for (const auto& temp_txid : txids_) {
-    if (txid.Equals(temp_txid)) return true;
+Transaction BlockView::GetTransaction(const Txid& txid) const {
+  return GetTransaction(GetTransactionIndex(txid));
+}
+
+std::vector<Txid> BlockView::CalculateTxids(uint32_t thread_count) const {
+  // work on a snapshot so that the workers never touch the shared cache.
+  std::vector<Txid> txids;
+  std::vector<uint8_t> has_txids;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    txids = txids_;
+    has_txids = has_txids_;
   }
-  return false;
+  ParallelForEach(
+      tx_ranges_.size(), thread_count,
+      [this, &txids, &has_txids](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+          if (has_txids[index] == 0) {
+            txids[index] = CalculateTxid(buffer_, tx_ranges_[index]);
+          }
+        }
+      });
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  txids_ = txids;
+  has_txids_.assign(tx_ranges_.size(), 1);
+  return txids;
+}
+
+std::vector<ByteData256> BlockView::CalculateWitnessHashes(
+    uint32_t thread_count) const {
+  std::vector<ByteData256> hashes(tx_ranges_.size());
+  ParallelForEach(
+      tx_ranges_.size(), thread_count,
+      [this, &hashes](size_t begin, size_t end) {
+        std::vector<ByteDataView> inputs;
+        inputs.reserve(end - begin);
+        for (size_t index = begin; index < end; ++index) {
+          const BlockTxRange& range = tx_ranges_[index];
+          inputs.emplace_back(buffer_ + range.offset, range.size);
+        }
+        std::vector<ByteData256> chunk = HashUtil::Sha256DBatch(inputs);
+        std::move(chunk.begin(), chunk.end(), hashes.begin() + begin);
+      });
+  return hashes;
+}
+
+const std::vector<std::vector<ByteData256>>& BlockView::GetMerkleLevels(
+    uint32_t thread_count) const {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (!merkle_levels_.empty() || tx_ranges_.empty()) return merkle_levels_;
+  }
+  std::vector<Txid> txids = CalculateTxids(thread_count);
+  std::vector<ByteData256> hashes;
+  hashes.reserve(txids.size());
+  for (const auto& txid : txids) {
+    hashes.emplace_back(txid.GetData());
+  }
+  auto levels = CalculateMerkleLevels(std::move(hashes), thread_count);
+  // published once; the levels are not modified by const functions after.
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (merkle_levels_.empty()) merkle_levels_.swap(levels);
+  return merkle_levels_;
+}
+
+BlockHash BlockView::CalculateMerkleRoot(uint32_t thread_count) const {
+  const auto& levels = GetMerkleLevels(thread_count);
+  if (levels.empty()) return BlockHash();
+  return BlockHash(levels.back()[0]);
+}
+
+bool BlockView::VerifyMerkleRoot(uint32_t thread_count) const {
+  if (tx_ranges_.empty()) return false;
+  return CalculateMerkleRoot(thread_count).GetData().Equals(
+      header_.merkle_root_hash.GetData());
 }
 
-Transaction Block::GetTransaction(const Txid& txid) const {
-  for (size_t index = 0; index < txids_.size(); ++index) {
-    if (txid.Equals(txids_[index])) {
-      return Transaction(txs_[index]);
+bool BlockView::VerifyWitnessCommitment(uint32_t thread_count) const {
+  static constexpr uint8_t kCommitmentHeader[] = {0x6a, 0x24, 0xaa,
+                                                  0x21, 0xa9, 0xed};
+  static constexpr size_t kCommitmentHeaderSize = sizeof(kCommitmentHeader);
+  if (tx_ranges_.empty()) return false;
+
+  // If multiple outputs match, the last one is the commitment.
+  Transaction coinbase = GetTransaction(0);
+  ByteData commitment;
+  for (const auto& txout : coinbase.GetTxOutList()) {
+    std::vector<uint8_t> script = txout.GetLockingScript().GetData().GetBytes();
+    if ((script.size() >= kCommitmentHeaderSize + kByteData256Length) &&
+        std::equal(
+            kCommitmentHeader, kCommitmentHeader + kCommitmentHeaderSize,
+            script.begin())) {
+      commitment = ByteData(
+          script.data() + kCommitmentHeaderSize, kByteData256Length);
     }
   }
-  throw CfdException(
-      CfdError::kCfdIllegalArgumentError, "target txid not found.");
+
+  if (commitment.IsEmpty()) {
+    for (const auto& range : tx_ranges_) {
+      if (range.witness_offset != 0) return false;
+    }
+    return true;
+  }
+
+  if (coinbase.GetTxInCount() == 0) return false;
+  std::vector<ByteData> reserved_value =
+      coinbase.GetTxIn(0).GetScriptWitness().GetWitness();
+  if ((reserved_value.size() != 1) ||
+      (reserved_value[0].GetDataSize() != kByteData256Length)) {
+    return false;
+  }
+
+  std::vector<ByteData256> hashes = CalculateWitnessHashes(thread_count);
+  hashes[0] = ByteData256();  // coinbase wtxid is always zero.
+  ByteData256 root = CalculateMerkleRootHash(hashes, thread_count);
+  ByteData256 hash = HashUtil::Sha256D(root.Concat(reserved_value[0]));
+  return commitment.Equals(hash.GetData());
 }
 
-uint32_t Block::GetTransactionCount() const {
-  return static_cast<uint32_t>(txids_.size());
+// -----------------------------------------------------------------------------
+// Block
+// -----------------------------------------------------------------------------
+Block::Block() : BlockView(), data_() {
+  // do nothing
 }
 
-BlockHeader Block::GetBlockHeader() const { return header_; }
+Block::Block(const ByteData& data) : BlockView(), data_(data.GetBytes()) {
+  Parse(data_.data(), data_.size());
+}
 
-ByteData Block::SerializeBlockHeader() const {
-  Serializer obj;
-  obj.AddDirectNumber(header_.version);
-  obj.AddDirectBytes(header_.prev_block_hash.GetData());
-  obj.AddDirectBytes(header_.merkle_root_hash.GetData());
-  obj.AddDirectNumber(header_.time);
-  obj.AddDirectNumber(header_.bits);
-  obj.AddDirectNumber(header_.nonce);
-  return obj.Output();
+Block::Block(const std::string& hex) : Block(ByteData(hex)) {}
+
+Block::Block(const Block& object) : BlockView(object), data_(object.data_) {
+  if (buffer_ != nullptr) buffer_ = data_.data();
+}
+
+Block& Block::operator=(const Block& object) {
+  if (this != &object) {
+    BlockView::operator=(object);
+    data_ = object.data_;
+    if (buffer_ != nullptr) buffer_ = data_.data();
+  }
+  return *this;
 }
 
-bool Block::IsValid() const { return !data_.IsEmpty(); }
+std::string Block::GetHex() const { return StringUtil::ByteToString(data_); }
+
+ByteData Block::GetData() const { return ByteData(data_); }
 
 ByteData Block::GetTxOutProof(const Txid& txid) const {
   return GetTxOutProof(std::vector<Txid>{txid});
 }
 
 ByteData Block::GetTxOutProof(const std::vector<Txid>& txids) const {
-  MerkleBlock merkle_block(*this, txids);
+  uint32_t tx_count = GetTransactionCount();
+  if (tx_count == 0) {
+    warn(CFD_LOG_SOURCE, "block has no transaction.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "block has no transaction.");
+  }
+  std::vector<bool> target_indexes(tx_count, false);
+  uint32_t index = 0;
+  for (const auto& txid : txids) {
+    if (FindTransactionIndex(txid, &index)) target_indexes[index] = true;
+  }
+  MerkleBlock merkle_block(GetMerkleLevels(), target_indexes);
   Serializer obj;
   obj.AddDirectBytes(SerializeBlockHeader());
   obj.AddDirectBytes(merkle_block.Serialize());
@@ -170,29 +579,14 @@ ByteData Block::GetTxOutProof(const std::vector<Txid>& txids) const {
 // -----------------------------------------------------------------------------
 // MerkleBlock
 // -----------------------------------------------------------------------------
-MerkleBlock::MerkleBlock(const Block& block, const std::vector<Txid>& txids) {
-  std::vector<bool> target_indexes;
-  auto txid_list = block.GetTxids();
-  target_indexes.reserve(txid_list.size());
-  for (const auto& txid : txid_list) {
-    bool is_find = false;
-    for (const auto& target_txid : txids) {
-      if (target_txid.Equals(txid)) {
-        is_find = true;
-        break;
-      }
-    }
-    target_indexes.push_back(is_find);
-  }
-
-  transaction_count = static_cast<uint64_t>(txid_list.size());
-  bits_.clear();
-  txids_.clear();
-
+MerkleBlock::MerkleBlock(
+    const std::vector<std::vector<ByteData256>>& merkle_levels,
+    const std::vector<bool>& target_indexes)
+    : transaction_count(target_indexes.size()), merkle_levels_(merkle_levels) {
   uint64_t height = 0;
   while (CalcTreeWidth(transaction_count, height) > 1) ++height;
 
-  TraverseAndBuild(height, 0, txid_list, target_indexes);
+  TraverseAndBuild(height, 0, target_indexes);
 }
 
 ByteData MerkleBlock::Serialize() const {
@@ -208,8 +602,7 @@ ByteData MerkleBlock::Serialize() const {
 }
 
 void MerkleBlock::TraverseAndBuild(
-    uint64_t height, uint64_t pos, const std::vector<Txid>& txids,
-    const std::vector<bool> matches) {
+    uint64_t height, uint64_t pos, const std::vector<bool>& matches) {
   bool has_parent_of_match = false;
   for (uint64_t index = pos << height;
        (index < ((pos + 1) << height)) && (index < transaction_count);
@@ -222,29 +615,14 @@ void MerkleBlock::TraverseAndBuild(
   bits_.push_back(has_parent_of_match);
   if ((height == 0) || (!has_parent_of_match)) {
     // if at height 0, or nothing interesting below, store hash and stop
-    txids_.push_back(CalculateHash(height, pos, txids));
+    txids_.push_back(Txid(merkle_levels_[height][pos]));
   } else {
-    TraverseAndBuild(height - 1, pos * 2, txids, matches);
+    TraverseAndBuild(height - 1, pos * 2, matches);
     if ((pos * 2 + 1) < CalcTreeWidth(transaction_count, height - 1)) {
-      TraverseAndBuild(height - 1, pos * 2 + 1, txids, matches);
+      TraverseAndBuild(height - 1, pos * 2 + 1, matches);
     }
   }
 }
 
-Txid MerkleBlock::CalculateHash(
-    uint64_t height, uint64_t pos, const std::vector<Txid>& txids) {
-  if (height == 0) return txids[pos];
-
-  Txid left = CalculateHash(height - 1, pos * 2, txids);
-  Txid right;
-  if ((pos * 2 + 1) < CalcTreeWidth(transaction_count, height - 1)) {
-    right = CalculateHash(height - 1, pos * 2 + 1, txids);
-  } else {
-    right = left;
-  }
-  ByteData data = left.GetData().Concat(right.GetData());
-  return Txid(HashUtil::Sha256D(data));
-}
-
 }  // namespace core
 }  // namespace cfd
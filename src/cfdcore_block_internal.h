@@ -25,10 +25,12 @@ class CFD_CORE_EXPORT MerkleBlock {
  public:
   /**
    * @brief constructor.
-   * @param[in] block   block object.
-   * @param[in] txids   target txid list.
+   * @param[in] merkle_levels   merkle tree hash list per level.
+   * @param[in] target_indexes  target transaction flag list.
    */
-  MerkleBlock(const Block& block, const std::vector<Txid>& txids);
+  MerkleBlock(
+      const std::vector<std::vector<ByteData256>>& merkle_levels,
+      const std::vector<bool>& target_indexes);
 
   /**
    * @brief get serialize data.
@@ -40,29 +42,27 @@ class CFD_CORE_EXPORT MerkleBlock {
   uint64_t transaction_count;  //!< total number of transactions
   std::vector<bool> bits_;     //!< node-is-parent-of-matched-txid bits
   std::vector<Txid> txids_;    //!< transaction id list
+  //! merkle tree hash list per level
+  const std::vector<std::vector<ByteData256>>& merkle_levels_;
 
   /**
    * @brief Traverse and build.
    * @param[in] height      height
    * @param[in] pos         position
-   * @param[in] txids       txid list
    * @param[in] matches     target match list
    */
   void TraverseAndBuild(
-      uint64_t height, uint64_t pos, const std::vector<Txid>& txids,
-      const std::vector<bool> matches);
-
-  /**
-   * @brief calculate hash.
-   * @param[in] height      height
-   * @param[in] pos         position
-   * @param[in] txids       txid list
-   * @return hash (txid)
-   */
-  Txid CalculateHash(
-      uint64_t height, uint64_t pos, const std::vector<Txid>& txids);
+      uint64_t height, uint64_t pos, const std::vector<bool>& matches);
 };
 
+/**
+ * @brief Read a transaction range without parsing it into a transaction.
+ * @details The deserializer advances to the next transaction.
+ * @param[in,out] dec   deserializer positioned at the transaction start.
+ * @return transaction byte range
+ */
+extern BlockTxRange ReadTransactionRange(Deserializer* dec);
+
 }  // namespace core
 }  // namespace cfd
 #endif  // CFD_CORE_SRC_CFDCORE_BLOCK_INTERNAL_H_
@@ -6,8 +6,11 @@
  */
 #include "cfdcore/cfdcore_bytedata.h"
 
+#include <cstring>
 #include <limits>
+#include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
@@ -59,6 +62,13 @@ ByteData::ByteData(const std::vector<uint8_t>& vector) : data_(vector) {
   }
 }
 
+ByteData::ByteData(std::vector<uint8_t>&& vector) : data_(std::move(vector)) {
+  if (data_.size() > std::numeric_limits<uint32_t>::max()) {
+    warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
+    throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
+  }
+}
+
 ByteData::ByteData(const std::string& hex)
     : data_(StringUtil::StringToByte(hex)) {}
 
@@ -84,7 +94,9 @@ std::string ByteData::GetHex() const {
   return StringUtil::ByteToString(data_);
 }
 
-std::vector<uint8_t> ByteData::GetBytes() const { return data_; }
+const std::vector<uint8_t>& ByteData::GetBytes() const& { return data_; }
+
+std::vector<uint8_t> ByteData::GetBytes() const&& { return data_; }
 
 size_t ByteData::GetDataSize() const { return data_.size(); }
 
@@ -176,56 +188,52 @@ bool ByteData::operator==(const ByteData& object) const {
 //////////////////////////////////
 /// ByteData160
 //////////////////////////////////
-ByteData160::ByteData160() : data_(std::vector<uint8_t>(kByteData160Length)) {
-  memset(data_.data(), 0, data_.size());
+ByteData160::ByteData160() : data_() {
+  // zero filled
 }
 
 ByteData160::ByteData160(const std::vector<uint8_t>& vector)
-    : data_(std::vector<uint8_t>(kByteData160Length)) {
-  if (vector.size() != kByteData160Length) {
-    warn(CFD_LOG_SOURCE, "ByteData160 size unmatch. size={}.", vector.size());
-    throw CfdException(
-        CfdError::kCfdIllegalArgumentError, "ByteData160 size unmatch.");
-  }
-  data_ = vector;
-}
+    : ByteData160(vector.data(), vector.size()) {}
 
 ByteData160::ByteData160(const std::string& hex)
-    : data_(std::vector<uint8_t>(kByteData160Length)) {
-  std::vector<uint8_t> vector = StringUtil::StringToByte(hex);
-  if (vector.size() != kByteData160Length) {
-    warn(CFD_LOG_SOURCE, "ByteData160 size unmatch. size={}.", vector.size());
+    : ByteData160(StringUtil::StringToByte(hex)) {}
+
+ByteData160::ByteData160(const ByteData& byte_data)
+    : ByteData160(byte_data.GetBytes()) {}
+
+ByteData160::ByteData160(const uint8_t* buffer, size_t size) : data_() {
+  if (size != kByteData160Length) {
+    warn(CFD_LOG_SOURCE, "ByteData160 size unmatch. size={}.", size);
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "ByteData160 size unmatch.");
   }
-  data_ = vector;
+  memcpy(data_.data(), buffer, data_.size());
 }
 
-ByteData160::ByteData160(const ByteData& byte_data)
-    : ByteData160(byte_data.GetBytes()) {}
-
 std::string ByteData160::GetHex() const {
-  return StringUtil::ByteToString(data_);
+  return StringUtil::ByteToString(ByteDataView(*this));
 }
 
-std::vector<uint8_t> ByteData160::GetBytes() const { return data_; }
+std::vector<uint8_t> ByteData160::GetBytes() const {
+  return std::vector<uint8_t>(data_.begin(), data_.end());
+}
 
 bool ByteData160::Empty() const { return IsEmpty(); }
 
 bool ByteData160::IsEmpty() const {
-  std::vector<uint8_t> data(kByteData160Length);
-  memset(data.data(), 0, data.size());
-  return data_ == data;
+  for (uint8_t value : data_) {
+    if (value != 0) return false;
+  }
+  return true;
 }
 
 bool ByteData160::Equals(const ByteData160& bytedata) const {
-  if (data_ == bytedata.data_) {
-    return true;
-  }
-  return false;
+  return data_ == bytedata.data_;
 }
 
-ByteData ByteData160::GetData() const { return ByteData(data_); }
+ByteData ByteData160::GetData() const {
+  return ByteData(data_.data(), static_cast<uint32_t>(data_.size()));
+}
 
 uint8_t ByteData160::GetHeadData() const { return data_[0]; }
 
@@ -242,56 +250,52 @@ bool ByteData160::operator==(const ByteData160& object) const {
 //////////////////////////////////
 /// ByteData256
 //////////////////////////////////
-ByteData256::ByteData256() : data_(std::vector<uint8_t>(kByteData256Length)) {
-  memset(data_.data(), 0, data_.size());
+ByteData256::ByteData256() : data_() {
+  // zero filled
 }
 
 ByteData256::ByteData256(const std::vector<uint8_t>& vector)
-    : data_(std::vector<uint8_t>(kByteData256Length)) {
-  if (vector.size() != kByteData256Length) {
-    warn(CFD_LOG_SOURCE, "ByteData256 size unmatch. size={}.", vector.size());
-    throw CfdException(
-        CfdError::kCfdIllegalArgumentError, "ByteData256 size unmatch.");
-  }
-  data_ = vector;
-}
+    : ByteData256(vector.data(), vector.size()) {}
 
 ByteData256::ByteData256(const std::string& hex)
-    : data_(std::vector<uint8_t>(kByteData256Length)) {
-  std::vector<uint8_t> vector = StringUtil::StringToByte(hex);
-  if (vector.size() != kByteData256Length) {
-    warn(CFD_LOG_SOURCE, "ByteData256 size unmatch. size={}.", vector.size());
+    : ByteData256(StringUtil::StringToByte(hex)) {}
+
+ByteData256::ByteData256(const ByteData& byte_data)
+    : ByteData256(byte_data.GetBytes()) {}
+
+ByteData256::ByteData256(const uint8_t* buffer, size_t size) : data_() {
+  if (size != kByteData256Length) {
+    warn(CFD_LOG_SOURCE, "ByteData256 size unmatch. size={}.", size);
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "ByteData256 size unmatch.");
   }
-  data_ = vector;
+  memcpy(data_.data(), buffer, data_.size());
 }
 
-ByteData256::ByteData256(const ByteData& byte_data)
-    : ByteData256(byte_data.GetBytes()) {}
-
 std::string ByteData256::GetHex() const {
-  return StringUtil::ByteToString(data_);
+  return StringUtil::ByteToString(ByteDataView(*this));
 }
 
-std::vector<uint8_t> ByteData256::GetBytes() const { return data_; }
+std::vector<uint8_t> ByteData256::GetBytes() const {
+  return std::vector<uint8_t>(data_.begin(), data_.end());
+}
 
 bool ByteData256::Empty() const { return IsEmpty(); }
 
 bool ByteData256::IsEmpty() const {
-  std::vector<uint8_t> data(kByteData256Length);
-  memset(data.data(), 0, data.size());
-  return data_ == data;
+  for (uint8_t value : data_) {
+    if (value != 0) return false;
+  }
+  return true;
 }
 
 bool ByteData256::Equals(const ByteData256& bytedata) const {
-  if (data_ == bytedata.data_) {
-    return true;
-  }
-  return false;
+  return memcmp(data_.data(), bytedata.data_.data(), data_.size()) == 0;
 }
 
-ByteData ByteData256::GetData() const { return ByteData(data_); }
+ByteData ByteData256::GetData() const {
+  return ByteData(data_.data(), static_cast<uint32_t>(data_.size()));
+}
 
 uint8_t ByteData256::GetHeadData() const { return data_[0]; }
 
@@ -302,7 +306,46 @@ ByteData ByteData256::Serialize() const {
 }
 
 bool ByteData256::operator==(const ByteData256& object) const {
-  return (data_ == object.data_);
+  return Equals(object);
+}
+
+bool ByteData256::operator!=(const ByteData256& object) const {
+  return !Equals(object);
+}
+
+bool ByteData256::operator<(const ByteData256& object) const {
+  return memcmp(data_.data(), object.data_.data(), data_.size()) < 0;
+}
+
+//////////////////////////////////
+/// ByteDataView
+//////////////////////////////////
+ByteDataView ByteDataView::GetSubView(size_t offset, size_t size) const {
+  if ((offset > size_) || (size > (size_ - offset))) {
+    warn(
+        CFD_LOG_SOURCE, "ByteDataView out of range. offset={}, size={}.",
+        offset, size);
+    throw CfdException(
+        CfdError::kCfdOutOfRangeError, "ByteDataView out of range.");
+  }
+  return ByteDataView(data_ + offset, size);
+}
+
+std::string ByteDataView::GetHex() const {
+  return StringUtil::ByteToString(*this);
+}
+
+std::vector<uint8_t> ByteDataView::GetBytes() const {
+  return std::vector<uint8_t>(begin(), end());
+}
+
+ByteData ByteDataView::GetData() const {
+  return ByteData(GetBytes());
+}
+
+bool ByteDataView::Equals(const ByteDataView& view) const {
+  if (size_ != view.size_) return false;
+  return (size_ == 0) || (memcmp(data_, view.data_, size_) == 0);
 }
 
 //////////////////////////////////
@@ -518,8 +561,14 @@ Serializer& Serializer::operator<<(int64_t number) {
 ByteData Serializer::Output() { return ByteData(buffer_.data(), offset_); }
 
 Deserializer::Deserializer(const std::vector<uint8_t>& buffer)
-    : buffer_(buffer), offset_(0) {
-  // do nothing
+    : buffer_(), view_(), offset_(0) {
+  // the read offset is 32 bits.
+  if (buffer.size() > std::numeric_limits<uint32_t>::max()) {
+    warn(CFD_LOG_SOURCE, "Invalid buffer size. size={}", buffer.size());
+    throw CfdException(kCfdIllegalArgumentError, "buffer size is too large.");
+  }
+  buffer_ = buffer;
+  view_ = ByteDataView(buffer_);
 }
 
 Deserializer::Deserializer(const ByteData& buffer)
@@ -527,15 +576,30 @@ Deserializer::Deserializer(const ByteData& buffer)
   // do nothing
 }
 
+Deserializer::Deserializer(const ByteDataView& buffer)
+    : buffer_(), view_(buffer), offset_(0) {
+  // the read offset is 32 bits.
+  if (buffer.size() > std::numeric_limits<uint32_t>::max()) {
+    warn(CFD_LOG_SOURCE, "Invalid buffer size. size={}", buffer.size());
+    throw CfdException(kCfdIllegalArgumentError, "buffer size is too large.");
+  }
+}
+
 Deserializer::Deserializer(const Deserializer& object)
-    : buffer_(object.buffer_), offset_(object.offset_) {
-  // do nothing
+    : buffer_(object.buffer_), view_(object.view_), offset_(object.offset_) {
+  if (object.view_.data() == object.buffer_.data()) {
+    view_ = ByteDataView(buffer_);
+  }
 }
 
 Deserializer& Deserializer::operator=(const Deserializer& object) {
   if (this != &object) {
     buffer_ = object.buffer_;
+    view_ = object.view_;
     offset_ = object.offset_;
+    if (object.view_.data() == object.buffer_.data()) {
+      view_ = ByteDataView(buffer_);
+    }
   }
   return *this;
 }
@@ -543,7 +607,7 @@ Deserializer& Deserializer::operator=(const Deserializer& object) {
 uint64_t Deserializer::ReadUint64() {
   uint64_t result = 0;
   CheckReadSize(sizeof(result));
-  memcpy(&result, &buffer_.data()[offset_], sizeof(result));
+  memcpy(&result, &view_.data()[offset_], sizeof(result));
   offset_ += sizeof(result);
   return result;
 }
@@ -551,7 +615,7 @@ uint64_t Deserializer::ReadUint64() {
 uint32_t Deserializer::ReadUint32() {
   uint32_t result = 0;
   CheckReadSize(sizeof(result));
-  memcpy(&result, &buffer_.data()[offset_], sizeof(result));
+  memcpy(&result, &view_.data()[offset_], sizeof(result));
   offset_ += sizeof(result);
   return result;
 }
@@ -559,7 +623,7 @@ uint32_t Deserializer::ReadUint32() {
 uint8_t Deserializer::ReadUint8() {
   uint8_t result = 0;
   CheckReadSize(sizeof(result));
-  memcpy(&result, &buffer_.data()[offset_], sizeof(result));
+  memcpy(&result, &view_.data()[offset_], sizeof(result));
   offset_ += sizeof(result);
   return result;
 }
@@ -568,10 +632,10 @@ uint32_t Deserializer::ReadUint32FromBigEndian() {
   uint32_t result = 0;
   CheckReadSize(sizeof(result));
   if (IsBigEndian()) {
-    memcpy(&result, &buffer_.data()[offset_], sizeof(result));
+    memcpy(&result, &view_.data()[offset_], sizeof(result));
   } else {
     uint8_t tmp_buf[4];
-    memcpy(tmp_buf, &buffer_.data()[offset_], sizeof(tmp_buf));
+    memcpy(tmp_buf, &view_.data()[offset_], sizeof(tmp_buf));
     result = static_cast<uint32_t>(tmp_buf[3] & 0x000000ff) +
              static_cast<uint32_t>((tmp_buf[2] << 8) & 0x0000ff00) +
              static_cast<uint32_t>((tmp_buf[1] << 16) & 0x00ff0000) +
@@ -583,7 +647,7 @@ uint32_t Deserializer::ReadUint32FromBigEndian() {
 
 uint64_t Deserializer::ReadVariableInt() {
   CheckReadSize(1);
-  const uint8_t* buf = buffer_.data() + offset_;
+  const uint8_t* buf = view_.data() + offset_;
   uint64_t value = 0;
   if (*buf <= Serializer::kViMax8) {
     value = *buf;
@@ -616,7 +680,7 @@ uint64_t Deserializer::ReadVariableInt() {
 std::vector<uint8_t> Deserializer::ReadBuffer(uint32_t size) {
   CheckReadSize(size);
   std::vector<uint8_t> result(size);
-  memcpy(result.data(), &buffer_.data()[offset_], size);
+  memcpy(result.data(), &view_.data()[offset_], size);
   offset_ += size;
   return result;
 }
@@ -624,7 +688,7 @@ std::vector<uint8_t> Deserializer::ReadBuffer(uint32_t size) {
 void Deserializer::ReadArray(uint8_t* output, size_t size) {
   if (output != nullptr) {
     CheckReadSize(size);
-    memcpy(output, &buffer_.data()[offset_], size);
+    memcpy(output, &view_.data()[offset_], size);
     offset_ += static_cast<uint32_t>(size);
   }
 }
@@ -637,7 +701,7 @@ std::vector<uint8_t> Deserializer::ReadVariableBuffer() {
   }
   CheckReadSize(data_size);
 
-  uint8_t* buf = buffer_.data() + offset_;
+  const uint8_t* buf = view_.data() + offset_;
   std::vector<uint8_t> result(data_size);
   memcpy(result.data(), buf, data_size);
   offset_ += static_cast<uint32_t>(data_size);
@@ -648,20 +712,155 @@ ByteData Deserializer::ReadVariableData() {
   return ByteData(ReadVariableBuffer());
 }
 
+ByteDataView Deserializer::ReadView(uint32_t size) {
+  CheckReadSize(size);
+  ByteDataView result(view_.data() + offset_, size);
+  offset_ += size;
+  return result;
+}
+
+ByteDataView Deserializer::ReadVariableView() {
+  uint64_t data_size = ReadVariableInt();
+  CheckReadSize(data_size);
+  ByteDataView result(view_.data() + offset_, static_cast<size_t>(data_size));
+  offset_ += static_cast<uint32_t>(data_size);
+  return result;
+}
+
+void Deserializer::SkipBytes(uint64_t size) {
+  CheckReadSize(size);
+  offset_ += static_cast<uint32_t>(size);
+}
+
+uint64_t Deserializer::SkipVariableBuffer() {
+  uint64_t data_size = ReadVariableInt();
+  SkipBytes(data_size);
+  return data_size;
+}
+
 uint32_t Deserializer::GetReadSize() { return offset_; }
 
-bool Deserializer::HasEof() { return (buffer_.size() <= offset_); }
+bool Deserializer::HasEof() { return (view_.size() <= offset_); }
 
 void Deserializer::CheckReadSize(uint64_t size) {
   if (size > std::numeric_limits<uint32_t>::max()) {
     warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
     throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
   }
-  if (buffer_.size() < (offset_ + size)) {
+  if (view_.size() < (offset_ + size)) {
     warn(CFD_LOG_SOURCE, "deserialize buffer EOF.");
     throw CfdException(kCfdIllegalStateError, "deserialize buffer EOF.");
   }
 }
 
+namespace {
+
+/**
+ * @brief SipHash key. It is created once per process.
+ */
+struct SipHashKey {
+  uint64_t k0;  //!< key 0
+  uint64_t k1;  //!< key 1
+};
+
+/**
+ * @brief Get the process-wide SipHash key.
+ * @return SipHash key
+ */
+const SipHashKey& GetSipHashKey() {
+  static const SipHashKey kKey = []() {
+    std::random_device rd;
+    SipHashKey key;
+    key.k0 = (static_cast<uint64_t>(rd()) << 32) | rd();
+    key.k1 = (static_cast<uint64_t>(rd()) << 32) | rd();
+    return key;
+  }();
+  return kKey;
+}
+
+/**
+ * @brief Rotate the 64bit value left.
+ * @param[in] value   value
+ * @param[in] bits    rotate bits
+ * @return rotated value
+ */
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+/**
+ * @brief SipHash round.
+ * @param[in,out] v0  state 0
+ * @param[in,out] v1  state 1
+ * @param[in,out] v2  state 2
+ * @param[in,out] v3  state 3
+ */
+inline void SipRound(uint64_t* v0, uint64_t* v1, uint64_t* v2, uint64_t* v3) {
+  *v0 += *v1;
+  *v1 = RotateLeft(*v1, 13);
+  *v1 ^= *v0;
+  *v0 = RotateLeft(*v0, 32);
+  *v2 += *v3;
+  *v3 = RotateLeft(*v3, 16);
+  *v3 ^= *v2;
+  *v0 += *v3;
+  *v3 = RotateLeft(*v3, 21);
+  *v3 ^= *v0;
+  *v2 += *v1;
+  *v1 = RotateLeft(*v1, 17);
+  *v1 ^= *v2;
+  *v2 = RotateLeft(*v2, 32);
+}
+
+/**
+ * @brief SipHash-2-4 of a 32byte value.
+ * @details Same as SipHashUint256 on bitcoin core.
+ * @param[in] key     SipHash key
+ * @param[in] data    32byte data
+ * @return hash value
+ */
+uint64_t SipHash256(const SipHashKey& key, const uint8_t* data) {
+  uint64_t v0 = 0x736f6d6570736575ULL ^ key.k0;
+  uint64_t v1 = 0x646f72616e646f6dULL ^ key.k1;
+  uint64_t v2 = 0x6c7967656e657261ULL ^ key.k0;
+  uint64_t v3 = 0x7465646279746573ULL ^ key.k1;
+  for (size_t offset = 0; offset < 32; offset += 8) {
+    uint64_t word = 0;
+    for (size_t index = 0; index < 8; ++index) {
+      word |= static_cast<uint64_t>(data[offset + index]) << (index * 8);
+    }
+    v3 ^= word;
+    SipRound(&v0, &v1, &v2, &v3);
+    SipRound(&v0, &v1, &v2, &v3);
+    v0 ^= word;
+  }
+  // the length (32) is placed on the top byte of the last block.
+  const uint64_t last_word = static_cast<uint64_t>(32) << 56;
+  v3 ^= last_word;
+  SipRound(&v0, &v1, &v2, &v3);
+  SipRound(&v0, &v1, &v2, &v3);
+  v0 ^= last_word;
+  v2 ^= 0xff;
+  SipRound(&v0, &v1, &v2, &v3);
+  SipRound(&v0, &v1, &v2, &v3);
+  SipRound(&v0, &v1, &v2, &v3);
+  SipRound(&v0, &v1, &v2, &v3);
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+}  // namespace
+
 }  // namespace core
 }  // namespace cfd
+
+namespace std {
+
+size_t hash<cfd::core::ByteData256>::operator()(
+    const cfd::core::ByteData256& data) const {
+  // keyed hash, so that the keys of the untrusted data can not be chosen
+  // to collide on the hash table.
+  return static_cast<size_t>(
+      cfd::core::SipHash256(cfd::core::GetSipHashKey(), data.data()));
+}
+
+}  // namespace std
@@ -6,6 +6,7 @@
  */
 #include "cfdcore/cfdcore_coin.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -21,11 +22,11 @@ using logger::warn;
 // -----------------------------------------------------------------------------
 // Txid
 // -----------------------------------------------------------------------------
-Txid::Txid() : data_(ByteData()) {
+Txid::Txid() : data_(), is_valid_(false) {
   // do nothing
 }
 
-Txid::Txid(const std::string& hex) : data_() {
+Txid::Txid(const std::string& hex) : data_(), is_valid_(false) {
   const std::vector<uint8_t>& data = StringUtil::StringToByte(hex);
   std::vector<uint8_t> reverse_buffer(data.crbegin(), data.crend());
   if (reverse_buffer.size() != kByteData256Length) {
@@ -33,45 +34,66 @@ Txid::Txid(const std::string& hex) : data_() {
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "Txid size Invalid.");
   }
-  data_ = ByteData(reverse_buffer);
+  data_ = ByteData256(reverse_buffer);
+  is_valid_ = true;
 }
 
-Txid::Txid(const ByteData256& data) : data_(ByteData(data.GetBytes())) {
+Txid::Txid(const ByteData256& data) : data_(data), is_valid_(true) {
   // do nothing
 }
 
-Txid::Txid(const Txid& object) { data_ = object.data_; }
+Txid::Txid(const Txid& object)
+    : data_(object.data_), is_valid_(object.is_valid_) {
+  // do nothing
+}
 
 Txid& Txid::operator=(const Txid& object) {
   if (this != &object) {
     data_ = object.data_;
+    is_valid_ = object.is_valid_;
   }
   return *this;
 }
 
 const std::string Txid::GetHex() const {
-  const std::vector<uint8_t>& data = data_.GetBytes();
-  std::vector<uint8_t> reverse_buffer(data.crbegin(), data.crend());
+  if (!is_valid_) return std::string();
+  std::vector<uint8_t> reverse_buffer(data_.begin(), data_.end());
+  std::reverse(reverse_buffer.begin(), reverse_buffer.end());
   return StringUtil::ByteToString(reverse_buffer);
 }
 
-const ByteData Txid::GetData() const { return data_; }
+const ByteData Txid::GetData() const {
+  if (!is_valid_) return ByteData();
+  return data_.GetData();
+}
+
+const ByteData256& Txid::GetByteData256() const& { return data_; }
+
+ByteData256 Txid::GetByteData256() const&& { return data_; }
 
 bool Txid::Equals(const Txid& txid) const {
-  if (data_.Equals(txid.data_)) {
-    return true;
-  }
-  return false;
+  return (is_valid_ == txid.is_valid_) && data_.Equals(txid.data_);
 }
 
-bool Txid::IsValid() const {
-  return (data_.GetDataSize() == kByteData256Length);
+bool Txid::IsValid() const { return is_valid_; }
+
+bool Txid::operator==(const Txid& object) const { return Equals(object); }
+
+bool Txid::operator!=(const Txid& object) const { return !Equals(object); }
+
+bool Txid::operator<(const Txid& object) const {
+  if (data_ == object.data_) return is_valid_ < object.is_valid_;
+  return data_ < object.data_;
 }
 
 // -----------------------------------------------------------------------------
 // BlockHash
 // -----------------------------------------------------------------------------
-BlockHash::BlockHash(const std::string& hex) : data_() {
+BlockHash::BlockHash() : data_(), is_valid_(false) {
+  // do nothing
+}
+
+BlockHash::BlockHash(const std::string& hex) : data_(), is_valid_(false) {
   const std::vector<uint8_t>& data = StringUtil::StringToByte(hex);
   std::vector<uint8_t> reverse_buffer(data.crbegin(), data.crend());
   if (reverse_buffer.size() != kByteData256Length) {
@@ -81,34 +103,74 @@ BlockHash::BlockHash(const std::string& hex) : data_() {
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "BlockHash size Invalid.");
   }
-  data_ = ByteData(reverse_buffer);
+  data_ = ByteData256(reverse_buffer);
+  is_valid_ = true;
 }
 
-BlockHash::BlockHash(const ByteData256& data)
-    : data_(ByteData(data.GetBytes())) {
+BlockHash::BlockHash(const ByteData256& data) : data_(data), is_valid_(true) {
   // do nothing
 }
 
-BlockHash::BlockHash(const BlockHash& object) { data_ = object.data_; }
+BlockHash::BlockHash(const BlockHash& object)
+    : data_(object.data_), is_valid_(object.is_valid_) {
+  // do nothing
+}
 
 BlockHash& BlockHash::operator=(const BlockHash& object) {
   if (this != &object) {
     data_ = object.data_;
+    is_valid_ = object.is_valid_;
   }
   return *this;
 }
 
 const std::string BlockHash::GetHex() const {
-  const std::vector<uint8_t>& data = data_.GetBytes();
-  std::vector<uint8_t> reverse_buffer(data.crbegin(), data.crend());
+  if (!is_valid_) return std::string();
+  std::vector<uint8_t> reverse_buffer(data_.begin(), data_.end());
+  std::reverse(reverse_buffer.begin(), reverse_buffer.end());
   return StringUtil::ByteToString(reverse_buffer);
 }
 
-const ByteData BlockHash::GetData() const { return data_; }
+const ByteData BlockHash::GetData() const {
+  if (!is_valid_) return ByteData();
+  return data_.GetData();
+}
+
+const ByteData256& BlockHash::GetByteData256() const& { return data_; }
+
+ByteData256 BlockHash::GetByteData256() const&& { return data_; }
+
+bool BlockHash::Equals(const BlockHash& block_hash) const {
+  return (is_valid_ == block_hash.is_valid_) && data_.Equals(block_hash.data_);
+}
+
+bool BlockHash::IsValid() const { return is_valid_; }
+
+bool BlockHash::operator==(const BlockHash& object) const {
+  return Equals(object);
+}
 
-bool BlockHash::IsValid() const {
-  return (data_.GetDataSize() == kByteData256Length);
+bool BlockHash::operator!=(const BlockHash& object) const {
+  return !Equals(object);
+}
+
+bool BlockHash::operator<(const BlockHash& object) const {
+  if (data_ == object.data_) return is_valid_ < object.is_valid_;
+  return data_ < object.data_;
 }
 
 }  // namespace core
 }  // namespace cfd
+
+namespace std {
+
+size_t hash<cfd::core::Txid>::operator()(const cfd::core::Txid& txid) const {
+  return hash<cfd::core::ByteData256>()(txid.GetByteData256());
+}
+
+size_t hash<cfd::core::BlockHash>::operator()(
+    const cfd::core::BlockHash& block_hash) const {
+  return hash<cfd::core::ByteData256>()(block_hash.GetByteData256());
+}
+
+}  // namespace std
@@ -385,6 +385,32 @@ DescriptorKeyReference& DescriptorKeyReference::operator=(
   return *this;
 }
 
+DescriptorKeyReference::DescriptorKeyReference(
+    DescriptorKeyReference&& object) noexcept
+    : key_type_(object.key_type_),
+      schnorr_pubkey_(std::move(object.schnorr_pubkey_)),
+      pubkey_(std::move(object.pubkey_)),
+      extprivkey_(std::move(object.extprivkey_)),
+      extpubkey_(std::move(object.extpubkey_)),
+      key_data_(std::move(object.key_data_)),
+      argument_(std::move(object.argument_)) {
+  // do nothing
+}
+
+DescriptorKeyReference& DescriptorKeyReference::operator=(
+    DescriptorKeyReference&& object) noexcept {
+  if (this != &object) {
+    key_type_ = object.key_type_;
+    pubkey_ = std::move(object.pubkey_);
+    schnorr_pubkey_ = std::move(object.schnorr_pubkey_);
+    extprivkey_ = std::move(object.extprivkey_);
+    extpubkey_ = std::move(object.extpubkey_);
+    key_data_ = std::move(object.key_data_);
+    argument_ = std::move(object.argument_);
+  }
+  return *this;
+}
+
 Pubkey DescriptorKeyReference::GetPubkey() const { return pubkey_; }
 
 SchnorrPubkey DescriptorKeyReference::GetSchnorrPubkey() const {
@@ -570,7 +596,47 @@ DescriptorScriptReference& DescriptorScriptReference::operator=(
   return *this;
 }
 
-Script DescriptorScriptReference::GetLockingScript() const {
+DescriptorScriptReference::DescriptorScriptReference(
+    DescriptorScriptReference&& object) noexcept
+    : script_type_(object.script_type_),
+      locking_script_(std::move(object.locking_script_)),
+      is_script_(object.is_script_),
+      redeem_script_(std::move(object.redeem_script_)),
+      address_script_(std::move(object.address_script_)),
+      req_num_(object.req_num_),
+      tapbranch_(std::move(object.tapbranch_)),
+      is_tapbranch_(object.is_tapbranch_),
+      script_tree_(std::move(object.script_tree_)),
+      child_script_(std::move(object.child_script_)),
+      keys_(std::move(object.keys_)),
+      addr_prefixes_(std::move(object.addr_prefixes_)) {
+  // do nothing
+}
+
+DescriptorScriptReference& DescriptorScriptReference::operator=(
+    DescriptorScriptReference&& object) noexcept {
+  if (this != &object) {
+    locking_script_ = std::move(object.locking_script_);
+    script_type_ = object.script_type_;
+    address_script_ = std::move(object.address_script_);
+    is_script_ = object.is_script_;
+    redeem_script_ = std::move(object.redeem_script_);
+    child_script_ = std::move(object.child_script_);
+    keys_ = std::move(object.keys_);
+    req_num_ = object.req_num_;
+    tapbranch_ = std::move(object.tapbranch_);
+    is_tapbranch_ = object.is_tapbranch_;
+    script_tree_ = std::move(object.script_tree_);
+    addr_prefixes_ = std::move(object.addr_prefixes_);
+  }
+  return *this;
+}
+
+const Script& DescriptorScriptReference::GetLockingScript() const& {
+  return locking_script_;
+}
+
+Script DescriptorScriptReference::GetLockingScript() const&& {
   return locking_script_;
 }
 
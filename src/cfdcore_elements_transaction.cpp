@@ -12,6 +12,7 @@
 #include <limits>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -1264,14 +1265,7 @@ ConfidentialTransaction::ConfidentialTransaction()
 ConfidentialTransaction::ConfidentialTransaction(
     int32_t version, uint32_t lock_time)
     : vin_(), vout_() {
-  struct wally_tx *tx_pointer = NULL;
-  int ret = wally_tx_init_alloc(version, lock_time, 0, 0, &tx_pointer);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_init_alloc NG[{}] ", ret);
-    throw CfdException(
-        kCfdIllegalArgumentError, "transaction data generate error.");
-  }
-  wally_tx_pointer_ = tx_pointer;
+  wally_tx_pointer_ = AllocateWallyAddress(version, lock_time);
 }
 
 ConfidentialTransaction::ConfidentialTransaction(const std::string &hex_string)
@@ -1280,15 +1274,45 @@ ConfidentialTransaction::ConfidentialTransaction(const std::string &hex_string)
 }
 
 ConfidentialTransaction::ConfidentialTransaction(const ByteData &byte_data)
-    : ConfidentialTransaction(byte_data.GetHex()) {}
+    : vin_(), vout_() {
+  SetFromBytes(byte_data.data(), byte_data.size());
+}
+
+ConfidentialTransaction::ConfidentialTransaction(
+    const ByteDataView &byte_data)
+    : vin_(), vout_() {
+  SetFromBytes(byte_data.data(), byte_data.size());
+}
 
 ConfidentialTransaction::ConfidentialTransaction(
     const ConfidentialTransaction &transaction)
-    : ConfidentialTransaction(transaction.GetHex()) {
-  // copy constructor
+    : vin_(transaction.vin_), vout_(transaction.vout_) {
+  wally_tx_pointer_ = CloneWallyAddress(transaction.wally_tx_pointer_);
+}
+
+ConfidentialTransaction::ConfidentialTransaction(
+    ConfidentialTransaction &&transaction) noexcept
+    : vin_(std::move(transaction.vin_)), vout_(std::move(transaction.vout_)) {
+  // the source keeps no libwally tx. see PrepareWallyTxAddress.
+  wally_tx_pointer_ = transaction.wally_tx_pointer_;
+  transaction.wally_tx_pointer_ = nullptr;
+  transaction.vin_.clear();
+  transaction.vout_.clear();
 }
 
 void ConfidentialTransaction::SetFromHex(const std::string &hex_string) {
+  std::vector<uint8_t> tx_buf;
+  try {
+    tx_buf = StringUtil::StringToByte(hex_string);
+  } catch (const CfdException &except) {
+    warn(CFD_LOG_SOURCE, "hex decode NG. ({})", std::string(except.what()));
+    throw CfdException(kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  SetFromBytes(tx_buf.data(), tx_buf.size());
+}
+
+void ConfidentialTransaction::SetFromBytes(
+    const uint8_t *buffer, size_t buffer_size) {
   void *original_address = wally_tx_pointer_;
   std::vector<ConfidentialTxIn> vin_work;
   std::vector<ConfidentialTxOut> vout_work;
@@ -1297,9 +1321,9 @@ void ConfidentialTransaction::SetFromHex(const std::string &hex_string) {
   // (If it is not created, it will cause inconsistency)
   struct wally_tx *tx_pointer = NULL;
   uint32_t flag = WALLY_TX_FLAG_USE_ELEMENTS;
-  int ret = wally_tx_from_hex(hex_string.c_str(), flag, &tx_pointer);
+  int ret = wally_tx_from_bytes(buffer, buffer_size, flag, &tx_pointer);
   if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_from_hex NG[{}] ", ret);
+    warn(CFD_LOG_SOURCE, "wally_tx_from_bytes NG[{}] ", ret);
     throw CfdException(kCfdIllegalArgumentError, "transaction data invalid.");
   }
   wally_tx_pointer_ = tx_pointer;
@@ -1411,7 +1435,28 @@ void ConfidentialTransaction::SetFromHex(const std::string &hex_string) {
 ConfidentialTransaction &ConfidentialTransaction::operator=(
     const ConfidentialTransaction &transaction) & {
   if (this != &transaction) {
-    SetFromHex(transaction.GetHex());
+    std::vector<ConfidentialTxIn> vin_work = transaction.vin_;
+    std::vector<ConfidentialTxOut> vout_work = transaction.vout_;
+    void *tx_pointer = CloneWallyAddress(transaction.wally_tx_pointer_);
+    FreeWallyAddress(wally_tx_pointer_);
+    wally_tx_pointer_ = tx_pointer;
+    vin_.swap(vin_work);
+    vout_.swap(vout_work);
+  }
+  return *this;
+}
+
+ConfidentialTransaction &ConfidentialTransaction::operator=(
+    ConfidentialTransaction &&transaction) & noexcept {
+  if (this != &transaction) {
+    // the source keeps no libwally tx. see PrepareWallyTxAddress.
+    FreeWallyAddress(wally_tx_pointer_);
+    wally_tx_pointer_ = transaction.wally_tx_pointer_;
+    transaction.wally_tx_pointer_ = nullptr;
+    vin_ = std::move(transaction.vin_);
+    vout_ = std::move(transaction.vout_);
+    transaction.vin_.clear();
+    transaction.vout_.clear();
   }
   return *this;
 }
@@ -1468,11 +1513,9 @@ uint32_t ConfidentialTransaction::GetTxInIndex(
 
 uint32_t ConfidentialTransaction::GetTxOutIndex(
     const Script &locking_script) const {
-  std::string search_str = locking_script.GetHex();
   uint32_t index = 0;
   for (; index < static_cast<uint32_t>(vout_.size()); ++index) {
-    std::string script = vout_[index].GetLockingScript().GetHex();
-    if (script == search_str) {
+    if (vout_[index].GetLockingScript() == locking_script) {
       return index;
     }
   }
@@ -1483,10 +1526,9 @@ uint32_t ConfidentialTransaction::GetTxOutIndex(
 std::vector<uint32_t> ConfidentialTransaction::GetTxOutIndexList(
     const Script &locking_script) const {
   std::vector<uint32_t> result;
-  std::string search_str = locking_script.GetHex();
   uint32_t index = 0;
   for (; index < static_cast<uint32_t>(vout_.size()); ++index) {
-    if (search_str == vout_[index].GetLockingScript().GetHex()) {
+    if (vout_[index].GetLockingScript() == locking_script) {
       result.push_back(index);
     }
   }
@@ -1520,7 +1562,7 @@ uint32_t ConfidentialTransaction::AddTxIn(
   }
 
   struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
+      static_cast<struct wally_tx *>(PrepareWallyTxAddress());
   const std::vector<uint8_t> &txid_buf = txid.GetData().GetBytes();
   std::vector<uint8_t> empty_data;
   const std::vector<uint8_t> &script_data =
@@ -2203,9 +2245,9 @@ uint32_t ConfidentialTransaction::AddTxOut(
   const std::vector<uint8_t> &range_data = range_proof.GetBytes();
 
   int ret = wally_tx_add_elements_raw_output(
-      static_cast<struct wally_tx *>(wally_tx_pointer_), script_data.data(),
-      script_data.size(), asset_data.data(), asset_data.size(),
-      value_data.data(), value_data.size(),
+      static_cast<struct wally_tx *>(PrepareWallyTxAddress()),
+      script_data.data(), script_data.size(), asset_data.data(),
+      asset_data.size(), value_data.data(), value_data.size(),
       (nonce_data.size() == 0) ? nullptr : nonce_data.data(),
       nonce_data.size(),
       (surjection_data.size() == 0) ? nullptr : surjection_data.data(),
@@ -2244,7 +2286,7 @@ uint32_t ConfidentialTransaction::AddTxOutFee(
       confidential_value.GetData().GetBytes();
 
   int ret = wally_tx_add_elements_raw_output(
-      static_cast<struct wally_tx *>(wally_tx_pointer_), nullptr, 0,
+      static_cast<struct wally_tx *>(PrepareWallyTxAddress()), nullptr, 0,
       asset_data.data(), asset_data.size(), value_data.data(),
       value_data.size(), nullptr, 0, nullptr, 0, nullptr, 0, 0);
   if (ret != WALLY_OK) {
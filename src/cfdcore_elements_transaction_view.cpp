@@ -0,0 +1,461 @@
+// Copyright 2020 CryptoGarage
+/**
+ * @file cfdcore_elements_transaction_view.cpp
+ *
+ * @brief Classes related to confidential transaction view.
+ */
+#ifndef CFD_DISABLE_ELEMENTS
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_elements_transaction.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+#include "cfdcore/cfdcore_util.h"
+#include "cfdcore_transaction_internal.h"  // NOLINT
+
+namespace cfd {
+namespace core {
+
+using logger::warn;
+
+// -----------------------------------------------------------------------------
+// File constants
+// -----------------------------------------------------------------------------
+/// txid size
+static constexpr uint32_t kTxidSize = 32;
+/// coinbase vout
+static constexpr uint32_t kCoinBaseVout = 0xffffffff;
+/// outpoint issuance flag
+static constexpr uint32_t kOutPointIssuanceFlag = 0x80000000;
+/// outpoint pegin flag
+static constexpr uint32_t kOutPointPeginFlag = 0x40000000;
+/// outpoint index mask
+static constexpr uint32_t kOutPointIndexMask = 0x3fffffff;
+/// confidential commitment size
+static constexpr uint32_t kCommitmentSize = 33;
+/// explicit value size (prefix + amount)
+static constexpr uint32_t kExplicitValueSize = 9;
+
+/**
+ * @brief Kind of the confidential field.
+ */
+enum ConfidentialFieldType {
+  kConfidentialFieldAsset,  //!< asset
+  kConfidentialFieldValue,  //!< value
+  kConfidentialFieldNonce,  //!< nonce
+};
+
+// -----------------------------------------------------------------------------
+// Internal file functions
+// -----------------------------------------------------------------------------
+/**
+ * @brief Read a confidential field (prefix + data) without copying it.
+ * @param[in,out] dec     deserializer positioned at the field prefix.
+ * @param[in] type        field type.
+ * @return field view (prefix included)
+ */
+static ByteDataView ReadConfidentialField(
+    Deserializer* dec, ConfidentialFieldType type) {
+  ByteDataView prefix = dec->ReadView(1);
+  uint8_t version = prefix.data()[0];
+  uint32_t size = 0;
+  if (version == 0) {
+    size = 1;
+  } else if (version == 1) {
+    size = (type == kConfidentialFieldValue) ? kExplicitValueSize
+                                             : kCommitmentSize;
+  } else if (
+      ((type == kConfidentialFieldAsset) && ((version & 0xfe) == 0x0a)) ||
+      ((type == kConfidentialFieldValue) && ((version & 0xfe) == 0x08)) ||
+      ((type == kConfidentialFieldNonce) && ((version & 0xfe) == 0x02))) {
+    size = kCommitmentSize;
+  } else {
+    warn(CFD_LOG_SOURCE, "Invalid confidential prefix. [{}]", version);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  if (size > 1) dec->SkipBytes(size - 1);
+  return ByteDataView(prefix.data(), size);
+}
+
+/**
+ * @brief Convert the confidential field view to byte data.
+ * @param[in] field     field view
+ * @return byte data (empty if the field is null)
+ */
+static ByteData ConvertConfidentialField(const ByteDataView& field) {
+  if (field.size() <= 1) return ByteData();
+  return ByteData(field.data(), static_cast<uint32_t>(field.size()));
+}
+
+// -----------------------------------------------------------------------------
+// ConfidentialTxInView
+// -----------------------------------------------------------------------------
+ConfidentialTxInView::ConfidentialTxInView()
+    : outpoint_(nullptr),
+      vout_(0),
+      unlocking_script_(),
+      sequence_(0),
+      blinding_nonce_(),
+      asset_entropy_(),
+      issuance_amount_(),
+      inflation_keys_(),
+      issuance_amount_rangeproof_(),
+      inflation_keys_rangeproof_(),
+      witness_(),
+      witness_num_(0),
+      pegin_witness_(),
+      pegin_witness_num_(0) {
+  // do nothing
+}
+
+ByteDataView ConfidentialTxInView::GetTxidView() const {
+  return ByteDataView(outpoint_, kTxidSize);
+}
+
+Txid ConfidentialTxInView::GetTxid() const {
+  return Txid(ByteData256(outpoint_, kTxidSize));
+}
+
+uint32_t ConfidentialTxInView::GetVout() const {
+  if (vout_ == kCoinBaseVout) return vout_;
+  return vout_ & kOutPointIndexMask;
+}
+
+OutPoint ConfidentialTxInView::GetOutPoint() const {
+  return OutPoint(GetTxid(), GetVout());
+}
+
+ByteDataView ConfidentialTxInView::GetUnlockingScriptView() const {
+  return unlocking_script_;
+}
+
+uint32_t ConfidentialTxInView::GetSequence() const { return sequence_; }
+
+bool ConfidentialTxInView::IsCoinBase() const {
+  if (vout_ != kCoinBaseVout) return false;
+  for (uint32_t index = 0; index < kTxidSize; ++index) {
+    if (outpoint_[index] != 0) return false;
+  }
+  return true;
+}
+
+bool ConfidentialTxInView::IsPegin() const {
+  return (vout_ != kCoinBaseVout) && ((vout_ & kOutPointPeginFlag) != 0);
+}
+
+bool ConfidentialTxInView::HasIssuance() const {
+  return (vout_ != kCoinBaseVout) && ((vout_ & kOutPointIssuanceFlag) != 0);
+}
+
+ByteDataView ConfidentialTxInView::GetBlindingNonceView() const {
+  return blinding_nonce_;
+}
+
+ByteDataView ConfidentialTxInView::GetAssetEntropyView() const {
+  return asset_entropy_;
+}
+
+ByteDataView ConfidentialTxInView::GetIssuanceAmountView() const {
+  return issuance_amount_;
+}
+
+ConfidentialValue ConfidentialTxInView::GetIssuanceAmount() const {
+  return ConfidentialValue(ConvertConfidentialField(issuance_amount_));
+}
+
+ByteDataView ConfidentialTxInView::GetInflationKeysView() const {
+  return inflation_keys_;
+}
+
+ConfidentialValue ConfidentialTxInView::GetInflationKeys() const {
+  return ConfidentialValue(ConvertConfidentialField(inflation_keys_));
+}
+
+ByteDataView ConfidentialTxInView::GetIssuanceAmountRangeproofView() const {
+  return issuance_amount_rangeproof_;
+}
+
+ByteDataView ConfidentialTxInView::GetInflationKeysRangeproofView() const {
+  return inflation_keys_rangeproof_;
+}
+
+uint32_t ConfidentialTxInView::GetScriptWitnessStackNum() const {
+  return witness_num_;
+}
+
+ByteDataView ConfidentialTxInView::GetScriptWitnessStack(
+    uint32_t index) const {
+  return ReadWitnessStackItem(witness_, index);
+}
+
+uint32_t ConfidentialTxInView::GetPeginWitnessStackNum() const {
+  return pegin_witness_num_;
+}
+
+ByteDataView ConfidentialTxInView::GetPeginWitnessStack(uint32_t index) const {
+  return ReadWitnessStackItem(pegin_witness_, index);
+}
+
+// -----------------------------------------------------------------------------
+// ConfidentialTxOutView
+// -----------------------------------------------------------------------------
+ConfidentialTxOutView::ConfidentialTxOutView()
+    : asset_(),
+      value_(),
+      nonce_(),
+      locking_script_(),
+      surjection_proof_(),
+      range_proof_() {
+  // do nothing
+}
+
+ByteDataView ConfidentialTxOutView::GetAssetView() const { return asset_; }
+
+ConfidentialAssetId ConfidentialTxOutView::GetAsset() const {
+  if (asset_.size() <= 1) return ConfidentialAssetId();
+  return ConfidentialAssetId(ConvertConfidentialField(asset_));
+}
+
+ByteDataView ConfidentialTxOutView::GetConfidentialValueView() const {
+  return value_;
+}
+
+ConfidentialValue ConfidentialTxOutView::GetConfidentialValue() const {
+  return ConfidentialValue(ConvertConfidentialField(value_));
+}
+
+ByteDataView ConfidentialTxOutView::GetNonceView() const { return nonce_; }
+
+ConfidentialNonce ConfidentialTxOutView::GetNonce() const {
+  return ConfidentialNonce(ConvertConfidentialField(nonce_));
+}
+
+ByteDataView ConfidentialTxOutView::GetLockingScriptView() const {
+  return locking_script_;
+}
+
+Script ConfidentialTxOutView::GetLockingScript() const {
+  return Script(ByteData(
+      locking_script_.data(), static_cast<uint32_t>(locking_script_.size())));
+}
+
+ByteDataView ConfidentialTxOutView::GetSurjectionProofView() const {
+  return surjection_proof_;
+}
+
+ByteDataView ConfidentialTxOutView::GetRangeProofView() const {
+  return range_proof_;
+}
+
+// -----------------------------------------------------------------------------
+// ConfidentialTransactionView
+// -----------------------------------------------------------------------------
+ConfidentialTransactionView::ConfidentialTransactionView()
+    : buffer_(nullptr),
+      size_(0),
+      version_(0),
+      lock_time_(0),
+      witness_offset_(0),
+      vin_(),
+      vout_() {
+  // do nothing
+}
+
+ConfidentialTransactionView::ConfidentialTransactionView(
+    const uint8_t* buffer, size_t size)
+    : ConfidentialTransactionView() {
+  if ((buffer == nullptr) || (size == 0) ||
+      (size > std::numeric_limits<uint32_t>::max())) {
+    warn(CFD_LOG_SOURCE, "Invalid transaction buffer.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  try {
+    Deserializer dec(ByteDataView(buffer, size));
+    std::vector<ConfidentialTxInView> vin;
+    std::vector<ConfidentialTxOutView> vout;
+    int32_t version = static_cast<int32_t>(dec.ReadUint32());
+    uint8_t flag = dec.ReadUint8();
+    if (flag > 1) {
+      warn(CFD_LOG_SOURCE, "Invalid witness flag. [{}]", flag);
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+
+    uint64_t txin_count = dec.ReadVariableInt();
+    // each txin needs at least outpoint + script size + sequence.
+    if (txin_count > (size / (kTxidSize + 4 + 1 + 4))) {
+      warn(CFD_LOG_SOURCE, "txin count too large.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+    vin.resize(static_cast<size_t>(txin_count));
+    for (auto& txin : vin) {
+      txin.outpoint_ = dec.ReadView(kTxidSize).data();
+      txin.vout_ = dec.ReadUint32();
+      txin.unlocking_script_ = dec.ReadVariableView();
+      txin.sequence_ = dec.ReadUint32();
+      if (txin.HasIssuance()) {
+        txin.blinding_nonce_ = dec.ReadView(kTxidSize);
+        txin.asset_entropy_ = dec.ReadView(kTxidSize);
+        txin.issuance_amount_ =
+            ReadConfidentialField(&dec, kConfidentialFieldValue);
+        txin.inflation_keys_ =
+            ReadConfidentialField(&dec, kConfidentialFieldValue);
+      }
+    }
+
+    uint64_t txout_count = dec.ReadVariableInt();
+    // each txout needs at least asset + value + nonce + script size.
+    if (txout_count > (size / 4)) {
+      warn(CFD_LOG_SOURCE, "txout count too large.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+    vout.resize(static_cast<size_t>(txout_count));
+    for (auto& txout : vout) {
+      txout.asset_ = ReadConfidentialField(&dec, kConfidentialFieldAsset);
+      txout.value_ = ReadConfidentialField(&dec, kConfidentialFieldValue);
+      txout.nonce_ = ReadConfidentialField(&dec, kConfidentialFieldNonce);
+      txout.locking_script_ = dec.ReadVariableView();
+    }
+    uint32_t lock_time = dec.ReadUint32();
+
+    uint32_t witness_offset = 0;
+    if (flag != 0) {
+      witness_offset = dec.GetReadSize();
+      for (auto& txin : vin) {
+        txin.issuance_amount_rangeproof_ = dec.ReadVariableView();
+        txin.inflation_keys_rangeproof_ = dec.ReadVariableView();
+        txin.witness_ =
+            ReadWitnessStackArea(&dec, buffer, &txin.witness_num_);
+        txin.pegin_witness_ =
+            ReadWitnessStackArea(&dec, buffer, &txin.pegin_witness_num_);
+      }
+      for (auto& txout : vout) {
+        txout.surjection_proof_ = dec.ReadVariableView();
+        txout.range_proof_ = dec.ReadVariableView();
+      }
+    }
+    if (dec.GetReadSize() != size) {
+      warn(CFD_LOG_SOURCE, "transaction has unread data.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+
+    buffer_ = buffer;
+    size_ = static_cast<uint32_t>(size);
+    version_ = version;
+    lock_time_ = lock_time;
+    witness_offset_ = witness_offset;
+    vin_.swap(vin);
+    vout_.swap(vout);
+  } catch (const CfdException& except) {
+    warn(CFD_LOG_SOURCE, "Failed to parse transaction. {}", except.what());
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+}
+
+ConfidentialTransactionView::ConfidentialTransactionView(
+    const ByteDataView& buffer)
+    : ConfidentialTransactionView(buffer.data(), buffer.size()) {
+  // do nothing
+}
+
+bool ConfidentialTransactionView::IsValid() const {
+  return buffer_ != nullptr;
+}
+
+int32_t ConfidentialTransactionView::GetVersion() const { return version_; }
+
+uint32_t ConfidentialTransactionView::GetLockTime() const {
+  return lock_time_;
+}
+
+uint32_t ConfidentialTransactionView::GetTxInCount() const {
+  return static_cast<uint32_t>(vin_.size());
+}
+
+const ConfidentialTxInView& ConfidentialTransactionView::GetTxIn(
+    uint32_t index) const {
+  if (index >= vin_.size()) {
+    warn(CFD_LOG_SOURCE, "vin[{}] out_of_range.", index);
+    throw CfdException(kCfdOutOfRangeError, "vin out_of_range error.");
+  }
+  return vin_[index];
+}
+
+const std::vector<ConfidentialTxInView>&
+ConfidentialTransactionView::GetTxInList() const {
+  return vin_;
+}
+
+uint32_t ConfidentialTransactionView::GetTxOutCount() const {
+  return static_cast<uint32_t>(vout_.size());
+}
+
+const ConfidentialTxOutView& ConfidentialTransactionView::GetTxOut(
+    uint32_t index) const {
+  if (index >= vout_.size()) {
+    warn(CFD_LOG_SOURCE, "vout[{}] out_of_range.", index);
+    throw CfdException(kCfdOutOfRangeError, "vout out_of_range error.");
+  }
+  return vout_[index];
+}
+
+const std::vector<ConfidentialTxOutView>&
+ConfidentialTransactionView::GetTxOutList() const {
+  return vout_;
+}
+
+bool ConfidentialTransactionView::HasWitness() const {
+  return witness_offset_ != 0;
+}
+
+ByteDataView ConfidentialTransactionView::GetData() const {
+  return ByteDataView(buffer_, size_);
+}
+
+uint32_t ConfidentialTransactionView::GetTotalSize() const { return size_; }
+
+uint32_t ConfidentialTransactionView::GetVsize() const {
+  if (witness_offset_ == 0) return size_;
+  return AbstractTransaction::GetVsizeFromSize(
+      witness_offset_, size_ - witness_offset_);
+}
+
+uint32_t ConfidentialTransactionView::GetWeight() const {
+  if (witness_offset_ == 0) return size_ * 4;
+  return (witness_offset_ * 4) + (size_ - witness_offset_);
+}
+
+Txid ConfidentialTransactionView::GetTxid() const {
+  if (witness_offset_ == 0) return Txid(GetWitnessHash());
+  // the txid serialization has the flag cleared and no witness area.
+  static constexpr uint32_t kFlagOffset = 4;
+  Serializer obj(witness_offset_);
+  obj.AddDirectBytes(buffer_, kFlagOffset);
+  obj.AddDirectBytes(ByteData(static_cast<uint8_t>(0)));
+  obj.AddDirectBytes(
+      buffer_ + kFlagOffset + 1, witness_offset_ - kFlagOffset - 1);
+  return Txid(HashUtil::Sha256D(obj.Output()));
+}
+
+ByteData256 ConfidentialTransactionView::GetWitnessHash() const {
+  return HashUtil::Sha256D(GetData());
+}
+
+ConfidentialTransaction ConfidentialTransactionView::GetTransaction() const {
+  return ConfidentialTransaction(GetData());
+}
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_DISABLE_ELEMENTS
@@ -0,0 +1,657 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_encoding.cpp
+ *
+ * @brief This file implements the Base58 and Base64 codecs of CryptoUtil.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+#include "cfdcore/cfdcore_util.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define CFDCORE_BASE64_X86
+#include <immintrin.h>
+//! target attribute of the ssse3 functions
+#define CFDCORE_SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+
+namespace cfd {
+namespace core {
+
+using logger::warn;
+
+// ----------------------------------------------------------------------------
+// Base58
+// ----------------------------------------------------------------------------
+/// Base58 characters
+static constexpr char kBase58Characters[] =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+/// Base58 digit count per encode limb
+static constexpr size_t kBase58LimbDigits = 5;
+/// encode limb base (58^5)
+static constexpr uint64_t kBase58LimbBase = 656356768;
+/// Base58Check checksum size
+static constexpr size_t kBase58ChecksumSize = 4;
+/// limb count kept on the stack
+static constexpr size_t kLocalLimbCount = 64;
+
+/**
+ * @brief Limb buffer with a small on-stack storage.
+ */
+class LimbBuffer {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] capacity  maximum limb count
+   */
+  explicit LimbBuffer(size_t capacity) : heap_(), limbs_(local_) {
+    if (capacity > kLocalLimbCount) {
+      heap_.resize(capacity);
+      limbs_ = heap_.data();
+    }
+  }
+  /**
+   * @brief Get the limb array.
+   * @return limb array
+   */
+  uint32_t *data() { return limbs_; }
+
+ private:
+  LimbBuffer(const LimbBuffer &);             //!< non-copyable
+  LimbBuffer &operator=(const LimbBuffer &);  //!< non-copyable
+
+  uint32_t local_[kLocalLimbCount];  //!< on-stack storage
+  std::vector<uint32_t> heap_;       //!< heap storage
+  uint32_t *limbs_;                  //!< active storage
+};
+
+/**
+ * @brief Get the Base58 digit value table.
+ * @return table (-1: invalid character)
+ */
+static const int8_t *GetBase58DigitTable() {
+  static const struct Table {
+    int8_t values[256];
+    Table() {
+      memset(values, -1, sizeof(values));
+      for (int8_t index = 0; index < 58; ++index) {
+        values[static_cast<uint8_t>(kBase58Characters[index])] = index;
+      }
+    }
+  } table;
+  return table.values;
+}
+
+/**
+ * @brief Encode the bytes (and the suffix) to Base58.
+ * @details The value is converted with base 58^5 limbs, 4 bytes at a time.
+ * @param[in] data          byte buffer
+ * @param[in] size          byte size
+ * @param[in] suffix        suffix byte buffer (checksum)
+ * @param[in] suffix_size   suffix byte size
+ * @param[out] output       appended Base58 string
+ */
+static void EncodeBase58Raw(
+    const uint8_t *data, size_t size, const uint8_t *suffix,
+    size_t suffix_size, std::string *output) {
+  const size_t total = size + suffix_size;
+  auto get_byte = [data, size, suffix](size_t index) -> uint8_t {
+    return (index < size) ? data[index] : suffix[index - size];
+  };
+
+  size_t zeros = 0;
+  while ((zeros < total) && (get_byte(zeros) == 0)) ++zeros;
+  // log(256) / log(58^5) is about 0.27313.
+  LimbBuffer buffer(((total - zeros) * 2732) / 10000 + 2);
+  uint32_t *limbs = buffer.data();
+  size_t used = 0;
+
+  size_t offset = zeros;
+  size_t chunk = (total - zeros) % 4;
+  if (chunk == 0) chunk = 4;
+  while (offset < total) {
+    uint64_t carry = 0;
+    for (size_t index = 0; index < chunk; ++index) {
+      carry = (carry << 8) | get_byte(offset + index);
+    }
+    const uint64_t multiplier = static_cast<uint64_t>(1) << (chunk * 8);
+    for (size_t index = 0; index < used; ++index) {
+      uint64_t value = (limbs[index] * multiplier) + carry;
+      limbs[index] = static_cast<uint32_t>(value % kBase58LimbBase);
+      carry = value / kBase58LimbBase;
+    }
+    while (carry != 0) {
+      limbs[used++] = static_cast<uint32_t>(carry % kBase58LimbBase);
+      carry /= kBase58LimbBase;
+    }
+    offset += chunk;
+    chunk = 4;
+  }
+
+  char top_digits[kBase58LimbDigits];
+  size_t top_count = 0;
+  if (used != 0) {
+    for (uint32_t top = limbs[used - 1]; top != 0; top /= 58) {
+      top_digits[top_count++] = kBase58Characters[top % 58];
+    }
+  }
+  const size_t start = output->size();
+  output->resize(
+      start + zeros + top_count +
+      ((used == 0) ? 0 : (used - 1) * kBase58LimbDigits));
+  char *dest = &(*output)[start];
+  memset(dest, '1', zeros);
+  dest += zeros;
+  while (top_count != 0) *dest++ = top_digits[--top_count];
+  for (size_t index = (used == 0) ? 0 : used - 1; index != 0; --index) {
+    uint32_t limb = limbs[index - 1];
+    for (size_t digit = kBase58LimbDigits; digit != 0; --digit) {
+      dest[digit - 1] = kBase58Characters[limb % 58];
+      limb /= 58;
+    }
+    dest += kBase58LimbDigits;
+  }
+}
+
+/**
+ * @brief Decode the Base58 string.
+ * @details The value is converted with 32bit limbs, 5 digits at a time.
+ * @param[in] str       Base58 string
+ * @param[in] size      string size
+ * @param[out] output   appended bytes
+ * @retval true   success
+ * @retval false  invalid character
+ */
+static bool DecodeBase58Raw(
+    const char *str, size_t size, std::vector<uint8_t> *output) {
+  static constexpr uint32_t kPowers[] = {1, 58, 3364, 195112, 11316496,
+                                         656356768};
+  const int8_t *table = GetBase58DigitTable();
+  size_t ones = 0;
+  while ((ones < size) && (str[ones] == '1')) ++ones;
+  // log(58) / log(2^32) is about 0.1831.
+  LimbBuffer buffer(((size - ones) * 1831) / 10000 + 2);
+  uint32_t *limbs = buffer.data();
+  size_t used = 0;
+
+  size_t offset = ones;
+  size_t chunk = (size - ones) % kBase58LimbDigits;
+  if (chunk == 0) chunk = kBase58LimbDigits;
+  while (offset < size) {
+    uint64_t carry = 0;
+    for (size_t index = 0; index < chunk; ++index) {
+      int8_t digit = table[static_cast<uint8_t>(str[offset + index])];
+      if (digit < 0) return false;
+      carry = (carry * 58) + static_cast<uint64_t>(digit);
+    }
+    const uint64_t multiplier = kPowers[chunk];
+    for (size_t index = 0; index < used; ++index) {
+      uint64_t value = (limbs[index] * multiplier) + carry;
+      limbs[index] = static_cast<uint32_t>(value);
+      carry = value >> 32;
+    }
+    while (carry != 0) {
+      limbs[used++] = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+    offset += chunk;
+    chunk = kBase58LimbDigits;
+  }
+
+  size_t top_bytes = 0;
+  if (used != 0) {
+    for (uint32_t top = limbs[used - 1]; top != 0; top >>= 8) ++top_bytes;
+  }
+  const size_t start = output->size();
+  output->resize(
+      start + ones + top_bytes + ((used == 0) ? 0 : (used - 1) * 4));
+  uint8_t *dest = output->data() + start + ones;  // leading zero bytes are 0.
+  for (size_t index = used; index != 0; --index) {
+    const uint32_t limb = limbs[index - 1];
+    size_t count = (index == used) ? top_bytes : 4;
+    while (count != 0) {
+      --count;
+      *dest++ = static_cast<uint8_t>(limb >> (count * 8));
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Calculate the Base58Check checksum.
+ * @param[in] data      byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   checksum (Sha256D digest)
+ */
+static void CalculateBase58Checksum(
+    const uint8_t *data, size_t size, uint8_t *output) {
+  uint8_t hash[Sha256Hasher::kOutputSize];
+  Sha256Hasher().Write(data, size).Finalize(hash);
+  Sha256Hasher().Write(hash, sizeof(hash)).Finalize(output);
+}
+
+/**
+ * @brief Verify the checksum and drop it from the decoded bytes.
+ * @param[in] start       start offset of the decoded bytes
+ * @param[in,out] output  decoded bytes
+ * @retval true   valid checksum
+ * @retval false  invalid checksum
+ */
+static bool VerifyBase58Checksum(size_t start, std::vector<uint8_t> *output) {
+  if (output->size() - start < kBase58ChecksumSize) return false;
+  const size_t size = output->size() - start - kBase58ChecksumSize;
+  uint8_t hash[Sha256Hasher::kOutputSize];
+  CalculateBase58Checksum(output->data() + start, size, hash);
+  if (memcmp(hash, output->data() + start + size, kBase58ChecksumSize) != 0) {
+    return false;
+  }
+  output->resize(start + size);
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// Base64
+// ----------------------------------------------------------------------------
+/// Base64 characters
+static constexpr char kBase64Characters[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+ * @brief Get the Base64 value table.
+ * @return table (-1: invalid character)
+ */
+static const int8_t *GetBase64ValueTable() {
+  static const struct Table {
+    int8_t values[256];
+    Table() {
+      memset(values, -1, sizeof(values));
+      for (int8_t index = 0; index < 64; ++index) {
+        values[static_cast<uint8_t>(kBase64Characters[index])] = index;
+      }
+    }
+  } table;
+  return table.values;
+}
+
+#ifdef CFDCORE_BASE64_X86
+/**
+ * @brief Check the ssse3 support of the running cpu.
+ * @retval true   supported
+ * @retval false  unsupported
+ */
+static bool IsSupportedBase64Ssse3() {
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+  }();
+  return supported;
+}
+
+/**
+ * @brief Encode 12 bytes to 16 characters per loop. (ssse3)
+ * @details Each loop reads 16 bytes.
+ * @param[in] data      byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   character buffer
+ * @return processed byte size (multiple of 3)
+ */
+CFDCORE_SSSE3_TARGET static size_t EncodeBase64Ssse3(
+    const uint8_t *data, size_t size, char *output) {
+  const __m128i shuffle =
+      _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m128i shift_lut = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  size_t offset = 0;
+  size_t out_offset = 0;
+  for (; offset + 16 <= size; offset += 12, out_offset += 16) {
+    __m128i input = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset)),
+        shuffle);
+    // split each 24bit group into four 6bit indexes.
+    const __m128i first = _mm_mulhi_epu16(
+        _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)),
+        _mm_set1_epi32(0x04000040));
+    const __m128i second = _mm_mullo_epi16(
+        _mm_and_si128(input, _mm_set1_epi32(0x003f03f0)),
+        _mm_set1_epi32(0x01000010));
+    const __m128i indexes = _mm_or_si128(first, second);
+    // convert the indexes to the characters.
+    __m128i lookup = _mm_subs_epu8(indexes, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indexes);
+    lookup = _mm_or_si128(lookup, _mm_and_si128(less, _mm_set1_epi8(13)));
+    const __m128i result =
+        _mm_add_epi8(_mm_shuffle_epi8(shift_lut, lookup), indexes);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + out_offset), result);
+  }
+  return offset;
+}
+
+/**
+ * @brief Decode 16 characters to 12 bytes per loop. (ssse3)
+ * @details Each loop writes 16 bytes, so 24 characters must remain.
+ * @param[in] str       character buffer (without padding)
+ * @param[in] size      character count
+ * @param[out] output   byte buffer
+ * @return processed character count (stops before an invalid block)
+ */
+CFDCORE_SSSE3_TARGET static size_t DecodeBase64Ssse3(
+    const char *str, size_t size, uint8_t *output) {
+  const __m128i lut_lo = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+      0x1b, 0x1b, 0x1b, 0x1a);
+  const __m128i lut_hi = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll =
+      _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask_2f = _mm_set1_epi8(0x2f);
+  const __m128i pack =
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  size_t offset = 0;
+  size_t out_offset = 0;
+  for (; offset + 24 <= size; offset += 16, out_offset += 12) {
+    __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + offset));
+    const __m128i hi_nibbles =
+        _mm_and_si128(_mm_srli_epi32(input, 4), mask_2f);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(input, mask_2f));
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    const __m128i invalid =
+        _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+    if (_mm_movemask_epi8(invalid) != 0xffff) break;
+    const __m128i eq_2f = _mm_cmpeq_epi8(input, mask_2f);
+    const __m128i roll =
+        _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+    input = _mm_add_epi8(input, roll);
+    // merge four 6bit values into 24bit.
+    const __m128i merged = _mm_madd_epi16(
+        _mm_maddubs_epi16(input, _mm_set1_epi32(0x01400140)),
+        _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + out_offset),
+        _mm_shuffle_epi8(merged, pack));
+  }
+  return offset;
+}
+#endif  // CFDCORE_BASE64_X86
+
+/**
+ * @brief Get the Base64 encoded size.
+ * @param[in] size  byte size
+ * @return character count
+ */
+static inline size_t GetBase64EncodedSize(size_t size) {
+  return ((size + 2) / 3) * 4;
+}
+
+/**
+ * @brief Encode the bytes to Base64.
+ * @param[in] data      byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   character buffer (GetBase64EncodedSize(size))
+ */
+static void EncodeBase64Raw(const uint8_t *data, size_t size, char *output) {
+  size_t offset = 0;
+#ifdef CFDCORE_BASE64_X86
+  if (IsSupportedBase64Ssse3()) {
+    offset = EncodeBase64Ssse3(data, size, output);
+    output += (offset / 3) * 4;
+  }
+#endif  // CFDCORE_BASE64_X86
+  for (; offset + 3 <= size; offset += 3) {
+    const uint32_t value = (static_cast<uint32_t>(data[offset]) << 16) |
+                           (static_cast<uint32_t>(data[offset + 1]) << 8) |
+                           data[offset + 2];
+    *output++ = kBase64Characters[(value >> 18) & 0x3f];
+    *output++ = kBase64Characters[(value >> 12) & 0x3f];
+    *output++ = kBase64Characters[(value >> 6) & 0x3f];
+    *output++ = kBase64Characters[value & 0x3f];
+  }
+  if (offset < size) {
+    uint32_t value = static_cast<uint32_t>(data[offset]) << 16;
+    if (offset + 1 < size) {
+      value |= static_cast<uint32_t>(data[offset + 1]) << 8;
+    }
+    *output++ = kBase64Characters[(value >> 18) & 0x3f];
+    *output++ = kBase64Characters[(value >> 12) & 0x3f];
+    *output++ = (offset + 1 < size) ? kBase64Characters[(value >> 6) & 0x3f]
+                                    : '=';
+    *output++ = '=';
+  }
+}
+
+/**
+ * @brief Decode the Base64 string.
+ * @details Decoding ends at the first group that contains the padding.
+ * @param[in] str       Base64 string
+ * @param[in] size      string size
+ * @param[out] output   appended bytes
+ * @retval true   success
+ * @retval false  invalid string
+ */
+static bool DecodeBase64Raw(
+    const char *str, size_t size, std::vector<uint8_t> *output) {
+  if ((size % 4) != 0) return false;
+  const int8_t *table = GetBase64ValueTable();
+  const char *padding = static_cast<const char *>(memchr(str, '=', size));
+  const size_t body = (padding == nullptr) ? size : ((padding - str) / 4) * 4;
+
+  const size_t start = output->size();
+  output->resize(start + (body / 4) * 3 + 2);
+  uint8_t *dest = output->data() + start;
+  size_t offset = 0;
+#ifdef CFDCORE_BASE64_X86
+  if (IsSupportedBase64Ssse3()) {
+    offset = DecodeBase64Ssse3(str, body, dest);
+    dest += (offset / 4) * 3;
+  }
+#endif  // CFDCORE_BASE64_X86
+  for (; offset < body; offset += 4) {
+    const int8_t v1 = table[static_cast<uint8_t>(str[offset])];
+    const int8_t v2 = table[static_cast<uint8_t>(str[offset + 1])];
+    const int8_t v3 = table[static_cast<uint8_t>(str[offset + 2])];
+    const int8_t v4 = table[static_cast<uint8_t>(str[offset + 3])];
+    if ((v1 | v2 | v3 | v4) < 0) return false;
+    *dest++ = static_cast<uint8_t>((v1 << 2) | (v2 >> 4));
+    *dest++ = static_cast<uint8_t>(((v2 & 0x0f) << 4) | (v3 >> 2));
+    *dest++ = static_cast<uint8_t>(((v3 & 0x03) << 6) | v4);
+  }
+  if (body < size) {
+    const char *group = str + body;
+    if ((group[0] == '=') || (group[1] == '=')) return false;
+    const int8_t v1 = table[static_cast<uint8_t>(group[0])];
+    const int8_t v2 = table[static_cast<uint8_t>(group[1])];
+    if ((v1 | v2) < 0) return false;
+    *dest++ = static_cast<uint8_t>((v1 << 2) | ((v2 & 0x30) >> 4));
+    if (group[2] != '=') {
+      const int8_t v3 = table[static_cast<uint8_t>(group[2])];
+      if (v3 < 0) return false;
+      *dest++ = static_cast<uint8_t>(((v2 & 0x0f) << 4) | ((v3 & 0x3c) >> 2));
+    }
+  }
+  output->resize(static_cast<size_t>(dest - output->data()));
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// CryptoUtil
+// ----------------------------------------------------------------------------
+std::string CryptoUtil::EncodeBase64(const ByteData &data) {
+  std::string result(GetBase64EncodedSize(data.size()), '\0');
+  if (!result.empty()) EncodeBase64Raw(data.data(), data.size(), &result[0]);
+  return result;
+}
+
+ByteData CryptoUtil::DecodeBase64(const std::string &str) {
+  std::vector<uint8_t> output;
+  if (!DecodeBase64Raw(str.data(), str.size(), &output)) output.clear();
+  return ByteData(std::move(output));
+}
+
+ByteData CryptoUtil::DecodeBase58(const std::string &str) {
+  std::vector<uint8_t> output;
+  if (str.empty() || !DecodeBase58Raw(str.data(), str.size(), &output)) {
+    warn(CFD_LOG_SOURCE, "base58 decode error.");
+    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+  }
+  return ByteData(std::move(output));
+}
+
+ByteData CryptoUtil::DecodeBase58Check(const std::string &str) {
+  std::vector<uint8_t> output;
+  if (str.empty() || !DecodeBase58Raw(str.data(), str.size(), &output) ||
+      !VerifyBase58Checksum(0, &output)) {
+    warn(CFD_LOG_SOURCE, "base58check decode error.");
+    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+  }
+  return ByteData(std::move(output));
+}
+
+std::string CryptoUtil::EncodeBase58(const ByteData &data) {
+  if (data.IsEmpty()) {
+    warn(CFD_LOG_SOURCE, "base58 encode data is empty.");
+    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+  }
+  std::string result;
+  EncodeBase58Raw(data.data(), data.size(), nullptr, 0, &result);
+  return result;
+}
+
+std::string CryptoUtil::EncodeBase58Check(const ByteData &data) {
+  if (data.IsEmpty()) {
+    warn(CFD_LOG_SOURCE, "base58 encode data is empty.");
+    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+  }
+  uint8_t checksum[Sha256Hasher::kOutputSize];
+  CalculateBase58Checksum(data.data(), data.size(), checksum);
+  std::string result;
+  EncodeBase58Raw(
+      data.data(), data.size(), checksum, kBase58ChecksumSize, &result);
+  return result;
+}
+
+/**
+ * @brief Check the offset list of the batch api.
+ * @param[in] offsets   offset list
+ */
+static void CheckBatchOffsets(const std::vector<size_t> *offsets) {
+  if (offsets == nullptr) {
+    warn(CFD_LOG_SOURCE, "offsets is null.");
+    throw CfdException(kCfdIllegalArgumentError, "Invalid offsets.");
+  }
+}
+
+std::string CryptoUtil::EncodeBase58CheckBatch(
+    const std::vector<ByteDataView> &inputs, std::vector<size_t> *offsets) {
+  CheckBatchOffsets(offsets);
+  static constexpr size_t kHashSize = Sha256Hasher::kOutputSize;
+  size_t total = 0;
+  for (const auto &input : inputs) {
+    if (input.IsEmpty()) {
+      warn(CFD_LOG_SOURCE, "base58 encode data is empty.");
+      throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+    }
+    total += input.size();
+  }
+  // checksum: multi-buffer sha256 twice.
+  std::vector<uint8_t> hashes(inputs.size() * kHashSize);
+  Sha256Hasher::HashBatch(inputs.data(), inputs.size(), hashes.data());
+  std::vector<ByteDataView> first_hashes;
+  first_hashes.reserve(inputs.size());
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    first_hashes.emplace_back(hashes.data() + (index * kHashSize), kHashSize);
+  }
+  std::vector<uint8_t> checksums(hashes.size());
+  Sha256Hasher::HashBatch(
+      first_hashes.data(), first_hashes.size(), checksums.data());
+
+  std::string result;
+  // log(256) / log(58) is about 1.366.
+  const size_t checksum_total = inputs.size() * kBase58ChecksumSize;
+  result.reserve(((total + checksum_total) * 1366) / 1000);
+  offsets->clear();
+  offsets->reserve(inputs.size() + 1);
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    offsets->push_back(result.size());
+    EncodeBase58Raw(
+        inputs[index].data(), inputs[index].size(),
+        checksums.data() + (index * kHashSize), kBase58ChecksumSize, &result);
+  }
+  offsets->push_back(result.size());
+  return result;
+}
+
+std::vector<uint8_t> CryptoUtil::DecodeBase58CheckBatch(
+    const std::vector<std::string> &inputs, std::vector<size_t> *offsets) {
+  CheckBatchOffsets(offsets);
+  size_t total = 0;
+  for (const auto &input : inputs) total += input.size();
+  std::vector<uint8_t> result;
+  result.reserve((total * 733) / 1000 + 1);  // log(58) / log(256)
+  offsets->clear();
+  offsets->reserve(inputs.size() + 1);
+  for (const auto &input : inputs) {
+    const size_t start = result.size();
+    offsets->push_back(start);
+    if (input.empty() ||
+        !DecodeBase58Raw(input.data(), input.size(), &result) ||
+        !VerifyBase58Checksum(start, &result)) {
+      warn(CFD_LOG_SOURCE, "base58check decode error.");
+      throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+    }
+  }
+  offsets->push_back(result.size());
+  return result;
+}
+
+std::string CryptoUtil::EncodeBase64Batch(
+    const std::vector<ByteDataView> &inputs, std::vector<size_t> *offsets) {
+  CheckBatchOffsets(offsets);
+  offsets->clear();
+  offsets->reserve(inputs.size() + 1);
+  size_t total = 0;
+  for (const auto &input : inputs) {
+    offsets->push_back(total);
+    total += GetBase64EncodedSize(input.size());
+  }
+  offsets->push_back(total);
+  std::string result(total, '\0');
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    if (inputs[index].IsEmpty()) continue;
+    EncodeBase64Raw(
+        inputs[index].data(), inputs[index].size(), &result[(*offsets)[index]]);
+  }
+  return result;
+}
+
+std::vector<uint8_t> CryptoUtil::DecodeBase64Batch(
+    const std::vector<std::string> &inputs, std::vector<size_t> *offsets) {
+  CheckBatchOffsets(offsets);
+  size_t total = 0;
+  for (const auto &input : inputs) total += input.size();
+  std::vector<uint8_t> result;
+  result.reserve((total / 4) * 3 + 2);
+  offsets->clear();
+  offsets->reserve(inputs.size() + 1);
+  for (const auto &input : inputs) {
+    const size_t start = result.size();
+    offsets->push_back(start);
+    // an invalid string is decoded to empty data, same as DecodeBase64.
+    if (!DecodeBase64Raw(input.data(), input.size(), &result)) {
+      result.resize(start);
+    }
+  }
+  offsets->push_back(result.size());
+  return result;
+}
+
+}  // namespace core
+}  // namespace cfd
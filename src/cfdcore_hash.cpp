@@ -0,0 +1,1116 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_hash.cpp
+ *
+ * @brief This file implements the incremental hash classes.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_util.h"
+
+// Hardware sha256 is enabled by the CFDCORE_SHA256_HW build option.
+#if defined(CFDCORE_SHA256_HW) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define CFDCORE_SHA256_X86_SHANI
+#include <cpuid.h>
+#include <immintrin.h>
+//! target attribute of the sha-ni functions
+#define CFDCORE_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+//! target attribute of the avx2 functions
+#define CFDCORE_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#if defined(CFDCORE_SHA256_HW) && defined(__aarch64__) && \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define CFDCORE_SHA256_ARMV8
+#include <arm_neon.h>
+#endif
+
+namespace cfd {
+namespace core {
+
+// ----------------------------------------------------------------------------
+// Internal functions
+// ----------------------------------------------------------------------------
+/**
+ * @brief Read big endian 32bit value.
+ * @param[in] ptr   buffer
+ * @return value
+ */
+static inline uint32_t ReadBE32(const uint8_t *ptr) {
+  return (static_cast<uint32_t>(ptr[0]) << 24) |
+         (static_cast<uint32_t>(ptr[1]) << 16) |
+         (static_cast<uint32_t>(ptr[2]) << 8) | static_cast<uint32_t>(ptr[3]);
+}
+
+/**
+ * @brief Write big endian 32bit value.
+ * @param[out] ptr    buffer
+ * @param[in] value   value
+ */
+static inline void WriteBE32(uint8_t *ptr, uint32_t value) {
+  ptr[0] = static_cast<uint8_t>(value >> 24);
+  ptr[1] = static_cast<uint8_t>(value >> 16);
+  ptr[2] = static_cast<uint8_t>(value >> 8);
+  ptr[3] = static_cast<uint8_t>(value);
+}
+
+/**
+ * @brief Read big endian 64bit value.
+ * @param[in] ptr   buffer
+ * @return value
+ */
+static inline uint64_t ReadBE64(const uint8_t *ptr) {
+  return (static_cast<uint64_t>(ReadBE32(ptr)) << 32) | ReadBE32(ptr + 4);
+}
+
+/**
+ * @brief Write big endian 64bit value.
+ * @param[out] ptr    buffer
+ * @param[in] value   value
+ */
+static inline void WriteBE64(uint8_t *ptr, uint64_t value) {
+  WriteBE32(ptr, static_cast<uint32_t>(value >> 32));
+  WriteBE32(ptr + 4, static_cast<uint32_t>(value));
+}
+
+/**
+ * @brief Read little endian 32bit value.
+ * @param[in] ptr   buffer
+ * @return value
+ */
+static inline uint32_t ReadLE32(const uint8_t *ptr) {
+  return static_cast<uint32_t>(ptr[0]) |
+         (static_cast<uint32_t>(ptr[1]) << 8) |
+         (static_cast<uint32_t>(ptr[2]) << 16) |
+         (static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+/**
+ * @brief Write little endian 32bit value.
+ * @param[out] ptr    buffer
+ * @param[in] value   value
+ */
+static inline void WriteLE32(uint8_t *ptr, uint32_t value) {
+  ptr[0] = static_cast<uint8_t>(value);
+  ptr[1] = static_cast<uint8_t>(value >> 8);
+  ptr[2] = static_cast<uint8_t>(value >> 16);
+  ptr[3] = static_cast<uint8_t>(value >> 24);
+}
+
+/**
+ * @brief Write little endian 64bit value.
+ * @param[out] ptr    buffer
+ * @param[in] value   value
+ */
+static inline void WriteLE64(uint8_t *ptr, uint64_t value) {
+  WriteLE32(ptr, static_cast<uint32_t>(value));
+  WriteLE32(ptr + 4, static_cast<uint32_t>(value >> 32));
+}
+
+/**
+ * @brief Rotate right 32bit value.
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+static inline uint32_t Rotr32(uint32_t value, int count) {
+  return (value >> count) | (value << (32 - count));
+}
+
+/**
+ * @brief Rotate left 32bit value.
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+static inline uint32_t Rotl32(uint32_t value, int count) {
+  return (value << count) | (value >> (32 - count));
+}
+
+/**
+ * @brief Rotate right 64bit value.
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+static inline uint64_t Rotr64(uint64_t value, int count) {
+  return (value >> count) | (value << (64 - count));
+}
+
+/**
+ * @brief Feed data into a block oriented hash state.
+ * @param[in,out] buffer      pending block buffer
+ * @param[in] block_size      block size
+ * @param[in,out] length      hashed length
+ * @param[in] data            data pointer
+ * @param[in] size            data size
+ * @param[in] transform       block transform function
+ * @param[in,out] state       running state
+ */
+template <typename STATE, typename TRANSFORM>
+static void WriteBlocks(
+    uint8_t *buffer, size_t block_size, uint64_t *length, const uint8_t *data,
+    size_t size, TRANSFORM transform, STATE *state) {
+  size_t pending = static_cast<size_t>(*length % block_size);
+  *length += size;
+  if ((pending != 0) && (pending + size >= block_size)) {
+    size_t fill = block_size - pending;
+    memcpy(buffer + pending, data, fill);
+    transform(state, buffer, 1);
+    data += fill;
+    size -= fill;
+    pending = 0;
+  }
+  if (size >= block_size) {
+    size_t blocks = size / block_size;
+    transform(state, data, blocks);
+    data += blocks * block_size;
+    size -= blocks * block_size;
+  }
+  if (size != 0) memcpy(buffer + pending, data, size);
+}
+
+// ----------------------------------------------------------------------------
+// SHA256
+// ----------------------------------------------------------------------------
+//! sha256 initial state
+static constexpr uint32_t kSha256InitialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+//! sha256 round constants
+static constexpr uint32_t kSha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+/**
+ * @brief sha256 block transform. (portable)
+ * @param[in,out] state   running state
+ * @param[in] data        block data
+ * @param[in] blocks      block count
+ */
+static void Sha256TransformPortable(
+    uint32_t *state, const uint8_t *data, size_t blocks) {
+  uint32_t w[64];
+  while (blocks-- != 0) {
+    for (int index = 0; index < 16; ++index) {
+      w[index] = ReadBE32(data + (index * 4));
+    }
+    for (int index = 16; index < 64; ++index) {
+      uint32_t s0 = Rotr32(w[index - 15], 7) ^ Rotr32(w[index - 15], 18) ^
+                    (w[index - 15] >> 3);
+      uint32_t s1 = Rotr32(w[index - 2], 17) ^ Rotr32(w[index - 2], 19) ^
+                    (w[index - 2] >> 10);
+      w[index] = w[index - 16] + s0 + w[index - 7] + s1;
+    }
+
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+    for (int index = 0; index < 64; ++index) {
+      uint32_t s1 = Rotr32(e, 6) ^ Rotr32(e, 11) ^ Rotr32(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t temp1 = h + s1 + ch + kSha256RoundConstants[index] + w[index];
+      uint32_t s0 = Rotr32(a, 2) ^ Rotr32(a, 13) ^ Rotr32(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t temp2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + temp1;
+      d = c;
+      c = b;
+      b = a;
+      a = temp1 + temp2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+    data += Sha256Hasher::kBlockSize;
+  }
+}
+
+#ifdef CFDCORE_SHA256_X86_SHANI
+/**
+ * @brief sha256 quad round. (sha-ni)
+ * @param[in,out] state0    state (ABEF)
+ * @param[in,out] state1    state (CDGH)
+ * @param[in] message       message words
+ * @param[in] round         round index
+ */
+CFDCORE_SHANI_TARGET static inline void Sha256QuadRoundShaNi(
+    __m128i *state0, __m128i *state1, __m128i message, int round) {
+  __m128i words = _mm_add_epi32(
+      message, _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                   &kSha256RoundConstants[round])));
+  *state1 = _mm_sha256rnds2_epu32(*state1, *state0, words);
+  *state0 = _mm_sha256rnds2_epu32(
+      *state0, *state1, _mm_shuffle_epi32(words, 0x0e));
+}
+
+/**
+ * @brief sha256 message schedule. (sha-ni)
+ * @param[in] message0      W[i-16..i-13] (msg1 applied)
+ * @param[in] message2      W[i-8..i-5]
+ * @param[in] message3      W[i-4..i-1]
+ * @return W[i..i+3]
+ */
+CFDCORE_SHANI_TARGET static inline __m128i Sha256NextMessageShaNi(
+    __m128i message0, __m128i message2, __m128i message3) {
+  return _mm_sha256msg2_epu32(
+      _mm_add_epi32(message0, _mm_alignr_epi8(message3, message2, 4)),
+      message3);
+}
+
+/**
+ * @brief sha256 block transform. (x86 sha extensions)
+ * @param[in,out] state   running state
+ * @param[in] data        block data
+ * @param[in] blocks      block count
+ */
+CFDCORE_SHANI_TARGET static void Sha256TransformShaNi(
+    uint32_t *state, const uint8_t *data, size_t blocks) {
+  const __m128i kByteSwapMask =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  // ABCD/EFGH -> ABEF/CDGH
+  __m128i temp = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0xB1);
+  __m128i state1 = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)), 0x1B);
+  __m128i state0 = _mm_alignr_epi8(temp, state1, 8);
+  state1 = _mm_blend_epi16(state1, temp, 0xF0);
+
+  while (blocks-- != 0) {
+    const __m128i save0 = state0;
+    const __m128i save1 = state1;
+    __m128i message[4];
+    for (int index = 0; index < 4; ++index) {
+      message[index] = _mm_shuffle_epi8(
+          _mm_loadu_si128(
+              reinterpret_cast<const __m128i *>(data + (index * 16))),
+          kByteSwapMask);
+    }
+    for (int round = 0; round < 64; round += 4) {
+      int current = (round / 4) % 4;
+      Sha256QuadRoundShaNi(&state0, &state1, message[current], round);
+      if (round < 48) {
+        // W[round+16..] = msg2(msg1(W[round..], W[round+4..]) + ...)
+        __m128i updated = _mm_sha256msg1_epu32(
+            message[current], message[(current + 1) % 4]);
+        message[current] = Sha256NextMessageShaNi(
+            updated, message[(current + 2) % 4], message[(current + 3) % 4]);
+      }
+    }
+    state0 = _mm_add_epi32(state0, save0);
+    state1 = _mm_add_epi32(state1, save1);
+    data += Sha256Hasher::kBlockSize;
+  }
+
+  // ABEF/CDGH -> ABCD/EFGH
+  temp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(temp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, temp, 8);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), state1);
+}
+
+/**
+ * @brief Check the x86 sha extensions.
+ * @retval true   supported
+ * @retval false  unsupported
+ */
+static bool IsSupportedShaNi() {
+  uint32_t eax = 0;
+  uint32_t ebx = 0;
+  uint32_t ecx = 0;
+  uint32_t edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) return false;
+  const bool has_ssse3 = (ecx & (1U << 9)) != 0;
+  const bool has_sse41 = (ecx & (1U << 19)) != 0;
+  if ((!has_ssse3) || (!has_sse41)) return false;
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) return false;
+  return (ebx & (1U << 29)) != 0;
+}
+
+/**
+ * @brief Check the AVX2 instructions and the OS ymm register support.
+ * @retval true   supported
+ * @retval false  unsupported
+ */
+static bool IsSupportedAvx2() {
+  uint32_t eax = 0;
+  uint32_t ebx = 0;
+  uint32_t ecx = 0;
+  uint32_t edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) return false;
+  const bool has_osxsave = (ecx & (1U << 27)) != 0;
+  const bool has_avx = (ecx & (1U << 28)) != 0;
+  if ((!has_osxsave) || (!has_avx)) return false;
+  uint32_t xcr0_low = 0;
+  uint32_t xcr0_high = 0;
+  __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+  if ((xcr0_low & 0x06) != 0x06) return false;  // xmm/ymm state
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) return false;
+  return (ebx & (1U << 5)) != 0;
+}
+
+/**
+ * @brief Rotate right 32bit lanes. (avx2)
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+CFDCORE_AVX2_TARGET static inline __m256i Rotr32Avx2(
+    __m256i value, int count) {
+  return _mm256_or_si256(
+      _mm256_srli_epi32(value, count), _mm256_slli_epi32(value, 32 - count));
+}
+
+/**
+ * @brief sha256 block transform for 8 independent messages. (avx2)
+ * @details Lane N of each state word belongs to the message N.
+ * @param[in,out] state   running state (word-major, 8 lanes)
+ * @param[in] blocks      block pointer of each lane
+ */
+CFDCORE_AVX2_TARGET static void Sha256Transform8WayAvx2(
+    __m256i *state, const uint8_t *const *blocks) {
+  __m256i w[16];
+  for (int index = 0; index < 16; ++index) {
+    const int offset = index * 4;
+    w[index] = _mm256_set_epi32(
+        static_cast<int>(ReadBE32(blocks[7] + offset)),
+        static_cast<int>(ReadBE32(blocks[6] + offset)),
+        static_cast<int>(ReadBE32(blocks[5] + offset)),
+        static_cast<int>(ReadBE32(blocks[4] + offset)),
+        static_cast<int>(ReadBE32(blocks[3] + offset)),
+        static_cast<int>(ReadBE32(blocks[2] + offset)),
+        static_cast<int>(ReadBE32(blocks[1] + offset)),
+        static_cast<int>(ReadBE32(blocks[0] + offset)));
+  }
+
+  __m256i a = state[0];
+  __m256i b = state[1];
+  __m256i c = state[2];
+  __m256i d = state[3];
+  __m256i e = state[4];
+  __m256i f = state[5];
+  __m256i g = state[6];
+  __m256i h = state[7];
+  for (int index = 0; index < 64; ++index) {
+    __m256i word = w[index % 16];
+    if (index >= 16) {
+      const __m256i w15 = w[(index - 15) % 16];
+      const __m256i w2 = w[(index - 2) % 16];
+      const __m256i s0 = _mm256_xor_si256(
+          _mm256_xor_si256(Rotr32Avx2(w15, 7), Rotr32Avx2(w15, 18)),
+          _mm256_srli_epi32(w15, 3));
+      const __m256i s1 = _mm256_xor_si256(
+          _mm256_xor_si256(Rotr32Avx2(w2, 17), Rotr32Avx2(w2, 19)),
+          _mm256_srli_epi32(w2, 10));
+      word = _mm256_add_epi32(
+          _mm256_add_epi32(word, s0),
+          _mm256_add_epi32(w[(index - 7) % 16], s1));
+      w[index % 16] = word;
+    }
+    const __m256i s1 = _mm256_xor_si256(
+        _mm256_xor_si256(Rotr32Avx2(e, 6), Rotr32Avx2(e, 11)),
+        Rotr32Avx2(e, 25));
+    const __m256i ch =
+        _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    const __m256i temp1 = _mm256_add_epi32(
+        _mm256_add_epi32(h, s1),
+        _mm256_add_epi32(
+            _mm256_add_epi32(
+                ch, _mm256_set1_epi32(
+                        static_cast<int>(kSha256RoundConstants[index]))),
+            word));
+    const __m256i s0 = _mm256_xor_si256(
+        _mm256_xor_si256(Rotr32Avx2(a, 2), Rotr32Avx2(a, 13)),
+        Rotr32Avx2(a, 22));
+    const __m256i maj = _mm256_or_si256(
+        _mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    const __m256i temp2 = _mm256_add_epi32(s0, maj);
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi32(d, temp1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi32(temp1, temp2);
+  }
+  state[0] = _mm256_add_epi32(state[0], a);
+  state[1] = _mm256_add_epi32(state[1], b);
+  state[2] = _mm256_add_epi32(state[2], c);
+  state[3] = _mm256_add_epi32(state[3], d);
+  state[4] = _mm256_add_epi32(state[4], e);
+  state[5] = _mm256_add_epi32(state[5], f);
+  state[6] = _mm256_add_epi32(state[6], g);
+  state[7] = _mm256_add_epi32(state[7], h);
+}
+#endif  // CFDCORE_SHA256_X86_SHANI
+
+#ifdef CFDCORE_SHA256_ARMV8
+/**
+ * @brief sha256 block transform. (armv8 crypto extensions)
+ * @param[in,out] state   running state
+ * @param[in] data        block data
+ * @param[in] blocks      block count
+ */
+static void Sha256TransformArmV8(
+    uint32_t *state, const uint8_t *data, size_t blocks) {
+  uint32x4_t state0 = vld1q_u32(state);
+  uint32x4_t state1 = vld1q_u32(state + 4);
+  while (blocks-- != 0) {
+    const uint32x4_t save0 = state0;
+    const uint32x4_t save1 = state1;
+    uint32x4_t message[4];
+    for (int index = 0; index < 4; ++index) {
+      message[index] =
+          vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + (index * 16))));
+    }
+    for (int round = 0; round < 64; round += 4) {
+      int current = (round / 4) % 4;
+      uint32x4_t words =
+          vaddq_u32(message[current], vld1q_u32(&kSha256RoundConstants[round]));
+      if (round < 48) {
+        message[current] = vsha256su1q_u32(
+            vsha256su0q_u32(message[current], message[(current + 1) % 4]),
+            message[(current + 2) % 4], message[(current + 3) % 4]);
+      }
+      uint32x4_t temp = state0;
+      state0 = vsha256hq_u32(state0, state1, words);
+      state1 = vsha256h2q_u32(state1, temp, words);
+    }
+    state0 = vaddq_u32(state0, save0);
+    state1 = vaddq_u32(state1, save1);
+    data += Sha256Hasher::kBlockSize;
+  }
+  vst1q_u32(state, state0);
+  vst1q_u32(state + 4, state1);
+}
+#endif  // CFDCORE_SHA256_ARMV8
+
+/**
+ * @brief Get the best sha256 implementation on this cpu.
+ * @return sha256 implementation
+ */
+static Sha256Implementation DetectSha256Implementation() {
+#ifdef CFDCORE_SHA256_X86_SHANI
+  if (IsSupportedShaNi()) return kSha256X86ShaNi;
+#endif
+#ifdef CFDCORE_SHA256_ARMV8
+  return kSha256ArmV8;
+#endif
+#ifdef CFDCORE_SHA256_X86_SHANI
+  if (IsSupportedAvx2()) return kSha256X86Avx2;
+#endif
+  return kSha256Portable;
+}
+
+/**
+ * @brief Get the current sha256 implementation holder.
+ * @return sha256 implementation holder
+ */
+static std::atomic<int> &GetSha256ImplementationHolder() {
+  // initialized once. (thread-safe by C++11 static initialization)
+  static std::atomic<int> implementation(DetectSha256Implementation());
+  return implementation;
+}
+
+/**
+ * @brief sha256 block transform. (dispatch)
+ * @param[in,out] state   running state
+ * @param[in] data        block data
+ * @param[in] blocks      block count
+ */
+static void Sha256Transform(
+    uint32_t *state, const uint8_t *data, size_t blocks) {
+  switch (GetSha256ImplementationHolder().load(std::memory_order_relaxed)) {
+#ifdef CFDCORE_SHA256_X86_SHANI
+    case kSha256X86ShaNi:
+      Sha256TransformShaNi(state, data, blocks);
+      break;
+#endif
+#ifdef CFDCORE_SHA256_ARMV8
+    case kSha256ArmV8:
+      Sha256TransformArmV8(state, data, blocks);
+      break;
+#endif
+    default:
+      Sha256TransformPortable(state, data, blocks);
+      break;
+  }
+}
+
+Sha256Implementation Sha256Hasher::GetImplementation() {
+  return static_cast<Sha256Implementation>(
+      GetSha256ImplementationHolder().load(std::memory_order_relaxed));
+}
+
+bool Sha256Hasher::IsSupportedImplementation(
+    Sha256Implementation implementation) {
+  switch (implementation) {
+    case kSha256Portable:
+      return true;
+#ifdef CFDCORE_SHA256_X86_SHANI
+    case kSha256X86ShaNi:
+      return IsSupportedShaNi();
+    case kSha256X86Avx2:
+      return IsSupportedAvx2();
+#endif
+#ifdef CFDCORE_SHA256_ARMV8
+    case kSha256ArmV8:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+void Sha256Hasher::SetImplementation(Sha256Implementation implementation) {
+  if (!IsSupportedImplementation(implementation)) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "unsupported sha256 implementation.");
+  }
+  GetSha256ImplementationHolder().store(
+      implementation, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Message lane of the multi-buffer sha256.
+ */
+struct Sha256BatchLane {
+  const uint8_t *data;  //!< message data
+  size_t full_blocks;   //!< block count read directly from the message
+  size_t total_blocks;  //!< block count including the padding
+  uint8_t tail[Sha256Hasher::kBlockSize * 2];  //!< padded last blocks
+};
+
+/**
+ * @brief Prepare the lane of the multi-buffer sha256.
+ * @param[in] input   message
+ * @param[out] lane   lane
+ */
+static void InitializeSha256BatchLane(
+    const ByteDataView &input, Sha256BatchLane *lane) {
+  static constexpr size_t kBlockSize = Sha256Hasher::kBlockSize;
+  const size_t remain = input.size() % kBlockSize;
+  lane->data = input.data();
+  lane->full_blocks = input.size() / kBlockSize;
+  size_t tail_blocks = (remain + 9 <= kBlockSize) ? 1 : 2;
+  lane->total_blocks = lane->full_blocks + tail_blocks;
+  memset(lane->tail, 0, sizeof(lane->tail));
+  if (remain != 0) {
+    memcpy(lane->tail, input.data() + (lane->full_blocks * kBlockSize), remain);
+  }
+  lane->tail[remain] = 0x80;
+  WriteBE64(
+      lane->tail + (tail_blocks * kBlockSize) - 8,
+      static_cast<uint64_t>(input.size()) << 3);
+}
+
+/**
+ * @brief Get the block of the lane.
+ * @param[in] lane    lane
+ * @param[in] block   block index
+ * @return block pointer
+ */
+static inline const uint8_t *GetSha256BatchBlock(
+    const Sha256BatchLane &lane, size_t block) {
+  if (block < lane.full_blocks) {
+    return lane.data + (block * Sha256Hasher::kBlockSize);
+  }
+  return lane.tail + ((block - lane.full_blocks) * Sha256Hasher::kBlockSize);
+}
+
+#ifdef CFDCORE_SHA256_X86_SHANI
+/**
+ * @brief Hash up to 8 messages of the same block count. (avx2)
+ * @param[in] lanes       lane list
+ * @param[in] count       lane count (1-8)
+ * @param[out] outputs    output pointer of each lane
+ */
+CFDCORE_AVX2_TARGET static void Sha256Hash8WayAvx2(
+    const Sha256BatchLane *const *lanes, size_t count,
+    uint8_t *const *outputs) {
+  static constexpr size_t kLaneCount = 8;
+  __m256i state[8];
+  for (size_t index = 0; index < 8; ++index) {
+    state[index] =
+        _mm256_set1_epi32(static_cast<int>(kSha256InitialState[index]));
+  }
+  const uint8_t *blocks[kLaneCount];
+  const size_t total_blocks = lanes[0]->total_blocks;
+  for (size_t block = 0; block < total_blocks; ++block) {
+    for (size_t lane = 0; lane < kLaneCount; ++lane) {
+      // unused lanes repeat the first lane.
+      blocks[lane] =
+          GetSha256BatchBlock(*lanes[(lane < count) ? lane : 0], block);
+    }
+    Sha256Transform8WayAvx2(state, blocks);
+  }
+
+  uint32_t words[kLaneCount];
+  for (size_t index = 0; index < 8; ++index) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(words), state[index]);
+    for (size_t lane = 0; lane < count; ++lane) {
+      WriteBE32(outputs[lane] + (index * 4), words[lane]);
+    }
+  }
+}
+#endif  // CFDCORE_SHA256_X86_SHANI
+
+void Sha256Hasher::HashBatch(
+    const ByteDataView *inputs, size_t count, uint8_t *outputs) {
+  if (count == 0) return;
+  if ((inputs == nullptr) || (outputs == nullptr)) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid sha256 batch buffer.");
+  }
+#ifdef CFDCORE_SHA256_X86_SHANI
+  if ((count > 1) && (GetImplementation() == kSha256X86Avx2)) {
+    static constexpr size_t kLaneCount = 8;
+    std::vector<Sha256BatchLane> lanes(count);
+    std::vector<size_t> order(count);
+    for (size_t index = 0; index < count; ++index) {
+      InitializeSha256BatchLane(inputs[index], &lanes[index]);
+      order[index] = index;
+    }
+    // group the messages of the same block count.
+    std::stable_sort(
+        order.begin(), order.end(), [&lanes](size_t left, size_t right) {
+          return lanes[left].total_blocks < lanes[right].total_blocks;
+        });
+    const Sha256BatchLane *group[kLaneCount];
+    uint8_t *group_outputs[kLaneCount];
+    size_t offset = 0;
+    while (offset < count) {
+      size_t group_count = 0;
+      const size_t total_blocks = lanes[order[offset]].total_blocks;
+      while ((offset < count) && (group_count < kLaneCount) &&
+             (lanes[order[offset]].total_blocks == total_blocks)) {
+        group[group_count] = &lanes[order[offset]];
+        group_outputs[group_count] = outputs + (order[offset] * kOutputSize);
+        ++group_count;
+        ++offset;
+      }
+      Sha256Hash8WayAvx2(group, group_count, group_outputs);
+    }
+    return;
+  }
+#endif  // CFDCORE_SHA256_X86_SHANI
+  // single buffer. (sha-ni/armv8 is faster than multi-buffer avx2)
+  for (size_t index = 0; index < count; ++index) {
+    Sha256Hasher()
+        .Write(inputs[index].data(), inputs[index].size())
+        .Finalize(outputs + (index * kOutputSize));
+  }
+}
+
+Sha256Hasher::Sha256Hasher() { Reset(); }
+
+Sha256Hasher::Sha256Hasher(const uint32_t *midstate, uint64_t length)
+    : length_(length) {
+  if ((midstate == nullptr) || ((length % kBlockSize) != 0)) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid sha256 midstate.");
+  }
+  memcpy(state_, midstate, sizeof(state_));
+}
+
+Sha256Hasher Sha256Hasher::CreateTaggedHasher(TaggedHashTag tag) {
+  struct TaggedMidstateTable {
+    Sha256Hasher hashers[kTaggedHashTagCount];
+    TaggedMidstateTable() {
+      static const char *const kTagNames[kTaggedHashTagCount] = {
+          "TapLeaf",           "TapBranch",   "TapTweak",      "TapSighash",
+          "BIP0340/challenge", "BIP0340/aux", "BIP0340/nonce",
+      };
+      for (size_t index = 0; index < kTaggedHashTagCount; ++index) {
+        hashers[index] = CreateTaggedHasher(std::string(kTagNames[index]));
+      }
+    }
+  };
+  // initialized once. (thread-safe by C++11 static initialization)
+  static const TaggedMidstateTable kTable;
+  if (static_cast<uint32_t>(tag) >= kTaggedHashTagCount) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid tagged hash tag.");
+  }
+  return kTable.hashers[tag];
+}
+
+Sha256Hasher Sha256Hasher::CreateTaggedHasher(const std::string &tag) {
+  uint8_t tag_hash[kOutputSize];
+  Sha256Hasher()
+      .Write(reinterpret_cast<const uint8_t *>(tag.data()), tag.size())
+      .Finalize(tag_hash);
+  Sha256Hasher hasher;
+  hasher.Write(tag_hash, sizeof(tag_hash));
+  hasher.Write(tag_hash, sizeof(tag_hash));
+  return hasher;
+}
+
+void Sha256Hasher::Reset() {
+  memcpy(state_, kSha256InitialState, sizeof(state_));
+  length_ = 0;
+}
+
+Sha256Hasher &Sha256Hasher::Write(const uint8_t *data, size_t size) {
+  if (size != 0) {
+    WriteBlocks(
+        buffer_, kBlockSize, &length_, data, size, Sha256Transform, state_);
+  }
+  return *this;
+}
+
+void Sha256Hasher::Finalize(uint8_t *output) const {
+  Sha256Hasher hasher(*this);
+  static const uint8_t kPadding[kBlockSize] = {0x80};
+  uint8_t size_data[8];
+  WriteBE64(size_data, length_ << 3);
+  hasher.Write(kPadding, 1 + ((119 - (length_ % kBlockSize)) % kBlockSize));
+  hasher.Write(size_data, sizeof(size_data));
+  for (size_t index = 0; index < kStateSize; ++index) {
+    WriteBE32(output + (index * 4), hasher.state_[index]);
+  }
+}
+
+ByteData256 Sha256Hasher::Finalize() const {
+  uint8_t output[kOutputSize];
+  Finalize(output);
+  return ByteData256(output, sizeof(output));
+}
+
+void Sha256Hasher::GetMidstate(uint32_t *midstate) const {
+  memcpy(midstate, state_, sizeof(state_));
+}
+
+// ----------------------------------------------------------------------------
+// SHA512
+// ----------------------------------------------------------------------------
+//! sha512 initial state
+static constexpr uint64_t kSha512InitialState[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+
+//! sha512 round constants
+static constexpr uint64_t kSha512RoundConstants[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+/**
+ * @brief sha512 block transform.
+ * @param[in,out] state   running state
+ * @param[in] data        block data
+ * @param[in] blocks      block count
+ */
+static void Sha512Transform(
+    uint64_t *state, const uint8_t *data, size_t blocks) {
+  uint64_t w[80];
+  while (blocks-- != 0) {
+    for (int index = 0; index < 16; ++index) {
+      w[index] = ReadBE64(data + (index * 8));
+    }
+    for (int index = 16; index < 80; ++index) {
+      uint64_t s0 = Rotr64(w[index - 15], 1) ^ Rotr64(w[index - 15], 8) ^
+                    (w[index - 15] >> 7);
+      uint64_t s1 = Rotr64(w[index - 2], 19) ^ Rotr64(w[index - 2], 61) ^
+                    (w[index - 2] >> 6);
+      w[index] = w[index - 16] + s0 + w[index - 7] + s1;
+    }
+
+    uint64_t a = state[0];
+    uint64_t b = state[1];
+    uint64_t c = state[2];
+    uint64_t d = state[3];
+    uint64_t e = state[4];
+    uint64_t f = state[5];
+    uint64_t g = state[6];
+    uint64_t h = state[7];
+    for (int index = 0; index < 80; ++index) {
+      uint64_t s1 = Rotr64(e, 14) ^ Rotr64(e, 18) ^ Rotr64(e, 41);
+      uint64_t ch = (e & f) ^ (~e & g);
+      uint64_t temp1 = h + s1 + ch + kSha512RoundConstants[index] + w[index];
+      uint64_t s0 = Rotr64(a, 28) ^ Rotr64(a, 34) ^ Rotr64(a, 39);
+      uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint64_t temp2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + temp1;
+      d = c;
+      c = b;
+      b = a;
+      a = temp1 + temp2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+    data += Sha512Hasher::kBlockSize;
+  }
+}
+
+Sha512Hasher::Sha512Hasher() { Reset(); }
+
+void Sha512Hasher::Reset() {
+  memcpy(state_, kSha512InitialState, sizeof(state_));
+  length_ = 0;
+}
+
+Sha512Hasher &Sha512Hasher::Write(const uint8_t *data, size_t size) {
+  if (size != 0) {
+    WriteBlocks(
+        buffer_, kBlockSize, &length_, data, size, Sha512Transform, state_);
+  }
+  return *this;
+}
+
+void Sha512Hasher::Finalize(uint8_t *output) const {
+  Sha512Hasher hasher(*this);
+  static const uint8_t kPadding[kBlockSize] = {0x80};
+  // 128bit length: the upper 64bit is always zero.
+  uint8_t size_data[16] = {0};
+  WriteBE64(size_data + 8, length_ << 3);
+  hasher.Write(kPadding, 1 + ((239 - (length_ % kBlockSize)) % kBlockSize));
+  hasher.Write(size_data, sizeof(size_data));
+  for (size_t index = 0; index < 8; ++index) {
+    WriteBE64(output + (index * 8), hasher.state_[index]);
+  }
+}
+
+ByteData Sha512Hasher::Finalize() const {
+  std::vector<uint8_t> output(kOutputSize);
+  Finalize(output.data());
+  return ByteData(output);
+}
+
+// ----------------------------------------------------------------------------
+// RIPEMD160
+// ----------------------------------------------------------------------------
+//! ripemd160 initial state
+static constexpr uint32_t kRipemd160InitialState[5] = {
+    0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+//! ripemd160 message word selection (left line)
+static constexpr uint8_t kRipemd160LeftIndex[80] = {
+    0, 1, 2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15,
+    7, 4, 13, 1,  10, 6,  15, 3,  12, 0,  9,  5,  2,  14, 11, 8,
+    3, 10, 14, 4, 9,  15, 8,  1,  2,  7,  0,  6,  13, 11, 5,  12,
+    1, 9, 11, 10, 0,  8,  12, 4,  13, 3,  7,  15, 14, 5,  6,  2,
+    4, 0, 5,  9,  7,  12, 2,  10, 14, 1,  3,  8,  11, 6,  15, 13};
+
+//! ripemd160 message word selection (right line)
+static constexpr uint8_t kRipemd160RightIndex[80] = {
+    5,  14, 7,  0, 9, 2,  11, 4,  13, 6,  15, 8,  1,  10, 3,  12,
+    6,  11, 3,  7, 0, 13, 5,  10, 14, 15, 8,  12, 4,  9,  1,  2,
+    15, 5,  1,  3, 7, 14, 6,  9,  11, 8,  12, 2,  10, 0,  4,  13,
+    8,  6,  4,  1, 3, 11, 15, 0,  5,  12, 2,  13, 9,  7,  10, 14,
+    12, 15, 10, 4, 1, 5,  8,  7,  6,  2,  13, 14, 0,  3,  9,  11};
+
+//! ripemd160 rotate count (left line)
+static constexpr uint8_t kRipemd160LeftRotate[80] = {
+    11, 14, 15, 12, 5,  8,  7,  9,  11, 13, 14, 15, 6,  7,  9,  8,
+    7,  6,  8,  13, 11, 9,  7,  15, 7,  12, 15, 9,  11, 7,  13, 12,
+    11, 13, 6,  7,  14, 9,  13, 15, 14, 8,  13, 6,  5,  12, 7,  5,
+    11, 12, 14, 15, 14, 15, 9,  8,  9,  14, 5,  6,  8,  6,  5,  12,
+    9,  15, 5,  11, 6,  8,  13, 12, 5,  12, 13, 14, 11, 8,  5,  6};
+
+//! ripemd160 rotate count (right line)
+static constexpr uint8_t kRipemd160RightRotate[80] = {
+    8,  9,  9,  11, 13, 15, 15, 5,  7,  7,  8,  11, 14, 14, 12, 6,
+    9,  13, 15, 7,  12, 8,  9,  11, 7,  7,  12, 7,  6,  15, 13, 11,
+    9,  7,  15, 11, 8,  6,  6,  14, 12, 13, 5,  14, 13, 13, 7,  5,
+    15, 5,  8,  11, 14, 14, 6,  14, 6,  9,  12, 9,  12, 5,  15, 8,
+    8,  5,  12, 9,  12, 5,  14, 6,  8,  13, 6,  5,  15, 13, 11, 11};
+
+//! ripemd160 round constants (left line)
+static constexpr uint32_t kRipemd160LeftConstants[5] = {
+    0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E};
+
+//! ripemd160 round constants (right line)
+static constexpr uint32_t kRipemd160RightConstants[5] = {
+    0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000};
+
+/**
+ * @brief ripemd160 boolean function.
+ * @param[in] round   round number (0-4)
+ * @param[in] x       x
+ * @param[in] y       y
+ * @param[in] z       z
+ * @return value
+ */
+static inline uint32_t Ripemd160Function(
+    int round, uint32_t x, uint32_t y, uint32_t z) {
+  switch (round) {
+    case 0:
+      return x ^ y ^ z;
+    case 1:
+      return (x & y) | (~x & z);
+    case 2:
+      return (x | ~y) ^ z;
+    case 3:
+      return (x & z) | (y & ~z);
+    default:
+      return x ^ (y | ~z);
+  }
+}
+
+/**
+ * @brief ripemd160 block transform.
+ * @param[in,out] state   running state
+ * @param[in] data        block data
+ * @param[in] blocks      block count
+ */
+static void Ripemd160Transform(
+    uint32_t *state, const uint8_t *data, size_t blocks) {
+  uint32_t w[16];
+  while (blocks-- != 0) {
+    for (int index = 0; index < 16; ++index) {
+      w[index] = ReadLE32(data + (index * 4));
+    }
+
+    uint32_t al = state[0];
+    uint32_t bl = state[1];
+    uint32_t cl = state[2];
+    uint32_t dl = state[3];
+    uint32_t el = state[4];
+    uint32_t ar = al;
+    uint32_t br = bl;
+    uint32_t cr = cl;
+    uint32_t dr = dl;
+    uint32_t er = el;
+    for (int index = 0; index < 80; ++index) {
+      int round = index / 16;
+      uint32_t temp = Rotl32(
+                          al + Ripemd160Function(round, bl, cl, dl) +
+                              w[kRipemd160LeftIndex[index]] +
+                              kRipemd160LeftConstants[round],
+                          kRipemd160LeftRotate[index]) +
+                      el;
+      al = el;
+      el = dl;
+      dl = Rotl32(cl, 10);
+      cl = bl;
+      bl = temp;
+
+      temp = Rotl32(
+                 ar + Ripemd160Function(4 - round, br, cr, dr) +
+                     w[kRipemd160RightIndex[index]] +
+                     kRipemd160RightConstants[round],
+                 kRipemd160RightRotate[index]) +
+             er;
+      ar = er;
+      er = dr;
+      dr = Rotl32(cr, 10);
+      cr = br;
+      br = temp;
+    }
+    uint32_t temp = state[1] + cl + dr;
+    state[1] = state[2] + dl + er;
+    state[2] = state[3] + el + ar;
+    state[3] = state[4] + al + br;
+    state[4] = state[0] + bl + cr;
+    state[0] = temp;
+    data += Ripemd160Hasher::kBlockSize;
+  }
+}
+
+Ripemd160Hasher::Ripemd160Hasher() { Reset(); }
+
+void Ripemd160Hasher::Reset() {
+  memcpy(state_, kRipemd160InitialState, sizeof(state_));
+  length_ = 0;
+}
+
+Ripemd160Hasher &Ripemd160Hasher::Write(const uint8_t *data, size_t size) {
+  if (size != 0) {
+    WriteBlocks(
+        buffer_, kBlockSize, &length_, data, size, Ripemd160Transform,
+        state_);
+  }
+  return *this;
+}
+
+void Ripemd160Hasher::Finalize(uint8_t *output) const {
+  Ripemd160Hasher hasher(*this);
+  static const uint8_t kPadding[kBlockSize] = {0x80};
+  uint8_t size_data[8];
+  WriteLE64(size_data, length_ << 3);
+  hasher.Write(kPadding, 1 + ((119 - (length_ % kBlockSize)) % kBlockSize));
+  hasher.Write(size_data, sizeof(size_data));
+  for (size_t index = 0; index < 5; ++index) {
+    WriteLE32(output + (index * 4), hasher.state_[index]);
+  }
+}
+
+ByteData160 Ripemd160Hasher::Finalize() const {
+  uint8_t output[kOutputSize];
+  Finalize(output);
+  return ByteData160(output, sizeof(output));
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,472 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_hex.cpp
+ *
+ * @brief This file implements the hex string conversion of StringUtil.
+ */
+
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+#include "cfdcore/cfdcore_util.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define CFDCORE_HEX_X86
+#include <immintrin.h>
+//! target attribute of the ssse3 functions
+#define CFDCORE_SSSE3_TARGET __attribute__((target("ssse3")))
+//! target attribute of the avx2 functions
+#define CFDCORE_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define CFDCORE_HEX_NEON
+#include <arm_neon.h>
+#endif
+
+namespace cfd {
+namespace core {
+
+using logger::info;
+using logger::warn;
+
+// ----------------------------------------------------------------------------
+// Portable
+// ----------------------------------------------------------------------------
+/// hex characters
+static constexpr char kHexCharacters[] = "0123456789abcdef";
+
+/**
+ * @brief Convert the hex character to the nibble value.
+ * @param[in] character   hex character
+ * @return nibble value (-1: invalid character)
+ */
+static inline int ConvertHexNibble(char character) {
+  if ((character >= '0') && (character <= '9')) return character - '0';
+  if ((character >= 'a') && (character <= 'f')) return character - 'a' + 10;
+  if ((character >= 'A') && (character <= 'F')) return character - 'A' + 10;
+  return -1;
+}
+
+/**
+ * @brief Encode the bytes to the hex characters.
+ * @param[in] bytes     byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   character buffer (size * 2)
+ */
+static void EncodeHexPortable(const uint8_t *bytes, size_t size, char *output) {
+  for (size_t index = 0; index < size; ++index) {
+    output[index * 2] = kHexCharacters[bytes[index] >> 4];
+    output[index * 2 + 1] = kHexCharacters[bytes[index] & 0x0f];
+  }
+}
+
+/**
+ * @brief Decode the hex characters to the bytes.
+ * @param[in] hex_str   character buffer
+ * @param[in] size      byte size (character count / 2)
+ * @param[out] output   byte buffer
+ * @retval true   success
+ * @retval false  invalid character
+ */
+static bool DecodeHexPortable(
+    const char *hex_str, size_t size, uint8_t *output) {
+  for (size_t index = 0; index < size; ++index) {
+    int high = ConvertHexNibble(hex_str[index * 2]);
+    int low = ConvertHexNibble(hex_str[index * 2 + 1]);
+    if ((high < 0) || (low < 0)) return false;
+    output[index] = static_cast<uint8_t>((high << 4) | low);
+  }
+  return true;
+}
+
+#ifdef CFDCORE_HEX_X86
+// ----------------------------------------------------------------------------
+// SSSE3 / AVX2
+// ----------------------------------------------------------------------------
+/**
+ * @brief Encode 16 bytes per loop. (ssse3)
+ * @param[in] bytes     byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   character buffer (size * 2)
+ * @return processed byte size
+ */
+CFDCORE_SSSE3_TARGET static size_t EncodeHexSsse3(
+    const uint8_t *bytes, size_t size, char *output) {
+  const __m128i table =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(kHexCharacters));
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    __m128i value =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + offset));
+    __m128i high = _mm_shuffle_epi8(
+        table, _mm_and_si128(_mm_srli_epi16(value, 4), mask));
+    __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(value, mask));
+    char *dest = output + (offset * 2);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(dest), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(dest + 16), _mm_unpackhi_epi8(high, low));
+  }
+  return offset;
+}
+
+/**
+ * @brief Convert 16 hex characters to the nibble values. (ssse3)
+ * @param[in] value       hex characters
+ * @param[in,out] valid   valid flags (0xff: valid)
+ * @return nibble values
+ */
+CFDCORE_SSSE3_TARGET static inline __m128i ConvertHexNibbleSsse3(
+    __m128i value, __m128i *valid) {
+  const __m128i digit = _mm_sub_epi8(value, _mm_set1_epi8('0'));
+  const __m128i digit_ok =
+      _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  const __m128i alpha = _mm_sub_epi8(
+      _mm_or_si128(value, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i alpha_ok =
+      _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+  *valid = _mm_and_si128(*valid, _mm_or_si128(digit_ok, alpha_ok));
+  return _mm_or_si128(
+      _mm_and_si128(digit_ok, digit),
+      _mm_and_si128(alpha_ok, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+/**
+ * @brief Decode 32 hex characters per loop. (ssse3)
+ * @param[in] hex_str   character buffer
+ * @param[in] size      byte size (character count / 2)
+ * @param[out] output   byte buffer
+ * @return processed byte size (a short count means an invalid character)
+ */
+CFDCORE_SSSE3_TARGET static size_t DecodeHexSsse3(
+    const char *hex_str, size_t size, uint8_t *output) {
+  // (high * 16) + low for each character pair.
+  const __m128i weight = _mm_set1_epi16(0x0110);
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    const char *src = hex_str + (offset * 2);
+    __m128i valid = _mm_set1_epi8(-1);
+    __m128i first = ConvertHexNibbleSsse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)), &valid);
+    __m128i second = ConvertHexNibbleSsse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16)), &valid);
+    if (_mm_movemask_epi8(valid) != 0xffff) break;
+    __m128i result = _mm_packus_epi16(
+        _mm_maddubs_epi16(first, weight), _mm_maddubs_epi16(second, weight));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + offset), result);
+  }
+  return offset;
+}
+
+/**
+ * @brief Encode 32 bytes per loop. (avx2)
+ * @param[in] bytes     byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   character buffer (size * 2)
+ * @return processed byte size
+ */
+CFDCORE_AVX2_TARGET static size_t EncodeHexAvx2(
+    const uint8_t *bytes, size_t size, char *output) {
+  const __m256i table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(kHexCharacters)));
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t offset = 0;
+  for (; offset + 32 <= size; offset += 32) {
+    __m256i value =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes + offset));
+    __m256i high = _mm256_shuffle_epi8(
+        table, _mm256_and_si256(_mm256_srli_epi16(value, 4), mask));
+    __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(value, mask));
+    // unpack works per 128bit lane: [0-7,16-23] and [8-15,24-31]
+    __m256i first = _mm256_unpacklo_epi8(high, low);
+    __m256i second = _mm256_unpackhi_epi8(high, low);
+    char *dest = output + (offset * 2);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dest),
+        _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dest + 32),
+        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return offset;
+}
+
+/**
+ * @brief Convert 32 hex characters to the nibble values. (avx2)
+ * @param[in] value       hex characters
+ * @param[in,out] valid   valid flags (0xff: valid)
+ * @return nibble values
+ */
+CFDCORE_AVX2_TARGET static inline __m256i ConvertHexNibbleAvx2(
+    __m256i value, __m256i *valid) {
+  const __m256i digit = _mm256_sub_epi8(value, _mm256_set1_epi8('0'));
+  const __m256i digit_ok =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+  const __m256i alpha = _mm256_sub_epi8(
+      _mm256_or_si256(value, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  const __m256i alpha_ok =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+  *valid = _mm256_and_si256(*valid, _mm256_or_si256(digit_ok, alpha_ok));
+  return _mm256_or_si256(
+      _mm256_and_si256(digit_ok, digit),
+      _mm256_and_si256(alpha_ok, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+/**
+ * @brief Decode 64 hex characters per loop. (avx2)
+ * @param[in] hex_str   character buffer
+ * @param[in] size      byte size (character count / 2)
+ * @param[out] output   byte buffer
+ * @return processed byte size (a short count means an invalid character)
+ */
+CFDCORE_AVX2_TARGET static size_t DecodeHexAvx2(
+    const char *hex_str, size_t size, uint8_t *output) {
+  const __m256i weight = _mm256_set1_epi16(0x0110);
+  size_t offset = 0;
+  for (; offset + 32 <= size; offset += 32) {
+    const char *src = hex_str + (offset * 2);
+    __m256i valid = _mm256_set1_epi8(-1);
+    __m256i first = ConvertHexNibbleAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src)), &valid);
+    __m256i second = ConvertHexNibbleAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 32)),
+        &valid);
+    if (_mm256_movemask_epi8(valid) != -1) break;
+    // pack works per 128bit lane: reorder the 64bit blocks.
+    __m256i result = _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(
+            _mm256_maddubs_epi16(first, weight),
+            _mm256_maddubs_epi16(second, weight)),
+        0xd8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + offset), result);
+  }
+  return offset;
+}
+
+/// hex implementation
+enum HexImplementation {
+  kHexPortable = 0,  //!< portable
+  kHexSsse3 = 1,     //!< ssse3
+  kHexAvx2 = 2,      //!< avx2
+};
+
+/**
+ * @brief Get the hex implementation of the running cpu.
+ * @return hex implementation
+ */
+static HexImplementation GetHexImplementation() {
+  static const HexImplementation implementation = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return kHexAvx2;
+    if (__builtin_cpu_supports("ssse3")) return kHexSsse3;
+    return kHexPortable;
+  }();
+  return implementation;
+}
+#endif  // CFDCORE_HEX_X86
+
+#ifdef CFDCORE_HEX_NEON
+// ----------------------------------------------------------------------------
+// NEON
+// ----------------------------------------------------------------------------
+/**
+ * @brief Encode 16 bytes per loop. (neon)
+ * @param[in] bytes     byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   character buffer (size * 2)
+ * @return processed byte size
+ */
+static size_t EncodeHexNeon(const uint8_t *bytes, size_t size, char *output) {
+  const uint8x16_t table =
+      vld1q_u8(reinterpret_cast<const uint8_t *>(kHexCharacters));
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    uint8x16_t value = vld1q_u8(bytes + offset);
+    uint8x16x2_t chars;
+    chars.val[0] = vqtbl1q_u8(table, vshrq_n_u8(value, 4));
+    chars.val[1] = vqtbl1q_u8(table, vandq_u8(value, vdupq_n_u8(0x0f)));
+    vst2q_u8(reinterpret_cast<uint8_t *>(output + (offset * 2)), chars);
+  }
+  return offset;
+}
+
+/**
+ * @brief Convert 16 hex characters to the nibble values. (neon)
+ * @param[in] value       hex characters
+ * @param[in,out] valid   valid flags (0xff: valid)
+ * @return nibble values
+ */
+static inline uint8x16_t ConvertHexNibbleNeon(
+    uint8x16_t value, uint8x16_t *valid) {
+  const uint8x16_t digit = vsubq_u8(value, vdupq_n_u8('0'));
+  const uint8x16_t digit_ok = vcleq_u8(digit, vdupq_n_u8(9));
+  const uint8x16_t alpha =
+      vsubq_u8(vorrq_u8(value, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  const uint8x16_t alpha_ok = vcleq_u8(alpha, vdupq_n_u8(5));
+  *valid = vandq_u8(*valid, vorrq_u8(digit_ok, alpha_ok));
+  return vbslq_u8(digit_ok, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+}
+
+/**
+ * @brief Decode 32 hex characters per loop. (neon)
+ * @param[in] hex_str   character buffer
+ * @param[in] size      byte size (character count / 2)
+ * @param[out] output   byte buffer
+ * @return processed byte size (a short count means an invalid character)
+ */
+static size_t DecodeHexNeon(const char *hex_str, size_t size, uint8_t *output) {
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    uint8x16x2_t chars =
+        vld2q_u8(reinterpret_cast<const uint8_t *>(hex_str + (offset * 2)));
+    uint8x16_t valid = vdupq_n_u8(0xff);
+    uint8x16_t high = ConvertHexNibbleNeon(chars.val[0], &valid);
+    uint8x16_t low = ConvertHexNibbleNeon(chars.val[1], &valid);
+    if (vminvq_u8(valid) != 0xff) break;
+    vst1q_u8(output + offset, vorrq_u8(vshlq_n_u8(high, 4), low));
+  }
+  return offset;
+}
+#endif  // CFDCORE_HEX_NEON
+
+// ----------------------------------------------------------------------------
+// Dispatch
+// ----------------------------------------------------------------------------
+/**
+ * @brief Encode the bytes to the hex characters.
+ * @param[in] bytes     byte buffer
+ * @param[in] size      byte size
+ * @param[out] output   character buffer (size * 2)
+ */
+static void EncodeHex(const uint8_t *bytes, size_t size, char *output) {
+  size_t offset = 0;
+#if defined(CFDCORE_HEX_X86)
+  switch (GetHexImplementation()) {
+    case kHexAvx2:
+      offset = EncodeHexAvx2(bytes, size, output);
+      offset += EncodeHexSsse3(
+          bytes + offset, size - offset, output + (offset * 2));
+      break;
+    case kHexSsse3:
+      offset = EncodeHexSsse3(bytes, size, output);
+      break;
+    case kHexPortable:
+    default:
+      break;
+  }
+#elif defined(CFDCORE_HEX_NEON)
+  offset = EncodeHexNeon(bytes, size, output);
+#endif
+  EncodeHexPortable(bytes + offset, size - offset, output + (offset * 2));
+}
+
+/**
+ * @brief Decode the hex characters to the bytes.
+ * @param[in] hex_str   character buffer
+ * @param[in] size      byte size (character count / 2)
+ * @param[out] output   byte buffer
+ * @retval true   success
+ * @retval false  invalid character
+ */
+static bool DecodeHex(const char *hex_str, size_t size, uint8_t *output) {
+  size_t offset = 0;
+#if defined(CFDCORE_HEX_X86)
+  switch (GetHexImplementation()) {
+    case kHexAvx2:
+      offset = DecodeHexAvx2(hex_str, size, output);
+      offset += DecodeHexSsse3(
+          hex_str + (offset * 2), size - offset, output + offset);
+      break;
+    case kHexSsse3:
+      offset = DecodeHexSsse3(hex_str, size, output);
+      break;
+    case kHexPortable:
+    default:
+      break;
+  }
+#elif defined(CFDCORE_HEX_NEON)
+  offset = DecodeHexNeon(hex_str, size, output);
+#endif
+  // the portable path also locates an invalid character of a simd block.
+  return DecodeHexPortable(
+      hex_str + (offset * 2), size - offset, output + offset);
+}
+
+// ----------------------------------------------------------------------------
+// StringUtil
+// ----------------------------------------------------------------------------
+bool StringUtil::IsValidHexString(const std::string &hex_str) {
+  if (hex_str.empty()) return true;
+  if ((hex_str.size() % 2) != 0) return false;
+
+  static constexpr size_t kChunkSize = 1024;
+  uint8_t buffer[kChunkSize];
+  const size_t size = hex_str.size() / 2;
+  for (size_t offset = 0; offset < size; offset += kChunkSize) {
+    size_t chunk = (size - offset < kChunkSize) ? size - offset : kChunkSize;
+    if (!DecodeHex(hex_str.data() + (offset * 2), chunk, buffer)) return false;
+  }
+  return true;
+}
+
+std::vector<uint8_t> StringUtil::StringToByte(const std::string &hex_str) {
+  if (hex_str.empty()) {
+    info(CFD_LOG_SOURCE, "hex_str empty. return empty buffer.");
+    return std::vector<uint8_t>();
+  }
+  std::vector<uint8_t> buffer(hex_str.size() / 2);
+  StringToByte(hex_str.data(), hex_str.size(), buffer.data());
+  return buffer;
+}
+
+void StringUtil::StringToByte(
+    const char *hex_str, size_t size, uint8_t *output) {
+  if ((size % 2) != 0) {
+    warn(CFD_LOG_SOURCE, "hex string length is odd. length={}", size);
+    throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
+  }
+  if (size == 0) return;
+  if ((hex_str == nullptr) || (output == nullptr)) {
+    warn(CFD_LOG_SOURCE, "hex buffer is null.");
+    throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
+  }
+  if (!DecodeHex(hex_str, size / 2, output)) {
+    warn(CFD_LOG_SOURCE, "hex string contains an invalid character.");
+    throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
+  }
+}
+
+std::string StringUtil::ByteToString(const std::vector<uint8_t> &bytes) {
+  if (bytes.empty()) {
+    info(CFD_LOG_SOURCE, "bytes empty. return empty string.");
+    return std::string();
+  }
+  return ByteToString(ByteDataView(bytes));
+}
+
+std::string StringUtil::ByteToString(const ByteDataView &bytes) {
+  std::string byte_str(bytes.size() * 2, '\0');
+  if (!bytes.IsEmpty()) {
+    ByteToString(bytes.data(), bytes.size(), &byte_str[0]);
+  }
+  return byte_str;
+}
+
+void StringUtil::ByteToString(const uint8_t *bytes, size_t size, char *output) {
+  if (size == 0) return;
+  if ((bytes == nullptr) || (output == nullptr)) {
+    warn(CFD_LOG_SOURCE, "hex buffer is null.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "byte to hex convert error.");
+  }
+  EncodeHex(bytes, size, output);
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -28,13 +28,16 @@ using logger::warn;
 Pubkey::Pubkey() : data_() {}
 
 bool Pubkey::IsValid(const ByteData &byte_data) {
-  const std::vector<uint8_t> &buffer = byte_data.GetBytes();
-  if (buffer.size() > 0) {
-    uint8_t header = buffer[0];
+  return IsValid(ByteDataView(byte_data));
+}
+
+bool Pubkey::IsValid(const ByteDataView &byte_data) {
+  if (byte_data.size() > 0) {
+    uint8_t header = byte_data.data()[0];
     if (header == 0x02 || header == 0x03) {
-      return buffer.size() == Pubkey::kCompressedPubkeySize;
+      return byte_data.size() == Pubkey::kCompressedPubkeySize;
     } else if (header == 0x04 || header == 0x06 || header == 0x07) {
-      return buffer.size() == Pubkey::kPubkeySize;
+      return byte_data.size() == Pubkey::kPubkeySize;
     }
   }
   return false;
@@ -48,6 +51,15 @@ Pubkey::Pubkey(ByteData byte_data) : data_(byte_data) {
   }
 }
 
+Pubkey::Pubkey(const ByteDataView &byte_data)
+    : data_(byte_data.data(), static_cast<uint32_t>(byte_data.size())) {
+  if (!Pubkey::IsValid(byte_data)) {
+    warn(CFD_LOG_SOURCE, "Invalid Pubkey data. hex={}.", data_.GetHex());
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid Pubkey data.");
+  }
+}
+
 Pubkey::Pubkey(const std::string &hex_string) : Pubkey(ByteData(hex_string)) {
   // do nothing
 }
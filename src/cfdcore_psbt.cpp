@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_address.h"
@@ -714,6 +715,10 @@ struct wally_psbt *MergePsbt(
       static_cast<const struct wally_psbt *>(src);
   const struct wally_psbt *psbt_dest =
       static_cast<const struct wally_psbt *>(dest);
+  if ((psbt_src == nullptr) || (psbt_dest == nullptr)) {
+    warn(CFD_LOG_SOURCE, "psbt pointer is null");
+    throw CfdException(kCfdIllegalStateError, "psbt pointer is null.");
+  }
 
   if ((psbt_src->tx == nullptr) ||
       (psbt_src->num_inputs != psbt_src->tx->num_inputs) ||
@@ -1897,8 +1902,23 @@ Psbt::Psbt(uint32_t psbt_version, const Transaction &transaction) {
   base_tx_ = RebuildTransaction(wally_psbt_pointer_);
 }
 
-Psbt::Psbt(const Psbt &psbt) : Psbt(psbt.GetData()) {
-  // copy constructor
+Psbt::Psbt(const Psbt &psbt)
+    : wally_psbt_pointer_(nullptr), base_tx_(psbt.base_tx_) {
+  struct wally_psbt *psbt_pointer = nullptr;
+  int ret = wally_psbt_clone_alloc(
+      static_cast<struct wally_psbt *>(psbt.wally_psbt_pointer_), 0,
+      &psbt_pointer);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_psbt_clone_alloc NG[{}]", ret);
+    throw CfdException(kCfdInternalError, "psbt clone error.");
+  }
+  wally_psbt_pointer_ = psbt_pointer;
+}
+
+Psbt::Psbt(Psbt &&psbt) noexcept
+    : wally_psbt_pointer_(psbt.wally_psbt_pointer_),
+      base_tx_(std::move(psbt.base_tx_)) {
+  psbt.wally_psbt_pointer_ = nullptr;
 }
 
 Psbt &Psbt::operator=(const Psbt &psbt) & {
@@ -1914,7 +1934,17 @@ Psbt &Psbt::operator=(const Psbt &psbt) & {
     }
     FreeWallyPsbtAddress(wally_psbt_pointer_);  // free
     wally_psbt_pointer_ = psbt_pointer;
-    base_tx_ = RebuildTransaction(wally_psbt_pointer_);
+    base_tx_ = psbt.base_tx_;
+  }
+  return *this;
+}
+
+Psbt &Psbt::operator=(Psbt &&psbt) & noexcept {
+  if (this != &psbt) {
+    FreeWallyPsbtAddress(wally_psbt_pointer_);  // free
+    wally_psbt_pointer_ = psbt.wally_psbt_pointer_;
+    psbt.wally_psbt_pointer_ = nullptr;
+    base_tx_ = std::move(psbt.base_tx_);
   }
   return *this;
 }
@@ -2191,6 +2221,10 @@ uint32_t Psbt::AddTxIn(const TxInReference &txin) {
 uint32_t Psbt::AddTxIn(const Txid &txid, uint32_t vout, uint32_t sequence) {
   struct wally_psbt *psbt_pointer;
   psbt_pointer = static_cast<struct wally_psbt *>(wally_psbt_pointer_);
+  if (psbt_pointer == nullptr) {
+    warn(CFD_LOG_SOURCE, "psbt pointer is null");
+    throw CfdException(kCfdIllegalStateError, "psbt pointer is null.");
+  }
   uint32_t index = static_cast<uint32_t>(psbt_pointer->num_inputs);
   struct wally_tx_input *input = nullptr;
   std::vector<uint8_t> txhash = txid.GetData().GetBytes();
@@ -2720,6 +2754,7 @@ std::vector<Pubkey> Psbt::GetTxInSignaturePubkeyList(uint32_t index) const {
 }
 
 ByteData Psbt::GetTxInSignature(uint32_t index, const Pubkey &pubkey) const {
+  CheckTxInIndex(index, __LINE__, __FUNCTION__);
   struct wally_psbt *psbt_pointer;
   psbt_pointer = static_cast<struct wally_psbt *>(wally_psbt_pointer_);
   auto key_vec = pubkey.GetData().GetBytes();
@@ -2887,6 +2922,10 @@ uint32_t Psbt::AddTxOut(const TxOutReference &txout) {
 uint32_t Psbt::AddTxOut(const Script &locking_script, const Amount &amount) {
   struct wally_psbt *psbt_pointer;
   psbt_pointer = static_cast<struct wally_psbt *>(wally_psbt_pointer_);
+  if (psbt_pointer == nullptr) {
+    warn(CFD_LOG_SOURCE, "psbt pointer is null");
+    throw CfdException(kCfdIllegalStateError, "psbt pointer is null.");
+  }
   uint32_t index = static_cast<uint32_t>(psbt_pointer->num_outputs);
   auto script = locking_script.GetData().GetBytes();
   struct wally_tx_output *output = nullptr;
@@ -3296,6 +3335,10 @@ bool Psbt::IsFindGlobalRecord(const ByteData &key) const {
 std::vector<ByteData> Psbt::GetGlobalRecordKeyList() const {
   struct wally_psbt *psbt_pointer;
   psbt_pointer = static_cast<struct wally_psbt *>(wally_psbt_pointer_);
+  if (psbt_pointer == nullptr) {
+    warn(CFD_LOG_SOURCE, "psbt pointer is null");
+    throw CfdException(kCfdIllegalStateError, "psbt pointer is null.");
+  }
   std::vector<ByteData> result;
   for (size_t idx = 0; idx < psbt_pointer->unknowns.num_items; ++idx) {
     auto item = &psbt_pointer->unknowns.items[idx];
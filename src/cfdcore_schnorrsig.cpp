@@ -29,21 +29,23 @@ SchnorrSignature::SchnorrSignature()
     : data_(), sighash_type_(SigHashAlgorithm::kSigHashDefault) {}
 
 SchnorrSignature::SchnorrSignature(const ByteData &data)
-    : data_(data), sighash_type_(SigHashAlgorithm::kSigHashDefault) {
-  if (data_.GetDataSize() == SchnorrSignature::kSchnorrSignatureSize + 1) {
-    auto bytes = data.GetBytes();
-    uint8_t sighash_type = bytes[SchnorrSignature::kSchnorrSignatureSize];
+    : SchnorrSignature(ByteDataView(data)) {}
+
+SchnorrSignature::SchnorrSignature(const ByteDataView &data)
+    : data_(), sighash_type_(SigHashAlgorithm::kSigHashDefault) {
+  if (data.size() == SchnorrSignature::kSchnorrSignatureSize + 1) {
+    uint8_t sighash_type = data.data()[SchnorrSignature::kSchnorrSignatureSize];
     if ((sighash_type == 0) || (!IsValidSigHashType(sighash_type))) {
       throw CfdException(
           CfdError::kCfdIllegalArgumentError,
           "Invalid Schnorr signature hash type.");
     }
     sighash_type_.SetFromSigHashFlag(sighash_type);
-    data_ = ByteData(bytes.data(), SchnorrSignature::kSchnorrSignatureSize);
-  } else if (data_.GetDataSize() != SchnorrSignature::kSchnorrSignatureSize) {
+  } else if (data.size() != SchnorrSignature::kSchnorrSignatureSize) {
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "Invalid Schnorr signature data.");
   }
+  data_ = ByteData(data.data(), SchnorrSignature::kSchnorrSignatureSize);
 }
 
 SchnorrSignature::SchnorrSignature(const std::string &data)
@@ -402,15 +404,11 @@ Pubkey SchnorrUtil::ComputeSigPointBatch(
     rs = Pubkey::CombinePubkey(pub_nonces);
   }
 
-  auto bip340_challenge = ByteData(
-      "7bb52d7a9fef58323eb1bf7a407db382d2f3f2d81bb1224f49fe518f6d48d37c7bb52d7"
-      "a9fef58323eb1bf7a407db382d2f3f2d81bb1224f49fe518f6d48d37c");
   Privkey res;
   for (size_t i = 0; i < msgs.size(); i++) {
-    auto m_tagged_hash =
-        HashUtil::Sha256(bip340_challenge.Concat(nonces[i].GetData())
-                             .Concat(pubkey.GetData())
-                             .Concat(msgs[i]));
+    auto m_tagged_hash = (HashUtil::CreateTaggedHash(kTagBip340Challenge)
+                          << nonces[i].GetData() << pubkey.GetData() << msgs[i])
+                             .Output256();
     if (i == 0) {
       res = Privkey(m_tagged_hash);
     } else {
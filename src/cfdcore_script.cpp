@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <set>
@@ -791,6 +792,13 @@ Script::Script(const ByteData& bytedata)
   SetStackData(bytedata);
 }
 
+Script::Script(const ByteDataView& bytedata)
+    : script_data_(
+          bytedata.data(), static_cast<uint32_t>(bytedata.size())),
+      script_stack_() {
+  SetStackData(script_data_);
+}
+
 Script::Script(const Script& object) {
   script_data_ = object.script_data_;
   script_stack_ = object.script_stack_;
@@ -1021,7 +1029,9 @@ ScriptHash Script::GetWitnessScriptHash() const {
   return ScriptHash(*this, true);
 }
 
-const ByteData Script::GetData() const { return script_data_; }
+const ByteData& Script::GetData() const& { return script_data_; }
+
+ByteData Script::GetData() const&& { return script_data_; }
 
 const std::string Script::GetHex() const { return script_data_.GetHex(); }
 
@@ -1031,6 +1041,22 @@ bool Script::Equals(const Script& object) const {
   return script_data_.Equals(object.script_data_);
 }
 
+bool Script::operator==(const Script& object) const { return Equals(object); }
+
+bool Script::operator!=(const Script& object) const { return !Equals(object); }
+
+bool Script::operator<(const Script& object) const {
+  const size_t size = script_data_.size();
+  const size_t target_size = object.script_data_.size();
+  const size_t compare_size = (size < target_size) ? size : target_size;
+  if (compare_size != 0) {
+    int result = memcmp(
+        script_data_.data(), object.script_data_.data(), compare_size);
+    if (result != 0) return result < 0;
+  }
+  return size < target_size;
+}
+
 std::vector<ScriptElement> Script::GetElementList() const {
   return script_stack_;
 }
@@ -1654,5 +1680,47 @@ std::vector<Pubkey> ScriptUtil::ExtractPubkeysFromMultisigScript(
   return pubkeys;
 }
 
+namespace {
+
+/**
+ * @brief Mix the 64bit value. (murmur3 finalizer)
+ * @param[in] value   value
+ * @return mixed value
+ */
+inline uint64_t MixScriptHashValue(uint64_t value) {
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+}  // namespace
+
 }  // namespace core
 }  // namespace cfd
+
+namespace std {
+
+size_t hash<cfd::core::Script>::operator()(
+    const cfd::core::Script &script) const {
+  const cfd::core::ByteData &data = script.GetData();
+  const uint8_t *bytes = data.data();
+  const size_t size = data.size();
+  uint64_t value = cfd::core::MixScriptHashValue(size);
+  size_t offset = 0;
+  for (; offset + 8 <= size; offset += 8) {
+    uint64_t word;
+    memcpy(&word, bytes + offset, sizeof(word));
+    value = cfd::core::MixScriptHashValue(value ^ word);
+  }
+  if (offset < size) {
+    uint64_t word = 0;
+    memcpy(&word, bytes + offset, size - offset);
+    value = cfd::core::MixScriptHashValue(value ^ word);
+  }
+  return static_cast<size_t>(value);
+}
+
+}  // namespace std
@@ -79,10 +79,8 @@ TapBranch& TapBranch::operator=(const TapBranch& object) {
 ByteData256 TapBranch::GetBaseHash() const {
   if (!has_leaf_) return root_commitment_;
 
-  static auto kTaggedHash = HashUtil::Sha256("TapLeaf");
-  return (HashUtil(HashUtil::kSha256)
-          << kTaggedHash << kTaggedHash << ByteData(leaf_version_)
-          << script_.GetData().Serialize())
+  return (HashUtil::CreateTaggedHash(kTagTapLeaf)
+          << ByteData(leaf_version_) << script_.GetData().Serialize())
       .Output256();
 }
 
@@ -94,13 +92,11 @@ ByteData256 TapBranch::GetBranchHash(uint8_t depth) const {
   ByteData256 hash = GetBaseHash();
   if (branch_list_.empty()) return hash;
 
-  static auto kTaggedHash = HashUtil::Sha256("TapBranch");
-  ByteData tapbranch_base = kTaggedHash.Concat(kTaggedHash);
   auto nodes = GetNodeList();
   uint8_t index = 0;
   for (const auto& node : nodes) {
     if (index > depth) break;
-    auto hasher = HashUtil(HashUtil::kSha256) << tapbranch_base;
+    auto hasher = HashUtil::CreateTaggedHash(kTagTapBranch);
     const auto& node_bytes = node.GetBytes();
     const auto& hash_bytes = hash.GetBytes();
     if (std::lexicographical_compare(
@@ -158,11 +154,8 @@ std::string TapBranch::ToString() const {
   if (branch_list_.empty()) return buf;
 
   ByteData256 hash = GetBaseHash();
-  static auto kTaggedHash = HashUtil::Sha256("TapBranch");
-  ByteData tapbranch_base = kTaggedHash.Concat(kTaggedHash);
-  auto nodes = GetNodeList();
   for (const auto& branch : branch_list_) {
-    auto hasher = HashUtil(HashUtil::kSha256) << tapbranch_base;
+    auto hasher = HashUtil::CreateTaggedHash(kTagTapBranch);
     const auto node = branch.GetCurrentBranchHash();
     const auto& node_bytes = node.GetBytes();
     const auto& hash_bytes = hash.GetBytes();
@@ -415,9 +408,8 @@ TapBranch TapBranch::FromString(const std::string& text) {
 ByteData256 TapBranch::GetTapTweak(
     const SchnorrPubkey& internal_pubkey) const {
   ByteData256 hash = GetCurrentBranchHash();
-  static auto kTaggedHash = HashUtil::Sha256("TapTweak");
-  auto hasher = HashUtil(HashUtil::kSha256)
-                << kTaggedHash << kTaggedHash << internal_pubkey.GetData();
+  auto hasher = HashUtil::CreateTaggedHash(kTagTapTweak)
+                << internal_pubkey.GetData();
   if (!hash.IsEmpty()) hasher << hash;
   return hasher.Output256();
 }
@@ -6,8 +6,13 @@
  */
 #include "cfdcore/cfdcore_transaction.h"
 
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -31,6 +36,30 @@ using logger::warn;
 /// Minimum Hex size of Transaction
 static constexpr size_t kTransactionMinimumHexSize =
     AbstractTransaction::kTransactionMinimumSize * 2;
+/// TxIn / TxOut count from which lookups use the hash index
+static constexpr size_t kTxIndexMinimumCount = 16;
+
+// -----------------------------------------------------------------------------
+// Internal file functions
+// -----------------------------------------------------------------------------
+/**
+ * @brief Compare the amount and locking script of two utxo lists.
+ * @param[in] lhs   utxo list
+ * @param[in] rhs   utxo list
+ * @retval true   same list
+ * @retval false  different list
+ */
+static bool IsSameUtxoList(
+    const std::vector<TxOut> &lhs, const std::vector<TxOut> &rhs) {
+  if (lhs.size() != rhs.size()) return false;
+  for (size_t index = 0; index < lhs.size(); ++index) {
+    if ((lhs[index].GetValue() != rhs[index].GetValue()) ||
+        (lhs[index].GetLockingScript() != rhs[index].GetLockingScript())) {
+      return false;
+    }
+  }
+  return true;
+}
 
 // -----------------------------------------------------------------------------
 // TxOut
@@ -48,6 +77,16 @@ TxOut::TxOut(const Amount &value, const Address &address)
     : AbstractTxOut(value, address.GetLockingScript()) {
   // do nothing
 }
+
+TxOut::TxOut(const TxOut &object) : AbstractTxOut(object) {
+  // do nothing
+}
+
+TxOut &TxOut::operator=(const TxOut &object) & {
+  AbstractTxOut::operator=(object);
+  return *this;
+}
+
 // -----------------------------------------------------------------------------
 // TxOutReference
 // -----------------------------------------------------------------------------
@@ -56,6 +95,16 @@ TxOutReference::TxOutReference(const TxOut &tx_out)
   // do nothing
 }
 
+TxOutReference::TxOutReference(const TxOutReference &object)
+    : AbstractTxOutReference(object) {
+  // do nothing
+}
+
+TxOutReference &TxOutReference::operator=(const TxOutReference &object) & {
+  AbstractTxOutReference::operator=(object);
+  return *this;
+}
+
 // -----------------------------------------------------------------------------
 // TxIn
 // -----------------------------------------------------------------------------
@@ -71,6 +120,15 @@ TxIn::TxIn(
   // do nothing
 }
 
+TxIn::TxIn(const TxIn &object) : AbstractTxIn(object) {
+  // do nothing
+}
+
+TxIn &TxIn::operator=(const TxIn &object) & {
+  AbstractTxIn::operator=(object);
+  return *this;
+}
+
 uint32_t TxIn::EstimateTxInSize(
     AddressType addr_type, Script redeem_script, uint32_t *witness_area_size,
     uint32_t *no_witness_area_size, const Script *scriptsig_template) {
@@ -192,6 +250,95 @@ TxInReference::TxInReference(const TxIn &tx_in)
   // do nothing
 }
 
+TxInReference::TxInReference(const TxInReference &object)
+    : AbstractTxInReference(object) {
+  // do nothing
+}
+
+TxInReference &TxInReference::operator=(const TxInReference &object) & {
+  AbstractTxInReference::operator=(object);
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+// TaprootSigHashContext
+// -----------------------------------------------------------------------------
+TaprootSigHashContext::TaprootSigHashContext()
+    : utxo_list_(), txin_count_(0), txout_count_(0), generation_(0) {
+  // do nothing
+}
+
+TaprootSigHashContext::TaprootSigHashContext(
+    const Transaction &transaction, const std::vector<TxOut> &utxo_list)
+    : utxo_list_(utxo_list),
+      txin_count_(transaction.GetTxInCount()),
+      txout_count_(transaction.GetTxOutCount()),
+      generation_(transaction.sighash_generation_) {
+  if (txin_count_ > utxo_list.size()) {
+    warn(CFD_LOG_SOURCE, "not enough utxo list.");
+    throw CfdException(kCfdIllegalArgumentError, "not enough utxo list.");
+  }
+
+  Serializer prevouts_buf(txin_count_ * 36);
+  Serializer amounts_buf(txin_count_ * 8);
+  Serializer scripts_buf;
+  Serializer sequences_buf(txin_count_ * 4);
+  uint32_t index = 0;
+  for (const auto &txin : transaction.GetTxInList()) {
+    prevouts_buf.AddDirectBytes(txin.GetTxid().GetData());
+    prevouts_buf.AddDirectNumber(txin.GetVout());
+    amounts_buf.AddDirectNumber(utxo_list[index].GetValue().GetSatoshiValue());
+    scripts_buf.AddVariableBuffer(
+        utxo_list[index].GetLockingScript().GetData());
+    sequences_buf.AddDirectNumber(txin.GetSequence());
+    ++index;
+  }
+  sha_prevouts_ = HashUtil::Sha256(prevouts_buf.Output());
+  sha_amounts_ = HashUtil::Sha256(amounts_buf.Output());
+  sha_scriptpubkeys_ = HashUtil::Sha256(scripts_buf.Output());
+  sha_sequences_ = HashUtil::Sha256(sequences_buf.Output());
+
+  Serializer outputs_buf;
+  for (const auto &txout : transaction.GetTxOutList()) {
+    outputs_buf.AddDirectNumber(txout.GetValue().GetSatoshiValue());
+    outputs_buf.AddVariableBuffer(txout.GetLockingScript().GetData());
+  }
+  sha_outputs_ = HashUtil::Sha256(outputs_buf.Output());
+}
+
+const std::vector<TxOut> &TaprootSigHashContext::GetUtxoList() const {
+  return utxo_list_;
+}
+
+uint32_t TaprootSigHashContext::GetTxInCount() const { return txin_count_; }
+
+uint32_t TaprootSigHashContext::GetTxOutCount() const { return txout_count_; }
+
+const ByteData256 &TaprootSigHashContext::GetShaPrevouts() const {
+  return sha_prevouts_;
+}
+
+const ByteData256 &TaprootSigHashContext::GetShaAmounts() const {
+  return sha_amounts_;
+}
+
+const ByteData256 &TaprootSigHashContext::GetShaScriptPubkeys() const {
+  return sha_scriptpubkeys_;
+}
+
+const ByteData256 &TaprootSigHashContext::GetShaSequences() const {
+  return sha_sequences_;
+}
+
+const ByteData256 &TaprootSigHashContext::GetShaOutputs() const {
+  return sha_outputs_;
+}
+
+bool TaprootSigHashContext::IsMatch(const Transaction &transaction) const {
+  return (generation_ != 0) &&
+         (generation_ == transaction.sighash_generation_);
+}
+
 // -----------------------------------------------------------------------------
 // Transaction
 // -----------------------------------------------------------------------------
@@ -201,14 +348,21 @@ Transaction::Transaction() : Transaction(2, static_cast<uint32_t>(0)) {
 
 Transaction::Transaction(int32_t version, uint32_t lock_time)
     : vin_(), vout_() {
-  struct wally_tx *tx_pointer = NULL;
-  int ret = wally_tx_init_alloc(version, lock_time, 0, 0, &tx_pointer);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_init_alloc NG[{}] ", ret);
-    throw CfdException(
-        kCfdIllegalArgumentError, "transaction data generate error.");
+  wally_tx_pointer_ = AllocateWallyAddress(version, lock_time);
+}
+
+Transaction::Transaction(
+    int32_t version, uint32_t lock_time, const std::vector<TxIn> &txin_list,
+    const std::vector<TxOut> &txout_list)
+    : Transaction(version, lock_time) {
+  if ((txin_list.size() > std::numeric_limits<uint32_t>::max()) ||
+      (txout_list.size() > std::numeric_limits<uint32_t>::max())) {
+    warn(CFD_LOG_SOURCE, "txin or txout maximum.");
+    throw CfdException(kCfdIllegalArgumentError, "txin or txout maximum.");
   }
-  wally_tx_pointer_ = tx_pointer;
+  vin_ = txin_list;
+  vout_ = txout_list;
+  is_wally_tx_stale_ = true;
 }
 
 Transaction::Transaction(const std::string &hex_string) : vin_(), vout_() {
@@ -216,12 +370,42 @@ Transaction::Transaction(const std::string &hex_string) : vin_(), vout_() {
 }
 
 Transaction::Transaction(const ByteData &byte_data) : vin_(), vout_() {
-  SetFromHex(byte_data.GetHex());
+  SetFromBytes(byte_data.data(), byte_data.size());
+}
+
+Transaction::Transaction(const ByteDataView &byte_data) : vin_(), vout_() {
+  SetFromBytes(byte_data.data(), byte_data.size());
 }
 
 Transaction::Transaction(const Transaction &transaction)
-    : Transaction(transaction.GetHex()) {
-  // copy constructor
+    : vin_(transaction.vin_), vout_(transaction.vout_), index_cache_() {
+  // the lookup index is rebuilt on demand rather than copied.
+  std::lock_guard<std::mutex> lock(transaction.cache_mutex_);
+  wally_tx_pointer_ = CloneWallyAddress(transaction.wally_tx_pointer_);
+  sighash_cache_ = transaction.sighash_cache_;
+  sighash_generation_ = transaction.sighash_generation_;
+  is_wally_tx_stale_ = transaction.is_wally_tx_stale_;
+  metrics_cache_ = transaction.metrics_cache_;
+}
+
+Transaction::Transaction(Transaction &&transaction) noexcept
+    : vin_(std::move(transaction.vin_)),
+      vout_(std::move(transaction.vout_)),
+      sighash_cache_(std::move(transaction.sighash_cache_)),
+      index_cache_(std::move(transaction.index_cache_)),
+      is_wally_tx_stale_(transaction.is_wally_tx_stale_) {
+  sighash_generation_ = transaction.sighash_generation_;
+  transaction.sighash_generation_ = CreateSigHashGeneration();
+  // the source keeps no libwally tx. see PrepareWallyTxAddress.
+  wally_tx_pointer_ = transaction.wally_tx_pointer_;
+  transaction.wally_tx_pointer_ = nullptr;
+  metrics_cache_ = transaction.metrics_cache_;
+  transaction.vin_.clear();
+  transaction.vout_.clear();
+  transaction.sighash_cache_ = SigHashCache();
+  transaction.index_cache_ = TxIndexCache();
+  transaction.is_wally_tx_stale_ = false;
+  transaction.metrics_cache_ = MetricsCache();
 }
 
 bool Transaction::CheckTxOutBuffer(
@@ -290,6 +474,17 @@ bool Transaction::CheckTxOutBuffer(
 }
 
 void Transaction::SetFromHex(const std::string &hex_string) {
+  std::vector<uint8_t> tx_buf;
+  try {
+    tx_buf = StringUtil::StringToByte(hex_string);
+  } catch (const CfdException &except) {
+    warn(CFD_LOG_SOURCE, "hex decode NG. ({})", std::string(except.what()));
+    throw CfdException(kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  SetFromBytes(tx_buf.data(), tx_buf.size());
+}
+
+void Transaction::SetFromBytes(const uint8_t *buffer, size_t buffer_size) {
   void *original_address = wally_tx_pointer_;
   bool append_txout = false;
   std::vector<TxIn> vin_work;
@@ -298,10 +493,10 @@ void Transaction::SetFromHex(const std::string &hex_string) {
   // It is assumed that tx information has been created.
   // (If it is not created, it will cause inconsistency)
   struct wally_tx *tx_pointer = NULL;
-  int ret = wally_tx_from_hex(hex_string.c_str(), 0, &tx_pointer);
+  int ret = wally_tx_from_bytes(buffer, buffer_size, 0, &tx_pointer);
   if (ret == WALLY_OK) {
     if ((tx_pointer->num_inputs == 0) && (tx_pointer->num_outputs == 0) &&
-        (hex_string.size() > kTransactionMinimumHexSize)) {
+        (buffer_size > kTransactionMinimumSize)) {
       // Judged as an invalid analysis condition when txin is 0 and txout is 1,
       // and enters the exception route
       // (libwally misidentifies as witness tx)
@@ -312,12 +507,10 @@ void Transaction::SetFromHex(const std::string &hex_string) {
   }
 
   if (ret == WALLY_EINVAL) {
-    ByteData tx_byte = StringUtil::StringToByte(hex_string);
-    const std::vector<uint8_t> &tx_buf = tx_byte.GetBytes();
-    const uint8_t *address_pointer = tx_buf.data();
+    const uint8_t *address_pointer = buffer;
 
     // If the minimum size, perform analysis
-    if (hex_string.size() >= kTransactionMinimumHexSize) {
+    if (buffer_size >= kTransactionMinimumSize) {
       uint32_t version = 0;
       uint32_t lock_time = 0;
       memcpy(&version, address_pointer, sizeof(version));
@@ -329,7 +522,7 @@ void Transaction::SetFromHex(const std::string &hex_string) {
         // txin is 0 or marker is 0
         ++address_pointer;
         if ((*address_pointer == 0) &&
-            (hex_string.size() == kTransactionMinimumHexSize)) {
+            (buffer_size == kTransactionMinimumSize)) {
           // txout is 0
           ++address_pointer;
           memcpy(&lock_time, address_pointer, sizeof(lock_time));
@@ -342,13 +535,12 @@ void Transaction::SetFromHex(const std::string &hex_string) {
           info(CFD_LOG_SOURCE, "call wally_tx_init_alloc");
         } else {
           // Check remaining size and check if txin is 0 and txout is 1 or more
-          const uint8_t *start_address = tx_buf.data();
-          size_t size = address_pointer - start_address;
+          size_t size = address_pointer - buffer;
           uint64_t txout_num = 0;
           size_t num_size = 0;
           // Subtract the size up to the txout area and the locktime
           // from the txbuf size.
-          size_t buf_size = tx_buf.size() - size - sizeof(uint32_t);
+          size_t buf_size = buffer_size - size - sizeof(uint32_t);
           if (!GetVariableInt(
                   address_pointer, buf_size, &txout_num, &num_size)) {
             // Invalid
@@ -380,7 +572,7 @@ void Transaction::SetFromHex(const std::string &hex_string) {
   }
 
   if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_from_hex NG[{}] ", ret);
+    warn(CFD_LOG_SOURCE, "wally_tx_from_bytes NG[{}] ", ret);
     throw CfdException(kCfdIllegalArgumentError, "transaction data invalid.");
   }
   wally_tx_pointer_ = tx_pointer;
@@ -440,6 +632,11 @@ void Transaction::SetFromHex(const std::string &hex_string) {
     }
     vin_ = vin_work;
     vout_ = vout_work;
+    sighash_cache_ = SigHashCache();
+    sighash_generation_ = CreateSigHashGeneration();
+    index_cache_ = TxIndexCache();
+    is_wally_tx_stale_ = false;
+    metrics_cache_ = MetricsCache();
   } catch (const CfdException &exception) {
     // free on error
     wally_tx_free(tx_pointer);
@@ -455,48 +652,93 @@ void Transaction::SetFromHex(const std::string &hex_string) {
 
 Transaction &Transaction::operator=(const Transaction &transaction) & {
   if (this != &transaction) {
-    SetFromHex(transaction.GetHex());
+    std::vector<TxIn> vin_work = transaction.vin_;
+    std::vector<TxOut> vout_work = transaction.vout_;
+    std::lock_guard<std::mutex> lock(transaction.cache_mutex_);
+    void *tx_pointer = CloneWallyAddress(transaction.wally_tx_pointer_);
+    FreeWallyAddress(wally_tx_pointer_);
+    wally_tx_pointer_ = tx_pointer;
+    vin_.swap(vin_work);
+    vout_.swap(vout_work);
+    sighash_cache_ = transaction.sighash_cache_;
+    sighash_generation_ = transaction.sighash_generation_;
+    index_cache_ = TxIndexCache();
+    is_wally_tx_stale_ = transaction.is_wally_tx_stale_;
+    metrics_cache_ = transaction.metrics_cache_;
+  }
+  return *this;
+}
+
+Transaction &Transaction::operator=(Transaction &&transaction) & noexcept {
+  if (this != &transaction) {
+    // the source keeps no libwally tx. see PrepareWallyTxAddress.
+    FreeWallyAddress(wally_tx_pointer_);
+    wally_tx_pointer_ = transaction.wally_tx_pointer_;
+    transaction.wally_tx_pointer_ = nullptr;
+    vin_ = std::move(transaction.vin_);
+    vout_ = std::move(transaction.vout_);
+    sighash_cache_ = std::move(transaction.sighash_cache_);
+    sighash_generation_ = transaction.sighash_generation_;
+    index_cache_ = std::move(transaction.index_cache_);
+    is_wally_tx_stale_ = transaction.is_wally_tx_stale_;
+    metrics_cache_ = transaction.metrics_cache_;
+    transaction.vin_.clear();
+    transaction.vout_.clear();
+    transaction.sighash_cache_ = SigHashCache();
+    transaction.sighash_generation_ = CreateSigHashGeneration();
+    transaction.index_cache_ = TxIndexCache();
+    transaction.is_wally_tx_stale_ = false;
+    transaction.metrics_cache_ = MetricsCache();
   }
   return *this;
 }
 
 uint32_t Transaction::GetTotalSize() const {
-  size_t length = 0;
-  struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
-  // If both input / output are 0, libwally misidentifies as ElementsTransaction
-  if ((tx_pointer->num_inputs == 0) && (tx_pointer->num_outputs == 0)) {
-    length = static_cast<size_t>(kTransactionMinimumSize);
-  } else {
-    length = AbstractTransaction::GetTotalSize();
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (metrics_cache_.has_total_size) return metrics_cache_.total_size;
   }
-  return static_cast<uint32_t>(length);
+  uint32_t length = GetSerializeSize(true);
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  metrics_cache_.total_size = length;
+  metrics_cache_.has_total_size = true;
+  return length;
 }
 
 uint32_t Transaction::GetVsize() const {
-  size_t vsize = 0;
-  struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
-  // If both input / output are 0, libwally misidentifies as ElementsTransaction
-  if ((tx_pointer->num_inputs == 0) && (tx_pointer->num_outputs == 0)) {
-    vsize = static_cast<size_t>(kTransactionMinimumSize);
-  } else {
-    vsize = AbstractTransaction::GetVsize();
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (metrics_cache_.has_vsize) return metrics_cache_.vsize;
   }
-  return static_cast<uint32_t>(vsize);
+  uint32_t vsize = (GetWeight() + 3) / 4;
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  metrics_cache_.vsize = vsize;
+  metrics_cache_.has_vsize = true;
+  return vsize;
 }
 
 uint32_t Transaction::GetWeight() const {
-  size_t weight = 0;
-  struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
-  // If both input / output are 0, libwally misidentifies as ElementsTransaction
-  if ((tx_pointer->num_inputs == 0) && (tx_pointer->num_outputs == 0)) {
-    weight = static_cast<size_t>(kTransactionMinimumSize) * 4;
-  } else {
-    weight = AbstractTransaction::GetWeight();
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (metrics_cache_.has_weight) return metrics_cache_.weight;
+  }
+  uint32_t weight = GetSerializeSize(false) * 3 + GetTotalSize();
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  metrics_cache_.weight = weight;
+  metrics_cache_.has_weight = true;
+  return weight;
+}
+
+Amount Transaction::GetValueOut() const {
+  Amount total = Amount::CreateBySatoshiAmount(0);
+  for (const auto &txout : vout_) {
+    total += txout.GetValue();
   }
-  return static_cast<uint32_t>(weight);
+  return total;
+}
+
+bool Transaction::IsCoinBase() const {
+  return (vin_.size() == 1) && vin_[0].IsCoinBase();
 }
 
 const TxInReference Transaction::GetTxIn(uint32_t index) const {
@@ -505,38 +747,44 @@ const TxInReference Transaction::GetTxIn(uint32_t index) const {
 }
 
 uint32_t Transaction::GetTxInIndex(const Txid &txid, uint32_t vout) const {
-  for (size_t i = 0; i < vin_.size(); ++i) {
-    if (vin_[i].GetTxid().Equals(txid) && vin_[i].GetVout() == vout) {
-      return static_cast<uint32_t>(i);
+  if (vin_.size() < kTxIndexMinimumCount) {
+    for (size_t i = 0; i < vin_.size(); ++i) {
+      if (vin_[i].GetTxid().Equals(txid) && vin_[i].GetVout() == vout) {
+        return static_cast<uint32_t>(i);
+      }
     }
+  } else {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (!index_cache_.has_txin_index) {
+      index_cache_.txin_index.clear();
+      index_cache_.txin_index.reserve(vin_.size());
+      for (size_t i = 0; i < vin_.size(); ++i) {
+        // emplace keeps the first index, same as the linear search.
+        index_cache_.txin_index.emplace(
+            vin_[i].GetOutPoint(), static_cast<uint32_t>(i));
+      }
+      index_cache_.has_txin_index = true;
+    }
+    const auto ite = index_cache_.txin_index.find(OutPoint(txid, vout));
+    if (ite != index_cache_.txin_index.end()) return ite->second;
   }
   warn(CFD_LOG_SOURCE, "Txid is not found.");
   throw CfdException(kCfdIllegalArgumentError, "Txid is not found.");
 }
 
 uint32_t Transaction::GetTxOutIndex(const Script &locking_script) const {
-  std::string search_str = locking_script.GetHex();
-  uint32_t index = 0;
-  for (; index < static_cast<uint32_t>(vout_.size()); ++index) {
-    std::string script = vout_[index].GetLockingScript().GetHex();
-    if (script == search_str) {
-      return index;
-    }
+  std::vector<uint32_t> index_list = FindTxOutIndexList(locking_script);
+  if (index_list.empty()) {
+    warn(CFD_LOG_SOURCE, "locking script is not found.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "locking script is not found.");
   }
-  warn(CFD_LOG_SOURCE, "locking script is not found.");
-  throw CfdException(kCfdIllegalArgumentError, "locking script is not found.");
+  return index_list[0];
 }
 
 std::vector<uint32_t> Transaction::GetTxOutIndexList(
     const Script &locking_script) const {
-  std::vector<uint32_t> result;
-  std::string search_str = locking_script.GetHex();
-  uint32_t index = 0;
-  for (; index < static_cast<uint32_t>(vout_.size()); ++index) {
-    if (search_str == vout_[index].GetLockingScript().GetHex()) {
-      result.push_back(index);
-    }
-  }
+  std::vector<uint32_t> result = FindTxOutIndexList(locking_script);
   if (result.empty()) {
     warn(CFD_LOG_SOURCE, "locking script is not found.");
     throw CfdException(
@@ -565,7 +813,6 @@ uint32_t Transaction::AddTxIn(
     throw CfdException(kCfdIllegalStateError, "txin maximum.");
   }
 
-  AbstractTransaction::AddTxIn(txid, index, sequence, unlocking_script);
   TxIn txin(txid, index, sequence);
   if (!unlocking_script.IsEmpty()) {
     txin = TxIn(txid, index, sequence, unlocking_script);
@@ -577,8 +824,22 @@ uint32_t Transaction::AddTxIn(
   return static_cast<uint32_t>(vin_.size() - 1);
 }
 
+uint32_t Transaction::AddTxInList(const std::vector<TxIn> &txin_list) {
+  if (txin_list.size() >
+      std::numeric_limits<uint32_t>::max() - vin_.size()) {
+    warn(CFD_LOG_SOURCE, "vin maximum.");
+    throw CfdException(kCfdIllegalStateError, "txin maximum.");
+  }
+  uint32_t first_index = static_cast<uint32_t>(vin_.size());
+  if (txin_list.empty()) return first_index;
+
+  vin_.insert(vin_.end(), txin_list.begin(), txin_list.end());
+  CallbackStateChange(kStateChangeAddTxIn);
+  return first_index;
+}
+
 void Transaction::RemoveTxIn(uint32_t index) {
-  AbstractTransaction::RemoveTxIn(index);
+  CheckTxInIndex(index, __LINE__, __FUNCTION__);
 
   std::vector<TxIn>::const_iterator ite = vin_.cbegin();
   if (index != 0) {
@@ -589,24 +850,32 @@ void Transaction::RemoveTxIn(uint32_t index) {
 }
 
 void Transaction::SetTxInSequence(uint32_t tx_in_index, uint32_t sequence) {
-  AbstractTransaction::SetTxInSequence(tx_in_index, sequence);
+  CheckTxInIndex(tx_in_index, __LINE__, __FUNCTION__);
   vin_[tx_in_index].SetSequence(sequence);
   CallbackStateChange(kStateChangeUpdateTxIn);
 }
 
 void Transaction::SetUnlockingScript(
     uint32_t tx_in_index, const Script &unlocking_script) {
-  AbstractTransaction::SetUnlockingScript(tx_in_index, unlocking_script);
+  CheckTxInIndex(tx_in_index, __LINE__, __FUNCTION__);
+  if (!unlocking_script.IsPushOnly()) {
+    warn(CFD_LOG_SOURCE, "IsPushOnly() false.");
+    throw CfdException(
+        kCfdIllegalArgumentError,
+        "unlocking script error. "
+        "The script needs to be push operator only.");
+  }
   vin_[tx_in_index].SetUnlockingScript(unlocking_script);
   CallbackStateChange(kStateChangeUpdateSignTxIn);
 }
 
 void Transaction::SetUnlockingScript(
     uint32_t tx_in_index, const std::vector<ByteData> &unlocking_script) {
-  Script generate_unlocking_script =
-      AbstractTransaction::SetUnlockingScript(tx_in_index, unlocking_script);
-  vin_[tx_in_index].SetUnlockingScript(generate_unlocking_script);
-  CallbackStateChange(kStateChangeUpdateSignTxIn);
+  ScriptBuilder builder;
+  for (const ByteData &script : unlocking_script) {
+    builder.AppendData(script);
+  }
+  SetUnlockingScript(tx_in_index, builder.Build());
 }
 
 uint32_t Transaction::GetScriptWitnessStackNum(uint32_t tx_in_index) const {
@@ -640,7 +909,7 @@ const ScriptWitness Transaction::AddScriptWitnessStack(
 
 const ScriptWitness Transaction::AddScriptWitnessStack(
     uint32_t tx_in_index, const std::vector<uint8_t> &data) {
-  AbstractTransaction::AddScriptWitnessStack(tx_in_index, data);
+  CheckTxInIndex(tx_in_index, __LINE__, __FUNCTION__);
 
   const ScriptWitness &witness =
       vin_[tx_in_index].AddScriptWitnessStack(ByteData(data));
@@ -675,7 +944,11 @@ const ScriptWitness Transaction::SetScriptWitnessStack(
 const ScriptWitness Transaction::SetScriptWitnessStack(
     uint32_t tx_in_index, uint32_t witness_index,
     const std::vector<uint8_t> &data) {
-  AbstractTransaction::SetScriptWitnessStack(tx_in_index, witness_index, data);
+  CheckTxInIndex(tx_in_index, __LINE__, __FUNCTION__);
+  if (vin_[tx_in_index].GetScriptWitnessStackNum() == 0) {
+    warn(CFD_LOG_SOURCE, "witness is empty.");
+    throw CfdException(kCfdIllegalStateError, "witness stack set error.");
+  }
 
   const ScriptWitness &witness =
       vin_[tx_in_index].SetScriptWitnessStack(witness_index, ByteData(data));
@@ -684,7 +957,7 @@ const ScriptWitness Transaction::SetScriptWitnessStack(
 }
 
 void Transaction::RemoveScriptWitnessStackAll(uint32_t tx_in_index) {
-  AbstractTransaction::RemoveScriptWitnessStackAll(tx_in_index);
+  CheckTxInIndex(tx_in_index, __LINE__, __FUNCTION__);
 
   vin_[tx_in_index].RemoveScriptWitnessStackAll();
   CallbackStateChange(kStateChangeUpdateSignTxIn);
@@ -714,30 +987,39 @@ uint32_t Transaction::AddTxOut(
     throw CfdException(kCfdIllegalStateError, "vout maximum.");
   }
 
-  AbstractTransaction::AddTxOut(value, locking_script);
-
   TxOut out(value, locking_script);
   vout_.push_back(out);
   CallbackStateChange(kStateChangeAddTxOut);
   return static_cast<uint32_t>(vout_.size() - 1);
 }
 
-void Transaction::SetTxOutValue(uint32_t index, const Amount &value) {
-  CheckTxOutIndex(index, __LINE__, __FUNCTION__);
+uint32_t Transaction::AddTxOutList(const std::vector<TxOut> &txout_list) {
+  if (txout_list.size() >
+      std::numeric_limits<uint32_t>::max() - vout_.size()) {
+    warn(CFD_LOG_SOURCE, "vout maximum.");
+    throw CfdException(kCfdIllegalStateError, "vout maximum.");
+  }
+  uint32_t first_index = static_cast<uint32_t>(vout_.size());
+  if (txout_list.empty()) return first_index;
 
-  struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
-  if (tx_pointer != nullptr) {
-    struct wally_tx_output *output = tx_pointer->outputs + index;
-    output->satoshi = static_cast<uint64_t>(value.GetSatoshiValue());
+  vout_.insert(vout_.end(), txout_list.begin(), txout_list.end());
+  CallbackStateChange(kStateChangeAddTxOut);
+  return first_index;
+}
 
-    vout_[index].SetValue(value);
-    // CallbackStateChange(kStateChangeAddTxOut);
-  }
+void Transaction::Reserve(uint32_t txin_count, uint32_t txout_count) {
+  vin_.reserve(txin_count);
+  vout_.reserve(txout_count);
+}
+
+void Transaction::SetTxOutValue(uint32_t index, const Amount &value) {
+  CheckTxOutIndex(index, __LINE__, __FUNCTION__);
+  vout_[index].SetValue(value);
+  CallbackStateChange(kStateChangeUpdateTxOut);
 }
 
 void Transaction::RemoveTxOut(uint32_t index) {
-  AbstractTransaction::RemoveTxOut(index);
+  CheckTxOutIndex(index, __LINE__, __FUNCTION__);
 
   std::vector<TxOut>::const_iterator ite = vout_.cbegin();
   if (index != 0) {
@@ -760,49 +1042,110 @@ ByteData256 Transaction::GetSignatureHash(
     throw CfdException(
         kCfdIllegalArgumentError, "unsupport witness version on ECDSA.");
   }
+  if (version == WitnessVersion::kVersion0) {
+    return GetWitnessV0SignatureHash(
+        txin_index, script_data, sighash_type, value);
+  }
+
+  // legacy sighash does not refer to the witness area,
+  // so the held wally_tx is used as it is.
   std::vector<uint8_t> buffer(SHA256_LEN);
   const std::vector<uint8_t> &bytes = script_data.GetBytes();
-  struct wally_tx *tx_pointer = NULL;
-  int ret = WALLY_OK;
-
-  // It is assumed that tx information has been created.
-  // (If it is not created, it will cause inconsistency)
-  const std::vector<uint8_t> &tx_bytedata =
-      GetByteData(HasWitness()).GetBytes();
-  ret = wally_tx_from_bytes(
-      tx_bytedata.data(), tx_bytedata.size(), 0, &tx_pointer);
+  const struct wally_tx *tx_pointer =
+      static_cast<const struct wally_tx *>(GetWallyTxAddress());
+  int ret = wally_tx_get_btc_signature_hash(
+      tx_pointer, txin_index, bytes.data(), bytes.size(),
+      value.GetSatoshiValue(), sighash_type.GetSigHashFlag(), 0,
+      buffer.data(), buffer.size());
   if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_from_bytes NG[{}] ", ret);
-    throw CfdException(kCfdIllegalArgumentError, "transaction data invalid.");
+    warn(CFD_LOG_SOURCE, "wally_tx_get_btc_signature_hash NG[{}] ", ret);
+    throw CfdException(
+        kCfdIllegalArgumentError, "SignatureHash generate error.");
   }
 
-  ret = WALLY_ENOMEM;
-  if (tx_pointer != NULL) {
-    try {
-      uint32_t tx_flag = 0;
-      if (version != WitnessVersion::kVersionNone) {
-        tx_flag = GetWallyFlag() & WALLY_TX_FLAG_USE_WITNESS;
-      }
-      ret = wally_tx_get_btc_signature_hash(
-          tx_pointer, txin_index, bytes.data(), bytes.size(),
-          value.GetSatoshiValue(), sighash_type.GetSigHashFlag(), tx_flag,
-          buffer.data(), buffer.size());
-      wally_tx_free(tx_pointer);
-    } catch (...) {
-      wally_tx_free(tx_pointer);  // Separately released in case of exception
-                                  // (possibility of exception by warn ())
-      warn(CFD_LOG_SOURCE, "wally_tx_get_btc_signature_hash cause exception.");
-      ret = WALLY_ERROR;
-    }
-  }
+  return ByteData256(buffer);
+}
 
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_get_btc_signature_hash NG[{}] ", ret);
+ByteData256 Transaction::GetWitnessV0SignatureHash(
+    uint32_t txin_index, const ByteData &script_data, SigHashType sighash_type,
+    const Amount &value) const {
+  if (vin_.size() <= txin_index) {
+    warn(CFD_LOG_SOURCE, "vin[{}] out_of_range.", txin_index);
     throw CfdException(
         kCfdIllegalArgumentError, "SignatureHash generate error.");
   }
+  static const ByteData256 kEmptyHash;
+  uint32_t sighash_flag = sighash_type.GetSigHashFlag();
+  uint32_t sighash_base = sighash_flag & 0x1f;
+  bool is_anyone_can_pay = sighash_type.IsAnyoneCanPay();
+  bool is_single = (sighash_base == SigHashAlgorithm::kSigHashSingle);
+  bool is_none = (sighash_base == SigHashAlgorithm::kSigHashNone);
+
+  ByteData256 hash_prevouts = kEmptyHash;
+  ByteData256 hash_sequence = kEmptyHash;
+  ByteData256 hash_outputs = kEmptyHash;
+  {
+    // the shared hashes are filled once and read under the lock.
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if ((!is_anyone_can_pay) && (!sighash_cache_.has_prevouts)) {
+      Serializer prevouts_buf(static_cast<uint32_t>(vin_.size() * 36));
+      for (const auto &txin : vin_) {
+        prevouts_buf.AddDirectBytes(txin.GetTxid().GetData());
+        prevouts_buf.AddDirectNumber(txin.GetVout());
+      }
+      sighash_cache_.hash_prevouts = HashUtil::Sha256D(prevouts_buf.Output());
+      sighash_cache_.has_prevouts = true;
+    }
+    if ((!is_anyone_can_pay) && (!is_single) && (!is_none) &&
+        (!sighash_cache_.has_sequence)) {
+      Serializer sequences_buf(static_cast<uint32_t>(vin_.size() * 4));
+      for (const auto &txin : vin_) {
+        sequences_buf.AddDirectNumber(txin.GetSequence());
+      }
+      sighash_cache_.hash_sequence =
+          HashUtil::Sha256D(sequences_buf.Output());
+      sighash_cache_.has_sequence = true;
+    }
+    if ((!is_single) && (!is_none) && (!sighash_cache_.has_outputs)) {
+      Serializer outputs_buf;
+      for (const auto &txout : vout_) {
+        outputs_buf.AddDirectNumber(txout.GetValue().GetSatoshiValue());
+        outputs_buf.AddVariableBuffer(txout.GetLockingScript().GetData());
+      }
+      sighash_cache_.hash_outputs = HashUtil::Sha256D(outputs_buf.Output());
+      sighash_cache_.has_outputs = true;
+    }
+    if (!is_anyone_can_pay) hash_prevouts = sighash_cache_.hash_prevouts;
+    if ((!is_anyone_can_pay) && (!is_single) && (!is_none)) {
+      hash_sequence = sighash_cache_.hash_sequence;
+    }
+    if ((!is_single) && (!is_none)) hash_outputs = sighash_cache_.hash_outputs;
+  }
 
-  return ByteData256(buffer);
+  const TxIn &txin = vin_[txin_index];
+  Serializer builder;
+  builder.AddDirectNumber(static_cast<uint32_t>(GetVersion()));
+  builder.AddDirectBytes(hash_prevouts);
+  builder.AddDirectBytes(hash_sequence);
+  builder.AddDirectBytes(txin.GetTxid().GetData());
+  builder.AddDirectNumber(txin.GetVout());
+  builder.AddVariableBuffer(script_data);
+  builder.AddDirectNumber(value.GetSatoshiValue());
+  builder.AddDirectNumber(txin.GetSequence());
+  if ((!is_single) && (!is_none)) {
+    builder.AddDirectBytes(hash_outputs);
+  } else if (is_single && (txin_index < vout_.size())) {
+    Serializer output_buf;
+    output_buf.AddDirectNumber(vout_[txin_index].GetValue().GetSatoshiValue());
+    output_buf.AddVariableBuffer(
+        vout_[txin_index].GetLockingScript().GetData());
+    builder.AddDirectBytes(HashUtil::Sha256D(output_buf.Output()));
+  } else {
+    builder.AddDirectBytes(kEmptyHash);
+  }
+  builder.AddDirectNumber(GetLockTime());
+  builder.AddDirectNumber(sighash_flag);
+  return HashUtil::Sha256D(builder.Output());
 }
 
 ByteData256 Transaction::GetSchnorrSignatureHash(
@@ -814,6 +1157,32 @@ ByteData256 Transaction::GetSchnorrSignatureHash(
     warn(CFD_LOG_SOURCE, "not enough utxo list.");
     throw CfdException(kCfdIllegalArgumentError, "not enough utxo list.");
   }
+  std::shared_ptr<const TaprootSigHashContext> context;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    context = sighash_cache_.taproot;
+  }
+  if ((!context) || (!context->IsMatch(*this)) ||
+      (!IsSameUtxoList(context->GetUtxoList(), utxo_list))) {
+    context = std::make_shared<const TaprootSigHashContext>(*this, utxo_list);
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    sighash_cache_.taproot = context;
+  }
+  return GetSchnorrSignatureHash(
+      txin_index, sighash_type, *context, script_data, annex);
+}
+
+ByteData256 Transaction::GetSchnorrSignatureHash(
+    uint32_t txin_index, SigHashType sighash_type,
+    const TaprootSigHashContext &context, const TapScriptData *script_data,
+    const ByteData &annex) const {
+  CheckTxInIndex(txin_index, __LINE__, __FUNCTION__);
+  if (!context.IsMatch(*this)) {
+    warn(CFD_LOG_SOURCE, "sighash context is unmatch transaction.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "sighash context is unmatch transaction.");
+  }
+  const std::vector<TxOut> &utxo_list = context.GetUtxoList();
   if ((!annex.IsEmpty()) && (annex.GetHeadData() != TaprootUtil::kAnnexTag)) {
     warn(CFD_LOG_SOURCE, "invalid annex tag.");
     throw CfdException(kCfdIllegalArgumentError, "invalid annex tag");
@@ -849,40 +1218,20 @@ ByteData256 Transaction::GetSchnorrSignatureHash(
   }
   ext_flag |= has_tap_script;
 
+  // The tag prefix is hashed from the precomputed TapSighash midstate.
   Serializer builder;
-  auto top = HashUtil::Sha256("TapSighash");
-  builder.AddDirectBytes(top);
-  builder.AddDirectBytes(top);  // double data
-  builder.AddDirectByte(0);     // EPOCH
+  builder.AddDirectByte(0);  // EPOCH
   builder.AddDirectByte(static_cast<uint8_t>(sighash_type.GetSigHashFlag()));
   builder.AddDirectNumber(static_cast<uint32_t>(GetVersion()));
   builder.AddDirectNumber(GetLockTime());
   if (!is_anyone_can_pay) {
-    Serializer prevouts_buf;
-    Serializer amounts_buf;
-    Serializer scripts_buf;
-    Serializer sequences_buf;
-    for (size_t index = 0; index < vin_.size(); ++index) {
-      prevouts_buf.AddDirectBytes(vin_[index].GetTxid().GetData());
-      prevouts_buf.AddDirectNumber(vin_[index].GetVout());
-      amounts_buf.AddDirectNumber(
-          utxo_list[index].GetValue().GetSatoshiValue());
-      scripts_buf.AddVariableBuffer(
-          utxo_list[index].GetLockingScript().GetData());
-      sequences_buf.AddDirectNumber(vin_[index].GetSequence());
-    }
-    builder.AddDirectBytes(HashUtil::Sha256(prevouts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(amounts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(scripts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(sequences_buf.Output()));
+    builder.AddDirectBytes(context.GetShaPrevouts());
+    builder.AddDirectBytes(context.GetShaAmounts());
+    builder.AddDirectBytes(context.GetShaScriptPubkeys());
+    builder.AddDirectBytes(context.GetShaSequences());
   }
   if (has_sighash_all) {
-    Serializer outputs_buf;
-    for (const auto &txout : vout_) {
-      outputs_buf.AddDirectNumber(txout.GetValue().GetSatoshiValue());
-      outputs_buf.AddVariableBuffer(txout.GetLockingScript().GetData());
-    }
-    builder.AddDirectBytes(HashUtil::Sha256(outputs_buf.Output()));
+    builder.AddDirectBytes(context.GetShaOutputs());
   }
 
   uint8_t spend_type = (ext_flag << 1) + (annex.IsEmpty() ? 0 : 1);
@@ -916,7 +1265,41 @@ ByteData256 Transaction::GetSchnorrSignatureHash(
     builder.AddDirectByte(key_version);
     builder.AddDirectNumber(script_data->code_separator_position);
   }
-  return HashUtil::Sha256(builder.Output());
+  return (HashUtil::CreateTaggedHash(kTagTapSighash) << builder.Output())
+      .Output256();
+}
+
+uint64_t Transaction::CreateSigHashGeneration() {
+  static std::atomic<uint64_t> generation(0);
+  return ++generation;
+}
+
+void Transaction::CallbackStateChange(uint32_t type) {
+  if ((type & ~kStateChangeUpdateSignTxIn) != 0) {
+    // BIP341 hashes cover every TxIn / TxOut field except the signature.
+    sighash_cache_.taproot.reset();
+    sighash_generation_ = CreateSigHashGeneration();
+  }
+  if ((type & (kStateChangeAddTxIn | kStateChangeRemoveTxIn)) != 0) {
+    sighash_cache_.has_prevouts = false;
+    sighash_cache_.has_sequence = false;
+    index_cache_.has_txin_index = false;
+  }
+  if (type != 0) {
+    PrepareWallyTxAddress();  // a moved-from object has no libwally tx.
+    is_wally_tx_stale_ = true;
+  }
+  if ((type & (kStateChangeAddTxOut | kStateChangeRemoveTxOut)) != 0) {
+    index_cache_.has_txout_index = false;
+  }
+  if ((type & kStateChangeUpdateTxIn) != 0) {
+    sighash_cache_.has_sequence = false;
+  }
+  if ((type & (kStateChangeAddTxOut | kStateChangeUpdateTxOut |
+               kStateChangeRemoveTxOut)) != 0) {
+    sighash_cache_.has_outputs = false;
+  }
+  AbstractTransaction::CallbackStateChange(type);
 }
 
 bool Transaction::HasWitness() const {
@@ -929,15 +1312,185 @@ bool Transaction::HasWitness() const {
 }
 
 ByteData Transaction::GetByteData(bool has_witness) const {
-  struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
-  return ConvertBitcoinTxFromWally(tx_pointer, !has_witness);
+  bool is_witness = has_witness && HasWitness();
+  Serializer builder(GetSerializeSize(is_witness));
+  builder.AddDirectNumber(static_cast<uint32_t>(GetVersion()));
+  if (is_witness) {
+    builder.AddDirectByte(0);  // marker is 0
+    builder.AddDirectByte(1);  // flag is 1(witness)
+  }
+  builder.AddVariableInt(vin_.size());
+  for (const TxIn &txin : vin_) {
+    builder.AddDirectBytes(txin.GetTxid().GetData());
+    builder.AddDirectNumber(txin.GetVout());
+    builder.AddVariableBuffer(txin.GetUnlockingScript().GetData());
+    builder.AddDirectNumber(txin.GetSequence());
+  }
+  builder.AddVariableInt(vout_.size());
+  for (const TxOut &txout : vout_) {
+    builder.AddDirectNumber(txout.GetValue().GetSatoshiValue());
+    builder.AddVariableBuffer(txout.GetLockingScript().GetData());
+  }
+  if (is_witness) {
+    for (const TxIn &txin : vin_) {
+      const std::vector<ByteData> &stack =
+          txin.GetScriptWitness().GetWitness();
+      builder.AddVariableInt(stack.size());
+      for (const ByteData &item : stack) {
+        builder.AddVariableBuffer(item);
+      }
+    }
+  }
+  builder.AddDirectNumber(GetLockTime());
+  return builder.Output();
 }
 
 uint32_t Transaction::GetWallyFlag() const {
   return WALLY_TX_FLAG_USE_WITNESS;
 }
 
+bool Transaction::IsStateChangeReported() const { return true; }
+
+void *Transaction::GetWallyTxAddress() const {
+  struct wally_tx *tx_pointer =
+      static_cast<struct wally_tx *>(wally_tx_pointer_);
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if ((!is_wally_tx_stale_) || (tx_pointer == nullptr)) return tx_pointer;
+
+  // build the TxIn / TxOut arrays at their final size, then swap them in.
+  struct wally_tx *new_tx = NULL;
+  int ret = wally_tx_init_alloc(
+      tx_pointer->version, tx_pointer->locktime, vin_.size(), vout_.size(),
+      &new_tx);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_tx_init_alloc NG[{}] ", ret);
+    throw CfdException(kCfdIllegalStateError, "wally tx update error.");
+  }
+  try {
+    AddWallyTxInOut(new_tx);
+  } catch (...) {
+    wally_tx_free(new_tx);
+    throw;
+  }
+  // version and locktime are not written, so they can be read
+  // concurrently without the lock.
+  std::swap(tx_pointer->inputs, new_tx->inputs);
+  std::swap(tx_pointer->num_inputs, new_tx->num_inputs);
+  std::swap(
+      tx_pointer->inputs_allocation_len, new_tx->inputs_allocation_len);
+  std::swap(tx_pointer->outputs, new_tx->outputs);
+  std::swap(tx_pointer->num_outputs, new_tx->num_outputs);
+  std::swap(
+      tx_pointer->outputs_allocation_len, new_tx->outputs_allocation_len);
+  wally_tx_free(new_tx);
+  is_wally_tx_stale_ = false;
+  return tx_pointer;
+}
+
+void Transaction::AddWallyTxInOut(void *wally_tx_pointer) const {
+  struct wally_tx *tx_pointer =
+      static_cast<struct wally_tx *>(wally_tx_pointer);
+  int ret = WALLY_OK;
+  for (const TxIn &txin : vin_) {
+    const ByteData256 &txid = txin.GetTxid().GetByteData256();
+    const ByteData &script = txin.GetUnlockingScript().GetData();
+    const std::vector<ByteData> &stack =
+        txin.GetScriptWitness().GetWitness();
+    struct wally_tx_witness_stack *stack_pointer = NULL;
+    if (!stack.empty()) {
+      ret = wally_tx_witness_stack_init_alloc(stack.size(), &stack_pointer);
+      for (size_t index = 0; (ret == WALLY_OK) && (index < stack.size());
+           ++index) {
+        ret = wally_tx_witness_stack_add(
+            stack_pointer, stack[index].IsEmpty() ? NULL : stack[index].data(),
+            stack[index].size());
+      }
+    }
+    if (ret == WALLY_OK) {
+      ret = wally_tx_add_raw_input(
+          tx_pointer, txid.data(), kByteData256Length, txin.GetVout(),
+          txin.GetSequence(), script.IsEmpty() ? NULL : script.data(),
+          script.size(), stack_pointer, 0);
+    }
+    if (stack_pointer != NULL) wally_tx_witness_stack_free(stack_pointer);
+    if (ret != WALLY_OK) {
+      warn(CFD_LOG_SOURCE, "wally_tx_add_raw_input NG[{}].", ret);
+      throw CfdException(kCfdIllegalStateError, "txin add error.");
+    }
+  }
+  for (const TxOut &txout : vout_) {
+    const ByteData &script = txout.GetLockingScript().GetData();
+    ret = wally_tx_add_raw_output(
+        tx_pointer, txout.GetValue().GetSatoshiValue(),
+        script.IsEmpty() ? NULL : script.data(), script.size(), 0);
+    if (ret != WALLY_OK) {
+      warn(CFD_LOG_SOURCE, "wally_tx_add_raw_output NG[{}].", ret);
+      throw CfdException(kCfdIllegalStateError, "vout add error.");
+    }
+  }
+}
+
+uint32_t Transaction::GetSerializeSize(bool has_witness) const {
+  // version, locktime
+  uint64_t size = sizeof(uint32_t) * 2;
+  uint64_t witness_size = 0;
+  bool exist_witness = false;
+  size += Serializer::GetVariableIntSize(vin_.size());
+  for (const TxIn &txin : vin_) {
+    // txid, vout, sequence
+    size += kByteData256Length + sizeof(uint32_t) * 2;
+    size += txin.GetUnlockingScript().GetData().GetSerializeSize();
+    if (has_witness) {
+      const std::vector<ByteData> &stack =
+          txin.GetScriptWitness().GetWitness();
+      if (!stack.empty()) exist_witness = true;
+      witness_size += Serializer::GetVariableIntSize(stack.size());
+      for (const ByteData &item : stack) {
+        witness_size += item.GetSerializeSize();
+      }
+    }
+  }
+  size += Serializer::GetVariableIntSize(vout_.size());
+  for (const TxOut &txout : vout_) {
+    size += sizeof(int64_t);
+    size += txout.GetLockingScript().GetData().GetSerializeSize();
+  }
+  // marker, flag and witness stacks
+  if (exist_witness) size += 2 + witness_size;
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    warn(CFD_LOG_SOURCE, "transaction size over. [{}]", size);
+    throw CfdException(kCfdIllegalStateError, "transaction size over.");
+  }
+  return static_cast<uint32_t>(size);
+}
+
+std::vector<uint32_t> Transaction::FindTxOutIndexList(
+    const Script &locking_script) const {
+  std::vector<uint32_t> result;
+  if (vout_.size() < kTxIndexMinimumCount) {
+    for (size_t index = 0; index < vout_.size(); ++index) {
+      if (vout_[index].GetLockingScript() == locking_script) {
+        result.push_back(static_cast<uint32_t>(index));
+      }
+    }
+    return result;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (!index_cache_.has_txout_index) {
+    index_cache_.txout_index.clear();
+    index_cache_.txout_index.reserve(vout_.size());
+    for (size_t index = 0; index < vout_.size(); ++index) {
+      index_cache_.txout_index[vout_[index].GetLockingScript()].push_back(
+          static_cast<uint32_t>(index));
+    }
+    index_cache_.has_txout_index = true;
+  }
+  const auto ite = index_cache_.txout_index.find(locking_script);
+  if (ite != index_cache_.txout_index.end()) result = ite->second;
+  return result;
+}
+
 void Transaction::CheckTxInIndex(
     uint32_t index, int line, const char *caller) const {
   if (vin_.size() <= index) {
@@ -7,7 +7,9 @@
 #include "cfdcore/cfdcore_transaction_common.h"
 
 #include <limits>
+#include <mutex>  // NOLINT
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -33,7 +35,23 @@ static constexpr uint8_t kViMax8 = 252;   //!< VarInt8
 // -----------------------------------------------------------------------------
 // ScriptWitness
 // -----------------------------------------------------------------------------
-const std::vector<ByteData> ScriptWitness::GetWitness() const {
+ScriptWitness::ScriptWitness(const ScriptWitness &object)
+    : witness_stack_(object.witness_stack_) {
+  // do nothing
+}
+
+ScriptWitness &ScriptWitness::operator=(const ScriptWitness &object) & {
+  if (this != &object) {
+    witness_stack_ = object.witness_stack_;
+  }
+  return *this;
+}
+
+const std::vector<ByteData> &ScriptWitness::GetWitness() const & {
+  return witness_stack_;
+}
+
+std::vector<ByteData> ScriptWitness::GetWitness() const && {
   return witness_stack_;
 }
 
@@ -96,13 +114,61 @@ AbstractTxIn::AbstractTxIn(
   // do nothing
 }
 
-Txid AbstractTxIn::GetTxid() const { return txid_; }
+AbstractTxIn::AbstractTxIn(const AbstractTxIn &object)
+    : txid_(object.txid_),
+      vout_(object.vout_),
+      unlocking_script_(object.unlocking_script_),
+      sequence_(object.sequence_),
+      script_witness_(object.script_witness_) {
+  // do nothing
+}
+
+AbstractTxIn::AbstractTxIn(AbstractTxIn &&object) noexcept
+    : txid_(object.txid_),
+      vout_(object.vout_),
+      unlocking_script_(std::move(object.unlocking_script_)),
+      sequence_(object.sequence_),
+      script_witness_(std::move(object.script_witness_)) {
+  // do nothing
+}
+
+AbstractTxIn &AbstractTxIn::operator=(const AbstractTxIn &object) & {
+  if (this != &object) {
+    txid_ = object.txid_;
+    vout_ = object.vout_;
+    unlocking_script_ = object.unlocking_script_;
+    sequence_ = object.sequence_;
+    script_witness_ = object.script_witness_;
+  }
+  return *this;
+}
+
+AbstractTxIn &AbstractTxIn::operator=(AbstractTxIn &&object) & noexcept {
+  if (this != &object) {
+    txid_ = object.txid_;
+    vout_ = object.vout_;
+    unlocking_script_ = std::move(object.unlocking_script_);
+    sequence_ = object.sequence_;
+    script_witness_ = std::move(object.script_witness_);
+  }
+  return *this;
+}
+
+const Txid &AbstractTxIn::GetTxid() const & { return txid_; }
+
+Txid AbstractTxIn::GetTxid() const && { return txid_; }
 
 uint32_t AbstractTxIn::GetVout() const { return vout_; }
 
 OutPoint AbstractTxIn::GetOutPoint() const { return OutPoint(txid_, vout_); }
 
-Script AbstractTxIn::GetUnlockingScript() const { return unlocking_script_; }
+const Script &AbstractTxIn::GetUnlockingScript() const & {
+  return unlocking_script_;
+}
+
+Script AbstractTxIn::GetUnlockingScript() const && {
+  return unlocking_script_;
+}
 
 void AbstractTxIn::SetUnlockingScript(const Script &unlocking_script) {
   unlocking_script_ = unlocking_script;
@@ -112,7 +178,11 @@ uint32_t AbstractTxIn::GetSequence() const { return sequence_; }
 
 void AbstractTxIn::SetSequence(uint32_t sequence) { sequence_ = sequence; }
 
-ScriptWitness AbstractTxIn::GetScriptWitness() const {
+const ScriptWitness &AbstractTxIn::GetScriptWitness() const & {
+  return script_witness_;
+}
+
+ScriptWitness AbstractTxIn::GetScriptWitness() const && {
   return script_witness_;
 }
 
@@ -157,6 +227,50 @@ AbstractTxInReference::AbstractTxInReference(const AbstractTxIn &tx_in)
   // do nothing
 }
 
+AbstractTxInReference::AbstractTxInReference(
+    const AbstractTxInReference &object)
+    : txid_(object.txid_),
+      vout_(object.vout_),
+      unlocking_script_(object.unlocking_script_),
+      sequence_(object.sequence_),
+      script_witness_(object.script_witness_) {
+  // do nothing
+}
+
+AbstractTxInReference::AbstractTxInReference(
+    AbstractTxInReference &&object) noexcept
+    : txid_(object.txid_),
+      vout_(object.vout_),
+      unlocking_script_(std::move(object.unlocking_script_)),
+      sequence_(object.sequence_),
+      script_witness_(std::move(object.script_witness_)) {
+  // do nothing
+}
+
+AbstractTxInReference &AbstractTxInReference::operator=(
+    const AbstractTxInReference &object) & {
+  if (this != &object) {
+    txid_ = object.txid_;
+    vout_ = object.vout_;
+    unlocking_script_ = object.unlocking_script_;
+    sequence_ = object.sequence_;
+    script_witness_ = object.script_witness_;
+  }
+  return *this;
+}
+
+AbstractTxInReference &AbstractTxInReference::operator=(
+    AbstractTxInReference &&object) & noexcept {
+  if (this != &object) {
+    txid_ = object.txid_;
+    vout_ = object.vout_;
+    unlocking_script_ = std::move(object.unlocking_script_);
+    sequence_ = object.sequence_;
+    script_witness_ = std::move(object.script_witness_);
+  }
+  return *this;
+}
+
 // -----------------------------------------------------------------------------
 // AbstractTxOut
 // -----------------------------------------------------------------------------
@@ -176,12 +290,27 @@ AbstractTxOut::AbstractTxOut(const Script &locking_script)
   // do nothing
 }
 
+AbstractTxOut::AbstractTxOut(const AbstractTxOut &object)
+    : value_(object.value_), locking_script_(object.locking_script_) {
+  // do nothing
+}
+
+AbstractTxOut &AbstractTxOut::operator=(const AbstractTxOut &object) & {
+  if (this != &object) {
+    value_ = object.value_;
+    locking_script_ = object.locking_script_;
+  }
+  return *this;
+}
+
 const Amount AbstractTxOut::GetValue() const { return value_; }
 
-const Script AbstractTxOut::GetLockingScript() const {
+const Script &AbstractTxOut::GetLockingScript() const & {
   return locking_script_;
 }
 
+Script AbstractTxOut::GetLockingScript() const && { return locking_script_; }
+
 void AbstractTxOut::SetValue(const Amount &value) { value_ = value; }
 
 // -----------------------------------------------------------------------------
@@ -192,6 +321,21 @@ AbstractTxOutReference::AbstractTxOutReference(const AbstractTxOut &tx_out)
   // do nothing
 }
 
+AbstractTxOutReference::AbstractTxOutReference(
+    const AbstractTxOutReference &object)
+    : value_(object.value_), locking_script_(object.locking_script_) {
+  // do nothing
+}
+
+AbstractTxOutReference &AbstractTxOutReference::operator=(
+    const AbstractTxOutReference &object) & {
+  if (this != &object) {
+    value_ = object.value_;
+    locking_script_ = object.locking_script_;
+  }
+  return *this;
+}
+
 uint32_t AbstractTxOutReference::GetSerializeSize() const {
   size_t result = 8;  // Amount分
   result += locking_script_.GetData().GetSerializeSize();
@@ -252,7 +396,9 @@ OutPoint::OutPoint(const Txid &txid, uint32_t vout)
   // do nothing
 }
 
-const Txid OutPoint::GetTxid() const { return txid_; }
+const Txid &OutPoint::GetTxid() const & { return txid_; }
+
+Txid OutPoint::GetTxid() const && { return txid_; }
 
 uint32_t OutPoint::GetVout() const { return vout_; }
 
@@ -274,9 +420,18 @@ int OutPoint::Compare(const OutPoint &object) const {
     return 1;
   else if (vout_ > object.vout_)
     return -1;
-  return std::strncmp(
-      txid_.GetHex().c_str(), object.txid_.GetHex().c_str(),
-      kByteData256Length * 2);
+  // same order as the txid hex string. (an invalid txid is an empty string)
+  if (txid_.IsValid() != object.txid_.IsValid()) {
+    return (txid_.IsValid()) ? 1 : -1;
+  }
+  const uint8_t *source = txid_.GetByteData256().data();
+  const uint8_t *dest = object.txid_.GetByteData256().data();
+  for (size_t index = kByteData256Length; index != 0; --index) {
+    if (source[index - 1] != dest[index - 1]) {
+      return (source[index - 1] < dest[index - 1]) ? -1 : 1;
+    }
+  }
+  return 0;
 }
 
 bool operator<(const OutPoint &source, const OutPoint &dest) {
@@ -324,9 +479,45 @@ void AbstractTransaction::FreeWallyAddress(const void *wally_tx_pointer) {
   }
 }
 
+void *AbstractTransaction::CloneWallyAddress(const void *wally_tx_pointer) {
+  if (wally_tx_pointer == nullptr) return nullptr;
+  struct wally_tx *tx_pointer = nullptr;
+  int ret = wally_tx_clone_alloc(
+      static_cast<const struct wally_tx *>(wally_tx_pointer), 0, &tx_pointer);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_tx_clone_alloc NG[{}]", ret);
+    throw CfdException(kCfdMemoryFullError, "transaction clone error.");
+  }
+  return tx_pointer;
+}
+
+void *AbstractTransaction::AllocateWallyAddress(
+    int32_t version, uint32_t lock_time) {
+  struct wally_tx *tx_pointer = NULL;
+  int ret = wally_tx_init_alloc(version, lock_time, 0, 0, &tx_pointer);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_tx_init_alloc NG[{}] ", ret);
+    throw CfdException(
+        kCfdIllegalArgumentError, "transaction data generate error.");
+  }
+  return tx_pointer;
+}
+
+void *AbstractTransaction::PrepareWallyTxAddress() {
+  if (wally_tx_pointer_ == nullptr) {
+    wally_tx_pointer_ = AllocateWallyAddress(0, 0);
+  }
+  return wally_tx_pointer_;
+}
+
+void *AbstractTransaction::GetWallyTxAddress() const {
+  return wally_tx_pointer_;
+}
+
 int32_t AbstractTransaction::GetVersion() const {
   struct wally_tx *tx_pointer =
       static_cast<struct wally_tx *>(wally_tx_pointer_);
+  if (tx_pointer == nullptr) return 0;  // moved-from object
   // Type is matched to bitcoin-core
   // return reinterpret_cast<int32_t>(tx_pointer-> version);
   // VC ++ errors and warnings appear, so change to pointer cast
@@ -337,19 +528,23 @@ int32_t AbstractTransaction::GetVersion() const {
 uint32_t AbstractTransaction::GetLockTime() const {
   struct wally_tx *tx_pointer =
       static_cast<struct wally_tx *>(wally_tx_pointer_);
+  if (tx_pointer == nullptr) return 0;  // moved-from object
   return tx_pointer->locktime;
 }
 
 void AbstractTransaction::CallbackStateChange(uint32_t type) {
   // please override this function
   trace(CFD_LOG_SOURCE, "type[{}]", type);
+  metrics_cache_ = MetricsCache();
 }
 
+bool AbstractTransaction::IsStateChangeReported() const { return false; }
+
 void AbstractTransaction::AddTxIn(
     const Txid &txid, uint32_t index, uint32_t sequence,
     const Script &unlocking_script) {
   struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
+      static_cast<struct wally_tx *>(PrepareWallyTxAddress());
   const std::vector<uint8_t> &txid_buf = txid.GetData().GetBytes();
   int ret;
   if (unlocking_script.IsEmpty()) {
@@ -540,7 +735,7 @@ void AbstractTransaction::AddTxOut(
   const std::vector<uint8_t> &script_data =
       locking_script.GetData().GetBytes();
   int ret = wally_tx_add_raw_output(
-      static_cast<struct wally_tx *>(wally_tx_pointer_),
+      static_cast<struct wally_tx *>(PrepareWallyTxAddress()),
       value.GetSatoshiValue(), script_data.data(), script_data.size(), 0);
   if (ret != WALLY_OK) {
     warn(CFD_LOG_SOURCE, "wally_tx_add_raw_output NG[{}].", ret);
@@ -560,9 +755,14 @@ void AbstractTransaction::RemoveTxOut(uint32_t index) {
 }
 
 uint32_t AbstractTransaction::GetTotalSize() const {
+  const bool use_cache = IsStateChangeReported();
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (metrics_cache_.has_total_size) return metrics_cache_.total_size;
+  }
   size_t length = 0;
   struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
+      static_cast<struct wally_tx *>(GetWallyTxAddress());
   uint32_t flag = 0;
   if (HasWitness()) {
     flag = GetWallyFlag() & WALLY_TX_FLAG_USE_WITNESS;
@@ -572,38 +772,63 @@ uint32_t AbstractTransaction::GetTotalSize() const {
     warn(CFD_LOG_SOURCE, "wally_tx_get_length NG[{}].", ret);
     throw CfdException(kCfdIllegalStateError, "transaction size calc error.");
   }
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    metrics_cache_.total_size = static_cast<uint32_t>(length);
+    metrics_cache_.has_total_size = true;
+  }
   return static_cast<uint32_t>(length);
 }
 
 uint32_t AbstractTransaction::GetVsize() const {
+  const bool use_cache = IsStateChangeReported();
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (metrics_cache_.has_vsize) return metrics_cache_.vsize;
+  }
   size_t vsize = 0;
   struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
+      static_cast<struct wally_tx *>(GetWallyTxAddress());
   int ret = wally_tx_get_vsize(tx_pointer, &vsize);
   if (ret != WALLY_OK) {
     warn(CFD_LOG_SOURCE, "wally_tx_get_vsize NG[{}].", ret);
     throw CfdException(kCfdIllegalStateError, "transaction vsize calc error.");
   }
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    metrics_cache_.vsize = static_cast<uint32_t>(vsize);
+    metrics_cache_.has_vsize = true;
+  }
   return static_cast<uint32_t>(vsize);
 }
 
 uint32_t AbstractTransaction::GetWeight() const {
+  const bool use_cache = IsStateChangeReported();
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (metrics_cache_.has_weight) return metrics_cache_.weight;
+  }
   size_t weight = 0;
   struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
+      static_cast<struct wally_tx *>(GetWallyTxAddress());
   int ret = wally_tx_get_weight(tx_pointer, &weight);
   if (ret != WALLY_OK) {
     warn(CFD_LOG_SOURCE, "wally_tx_get_weight NG[{}].", ret);
     throw CfdException(
         kCfdIllegalStateError, "transaction weight calc error.");
   }
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    metrics_cache_.weight = static_cast<uint32_t>(weight);
+    metrics_cache_.has_weight = true;
+  }
   return static_cast<uint32_t>(weight);
 }
 
 Amount AbstractTransaction::GetValueOut() const {
   uint64_t satoshi = 0;
   struct wally_tx *tx_pointer =
-      static_cast<struct wally_tx *>(wally_tx_pointer_);
+      static_cast<struct wally_tx *>(GetWallyTxAddress());
 
   int ret = wally_tx_get_total_output_satoshi(tx_pointer, &satoshi);
   if (ret != WALLY_OK) {
@@ -618,13 +843,42 @@ bool AbstractTransaction::HasWitness() const { return false; }
 ByteData256 AbstractTransaction::GetHash() const { return GetHash(false); }
 
 ByteData256 AbstractTransaction::GetWitnessHash() const {
+  // checked before HasWitness(), which scans every TxIn.
+  if (IsStateChangeReported()) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (metrics_cache_.has_wtxid) return metrics_cache_.wtxid;
+  }
   return GetHash(HasWitness());
 }
 
 ByteData256 AbstractTransaction::GetHash(bool has_witness) const {
+  const bool use_cache = IsStateChangeReported();
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (has_witness && metrics_cache_.has_wtxid) return metrics_cache_.wtxid;
+    if ((!has_witness) && metrics_cache_.has_txid) return metrics_cache_.txid;
+  }
   ByteData buffer = GetByteData(has_witness);
   // sha256d hash
-  return HashUtil::Sha256D(buffer.GetBytes());
+  ByteData256 hash = HashUtil::Sha256D(buffer.GetBytes());
+  if (use_cache) {
+    // HasWitness() is evaluated before the lock is taken.
+    const bool is_witness_tx = (!has_witness) && HasWitness();
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (has_witness) {
+      metrics_cache_.wtxid = hash;
+      metrics_cache_.has_wtxid = true;
+    } else {
+      metrics_cache_.txid = hash;
+      metrics_cache_.has_txid = true;
+      // without witness data, wtxid is the same as txid.
+      if (!is_witness_tx) {
+        metrics_cache_.wtxid = hash;
+        metrics_cache_.has_wtxid = true;
+      }
+    }
+  }
+  return hash;
 }
 
 ByteData AbstractTransaction::GetData() const {
@@ -640,7 +894,7 @@ Txid AbstractTransaction::GetTxid() const {
 
 bool AbstractTransaction::IsCoinBase() const {
   bool is_coinbase = false;
-  struct wally_tx *tx = static_cast<struct wally_tx *>(wally_tx_pointer_);
+  struct wally_tx *tx = static_cast<struct wally_tx *>(GetWallyTxAddress());
   if (tx != nullptr) {
     size_t coinbase = 0;
     int ret = wally_tx_is_coinbase(tx, &coinbase);
@@ -737,3 +991,16 @@ uint8_t *AbstractTransaction::CopyVariableBuffer(
 
 }  // namespace core
 }  // namespace cfd
+
+namespace std {
+
+size_t hash<cfd::core::OutPoint>::operator()(
+    const cfd::core::OutPoint &outpoint) const {
+  // spread the vout over the txid value. (golden ratio constant)
+  const uint64_t vout_value =
+      static_cast<uint64_t>(outpoint.GetVout()) * 0x9e3779b97f4a7c15ULL;
+  return hash<cfd::core::Txid>()(outpoint.GetTxid()) ^
+         static_cast<size_t>(vout_value ^ (vout_value >> 32));
+}
+
+}  // namespace std
@@ -24,6 +24,25 @@ namespace core {
 extern ByteData ConvertBitcoinTxFromWally(
     const struct wally_tx *tx, bool force_exclude_witness);
 
+/**
+ * @brief read the witness stack area without copying it.
+ * @param[in,out] dec     deserializer positioned at the stack count.
+ * @param[in] buffer      deserializer buffer.
+ * @param[out] stack_num  witness stack count.
+ * @return witness stack area (count and items).
+ */
+extern ByteDataView ReadWitnessStackArea(
+    Deserializer *dec, const uint8_t *buffer, uint32_t *stack_num);
+
+/**
+ * @brief get a witness stack item from the witness stack area.
+ * @param[in] witness     witness stack area.
+ * @param[in] index       stack index.
+ * @return witness stack item.
+ */
+extern ByteDataView ReadWitnessStackItem(
+    const ByteDataView &witness, uint32_t index);
+
 }  // namespace core
 }  // namespace cfd
 
@@ -0,0 +1,402 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_transaction_stream.cpp
+ *
+ * @brief Classes related to transaction stream reader.
+ */
+#include "cfdcore/cfdcore_transaction_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+#include "cfdcore/cfdcore_transaction.h"
+
+namespace cfd {
+namespace core {
+
+using logger::warn;
+
+//////////////////////////////////
+/// Internal function
+//////////////////////////////////
+/**
+ * @brief Read a variable integer from the buffered stream data.
+ * @details Running out of the data is not an error, so that the caller
+ *   can read more data without an exception.
+ * @param[in] data        buffered data
+ * @param[in] size        buffered data size
+ * @param[in,out] offset  read offset
+ * @param[out] value      variable integer
+ * @retval true   read a variable integer.
+ * @retval false  need more data.
+ */
+static bool ReadStreamVariableInt(
+    const uint8_t* data, size_t size, size_t* offset, uint64_t* value) {
+  if (*offset >= size) return false;
+  uint8_t tag = data[*offset];
+  size_t int_size = 0;
+  if (tag == Serializer::kViTag16) {
+    int_size = 2;
+  } else if (tag == Serializer::kViTag32) {
+    int_size = 4;
+  } else if (tag == Serializer::kViTag64) {
+    int_size = 8;
+  }
+  if ((size - *offset) < (1 + int_size)) return false;
+  if (int_size == 0) {
+    *value = tag;
+  } else {
+    // little endian
+    *value = 0;
+    for (size_t index = 0; index < int_size; ++index) {
+      *value |= static_cast<uint64_t>(data[*offset + 1 + index])
+                << (index * 8);
+    }
+  }
+  *offset += 1 + int_size;
+  return true;
+}
+
+/**
+ * @brief Check the size declared in the stream data.
+ * @param[in] declared_size   declared size or item count
+ * @param[in] max_size        maximum transaction size
+ */
+static void CheckStreamDeclaredSize(uint64_t declared_size, size_t max_size) {
+  // every item takes at least one byte.
+  if (declared_size > max_size) {
+    warn(
+        CFD_LOG_SOURCE, "transaction declared size over. [{}]",
+        declared_size);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+}
+
+/**
+ * @brief Skip the bytes of the buffered stream data.
+ * @param[in] size            buffered data size
+ * @param[in] skip_size       skip size
+ * @param[in] max_size        maximum transaction size
+ * @param[in,out] offset      read offset
+ * @retval true   skipped.
+ * @retval false  need more data.
+ */
+static bool SkipStreamBytes(
+    size_t size, uint64_t skip_size, size_t max_size, size_t* offset) {
+  CheckStreamDeclaredSize(skip_size, max_size);
+  if ((size - *offset) < skip_size) return false;
+  *offset += static_cast<size_t>(skip_size);
+  return true;
+}
+
+/**
+ * @brief Skip a variable length buffer of the buffered stream data.
+ * @param[in] data            buffered data
+ * @param[in] size            buffered data size
+ * @param[in] max_size        maximum transaction size
+ * @param[in,out] offset      read offset
+ * @retval true   skipped.
+ * @retval false  need more data.
+ */
+static bool SkipStreamVariableBuffer(
+    const uint8_t* data, size_t size, size_t max_size, size_t* offset) {
+  uint64_t data_size = 0;
+  if (!ReadStreamVariableInt(data, size, offset, &data_size)) return false;
+  return SkipStreamBytes(size, data_size, max_size, offset);
+}
+
+/**
+ * @brief Measure the transaction size on the buffered stream data.
+ * @details Every declared size is checked against the maximum size before
+ *   it is skipped, so only a real end of the data asks for more data.
+ * @param[in] data        buffered data
+ * @param[in] size        buffered data size
+ * @param[in] max_size    maximum transaction size
+ * @param[out] tx_size    transaction size
+ * @retval true   measured.
+ * @retval false  need more data.
+ */
+static bool MeasureStreamTransaction(
+    const uint8_t* data, size_t size, size_t max_size, size_t* tx_size) {
+  size_t offset = 0;
+  uint64_t txin_count = 0;
+  uint64_t txout_count = 0;
+  bool has_witness = false;
+  if (!SkipStreamBytes(size, 4, max_size, &offset)) return false;  // version
+  if (!ReadStreamVariableInt(data, size, &offset, &txin_count)) return false;
+  if (txin_count == 0) {
+    if (offset >= size) return false;
+    if (data[offset] != 1) {
+      warn(CFD_LOG_SOURCE, "Invalid transaction flag.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+    ++offset;
+    has_witness = true;
+    if (!ReadStreamVariableInt(data, size, &offset, &txin_count)) {
+      return false;
+    }
+  }
+  CheckStreamDeclaredSize(txin_count, max_size);
+  for (uint64_t index = 0; index < txin_count; ++index) {
+    // outpoint, script, sequence
+    if (!SkipStreamBytes(size, 36, max_size, &offset) ||
+        !SkipStreamVariableBuffer(data, size, max_size, &offset) ||
+        !SkipStreamBytes(size, 4, max_size, &offset)) {
+      return false;
+    }
+  }
+  if (!ReadStreamVariableInt(data, size, &offset, &txout_count)) {
+    return false;
+  }
+  CheckStreamDeclaredSize(txout_count, max_size);
+  for (uint64_t index = 0; index < txout_count; ++index) {
+    // amount, locking script
+    if (!SkipStreamBytes(size, 8, max_size, &offset) ||
+        !SkipStreamVariableBuffer(data, size, max_size, &offset)) {
+      return false;
+    }
+  }
+  if (has_witness) {
+    for (uint64_t index = 0; index < txin_count; ++index) {
+      uint64_t stack_count = 0;
+      if (!ReadStreamVariableInt(data, size, &offset, &stack_count)) {
+        return false;
+      }
+      CheckStreamDeclaredSize(stack_count, max_size);
+      for (uint64_t stack = 0; stack < stack_count; ++stack) {
+        if (!SkipStreamVariableBuffer(data, size, max_size, &offset)) {
+          return false;
+        }
+      }
+    }
+  }
+  if (!SkipStreamBytes(size, 4, max_size, &offset)) return false;  // locktime
+  *tx_size = offset;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// MemoryTransactionStreamSource
+// -----------------------------------------------------------------------------
+MemoryTransactionStreamSource::MemoryTransactionStreamSource(
+    const ByteDataView& buffer)
+    : buffer_(buffer), offset_(0) {
+  // do nothing
+}
+
+size_t MemoryTransactionStreamSource::Read(uint8_t* buffer, size_t size) {
+  size_t read_size = std::min(size, buffer_.size() - offset_);
+  if (read_size != 0) {
+    memcpy(buffer, buffer_.data() + offset_, read_size);
+    offset_ += read_size;
+  }
+  return read_size;
+}
+
+// -----------------------------------------------------------------------------
+// IStreamTransactionStreamSource
+// -----------------------------------------------------------------------------
+IStreamTransactionStreamSource::IStreamTransactionStreamSource(
+    std::istream* stream)
+    : stream_(stream) {
+  if (stream_ == nullptr) {
+    warn(CFD_LOG_SOURCE, "stream is null.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid stream.");
+  }
+}
+
+size_t IStreamTransactionStreamSource::Read(uint8_t* buffer, size_t size) {
+  if (!stream_->good()) return 0;
+  stream_->read(
+      reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size));
+  if (stream_->bad()) {
+    warn(CFD_LOG_SOURCE, "Failed to read stream.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "Failed to read stream.");
+  }
+  return static_cast<size_t>(stream_->gcount());
+}
+
+// -----------------------------------------------------------------------------
+// TransactionStreamReader
+// -----------------------------------------------------------------------------
+constexpr size_t TransactionStreamReader::kDefaultChunkSize;
+constexpr size_t TransactionStreamReader::kDefaultMaxBufferSize;
+
+TransactionStreamReader::TransactionStreamReader(
+    TransactionStreamSource* source, TransactionStreamFormat format,
+    size_t chunk_size, size_t max_buffer_size)
+    : source_(source),
+      format_(format),
+      chunk_size_(chunk_size),
+      max_buffer_size_(max_buffer_size),
+      buffer_(),
+      begin_(0),
+      end_(0),
+      is_eof_(false),
+      stream_offset_(0),
+      read_count_(0),
+      tx_count_(0),
+      has_tx_count_(false) {
+  if (source_ == nullptr) {
+    warn(CFD_LOG_SOURCE, "stream source is null.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid stream source.");
+  }
+  if ((chunk_size_ == 0) || (max_buffer_size_ < chunk_size_) ||
+      (max_buffer_size_ > std::numeric_limits<uint32_t>::max())) {
+    warn(
+        CFD_LOG_SOURCE, "Invalid buffer size. chunk={}, max={}", chunk_size_,
+        max_buffer_size_);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid stream buffer size.");
+  }
+}
+
+bool TransactionStreamReader::ReadNext(TransactionView* view) {
+  if (view == nullptr) {
+    warn(CFD_LOG_SOURCE, "transaction view is null.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid transaction view.");
+  }
+  ByteDataView data;
+  if (!ReadNextData(&data)) return false;
+  *view = TransactionView(data);
+  return true;
+}
+
+bool TransactionStreamReader::ReadNext(Transaction* transaction) {
+  if (transaction == nullptr) {
+    warn(CFD_LOG_SOURCE, "transaction is null.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid transaction.");
+  }
+  ByteDataView data;
+  if (!ReadNextData(&data)) return false;
+  *transaction =
+      Transaction(ByteData(data.data(), static_cast<uint32_t>(data.size())));
+  return true;
+}
+
+uint64_t TransactionStreamReader::GetReadCount() const { return read_count_; }
+
+uint64_t TransactionStreamReader::GetStreamOffset() const {
+  return stream_offset_;
+}
+
+bool TransactionStreamReader::ReadNextData(ByteDataView* data) {
+  if (format_ == kTxStreamCountPrefixed) {
+    if (!has_tx_count_) {
+      if (!ReadVariableInt(&tx_count_)) return false;
+      has_tx_count_ = true;
+    }
+    if (read_count_ >= tx_count_) return false;
+  }
+
+  size_t tx_size = 0;
+  if (format_ == kTxStreamLengthPrefixed) {
+    uint64_t length = 0;
+    if (!ReadVariableInt(&length)) return false;
+    if ((length == 0) || (length > max_buffer_size_)) {
+      warn(CFD_LOG_SOURCE, "Invalid transaction length. [{}]", length);
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+    tx_size = static_cast<size_t>(length);
+    while ((end_ - begin_) < tx_size) {
+      if (!Fill()) {
+        warn(CFD_LOG_SOURCE, "transaction stream is truncated.");
+        throw CfdException(
+            CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+      }
+    }
+  } else {
+    // The transaction size is unknown, so measure it on the buffered data
+    // and read more only when the range runs past the buffer end.
+    while (true) {
+      if ((begin_ != end_) &&
+          MeasureStreamTransaction(
+              &buffer_[begin_], end_ - begin_, max_buffer_size_, &tx_size)) {
+        break;
+      }
+      if (!Fill()) {
+        if ((begin_ == end_) && (format_ == kTxStreamConcatenated)) {
+          return false;
+        }
+        warn(CFD_LOG_SOURCE, "transaction stream is truncated.");
+        throw CfdException(
+            CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+      }
+    }
+  }
+
+  *data = ByteDataView(&buffer_[begin_], tx_size);
+  Consume(tx_size);
+  ++read_count_;
+  return true;
+}
+
+bool TransactionStreamReader::ReadVariableInt(uint64_t* value) {
+  while (true) {
+    size_t offset = 0;
+    if (ReadStreamVariableInt(
+            buffer_.data() + begin_, end_ - begin_, &offset, value)) {
+      Consume(offset);
+      return true;
+    }
+    if (!Fill()) {
+      if (begin_ == end_) return false;
+      warn(CFD_LOG_SOURCE, "transaction stream is truncated.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+  }
+}
+
+bool TransactionStreamReader::Fill() {
+  if (is_eof_) return false;
+  if (begin_ != 0) {
+    // keep only the unread data.
+    if (begin_ != end_) {
+      memmove(buffer_.data(), &buffer_[begin_], end_ - begin_);
+    }
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  if (end_ >= max_buffer_size_) {
+    warn(
+        CFD_LOG_SOURCE, "transaction exceeds the buffer size. [{}]",
+        max_buffer_size_);
+    throw CfdException(
+        CfdError::kCfdOutOfRangeError,
+        "transaction exceeds the maximum buffer size.");
+  }
+  // grow geometrically so that a large transaction is measured a few times.
+  size_t read_size = std::min(
+      std::max(chunk_size_, end_), max_buffer_size_ - end_);
+  if (buffer_.size() < (end_ + read_size)) buffer_.resize(end_ + read_size);
+  size_t size = source_->Read(&buffer_[end_], read_size);
+  if (size == 0) {
+    is_eof_ = true;
+    return false;
+  }
+  end_ += size;
+  return true;
+}
+
+void TransactionStreamReader::Consume(size_t size) {
+  begin_ += size;
+  stream_offset_ += size;
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,343 @@
+// Copyright 2020 CryptoGarage
+/**
+ * @file cfdcore_transaction_view.cpp
+ *
+ * @brief Classes related to transaction view.
+ */
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+#include "cfdcore/cfdcore_transaction.h"
+#include "cfdcore/cfdcore_util.h"
+#include "cfdcore_transaction_internal.h"  // NOLINT
+
+namespace cfd {
+namespace core {
+
+using logger::warn;
+
+/// txid size
+static constexpr uint32_t kTxidSize = 32;
+/// outpoint size (txid + vout)
+static constexpr uint32_t kOutPointSize = kTxidSize + 4;
+/// coinbase vout
+static constexpr uint32_t kCoinBaseVout = 0xffffffff;
+
+// -----------------------------------------------------------------------------
+// Internal functions
+// -----------------------------------------------------------------------------
+ByteDataView ReadWitnessStackArea(
+    Deserializer *dec, const uint8_t *buffer, uint32_t *stack_num) {
+  uint32_t offset = dec->GetReadSize();
+  uint64_t count = dec->ReadVariableInt();
+  if (count > std::numeric_limits<uint32_t>::max()) {
+    warn(CFD_LOG_SOURCE, "witness stack count overflow.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  for (uint64_t index = 0; index < count; ++index) {
+    dec->SkipVariableBuffer();
+  }
+  if (stack_num != nullptr) *stack_num = static_cast<uint32_t>(count);
+  return ByteDataView(buffer + offset, dec->GetReadSize() - offset);
+}
+
+ByteDataView ReadWitnessStackItem(
+    const ByteDataView &witness, uint32_t index) {
+  Deserializer dec(witness);
+  uint64_t count = (witness.size() == 0) ? 0 : dec.ReadVariableInt();
+  if (index >= count) {
+    warn(CFD_LOG_SOURCE, "witness stack index out of range.");
+    throw CfdException(
+        CfdError::kCfdOutOfRangeError, "witness stack index out of range.");
+  }
+  for (uint32_t pos = 0; pos < index; ++pos) {
+    dec.SkipVariableBuffer();
+  }
+  return dec.ReadVariableView();
+}
+
+// -----------------------------------------------------------------------------
+// TxInView
+// -----------------------------------------------------------------------------
+TxInView::TxInView()
+    : outpoint_(nullptr),
+      unlocking_script_(),
+      sequence_(0),
+      witness_(),
+      witness_num_(0) {
+  // do nothing
+}
+
+ByteDataView TxInView::GetTxidView() const {
+  return ByteDataView(outpoint_, kTxidSize);
+}
+
+Txid TxInView::GetTxid() const {
+  return Txid(ByteData256(outpoint_, kTxidSize));
+}
+
+uint32_t TxInView::GetVout() const {
+  Deserializer dec(ByteDataView(outpoint_ + kTxidSize, 4));
+  return dec.ReadUint32();
+}
+
+OutPoint TxInView::GetOutPoint() const {
+  return OutPoint(GetTxid(), GetVout());
+}
+
+ByteDataView TxInView::GetUnlockingScriptView() const {
+  return unlocking_script_;
+}
+
+uint32_t TxInView::GetSequence() const { return sequence_; }
+
+uint32_t TxInView::GetScriptWitnessStackNum() const { return witness_num_; }
+
+ByteDataView TxInView::GetScriptWitnessStack(uint32_t index) const {
+  return ReadWitnessStackItem(witness_, index);
+}
+
+ScriptWitness TxInView::GetScriptWitness() const {
+  ScriptWitness witness;
+  for (uint32_t index = 0; index < witness_num_; ++index) {
+    ByteDataView stack = GetScriptWitnessStack(index);
+    witness.AddWitnessStack(
+        ByteData(stack.data(), static_cast<uint32_t>(stack.size())));
+  }
+  return witness;
+}
+
+bool TxInView::IsCoinBase() const {
+  if (GetVout() != kCoinBaseVout) return false;
+  for (uint32_t index = 0; index < kTxidSize; ++index) {
+    if (outpoint_[index] != 0) return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// TxOutView
+// -----------------------------------------------------------------------------
+TxOutView::TxOutView() : value_(0), locking_script_() {
+  // do nothing
+}
+
+Amount TxOutView::GetValue() const {
+  return Amount::CreateBySatoshiAmount(value_);
+}
+
+ByteDataView TxOutView::GetLockingScriptView() const {
+  return locking_script_;
+}
+
+Script TxOutView::GetLockingScript() const {
+  return Script(ByteData(
+      locking_script_.data(), static_cast<uint32_t>(locking_script_.size())));
+}
+
+// -----------------------------------------------------------------------------
+// TransactionView
+// -----------------------------------------------------------------------------
+TransactionView::TransactionView()
+    : buffer_(nullptr),
+      size_(0),
+      version_(0),
+      lock_time_(0),
+      witness_offset_(0),
+      vin_(),
+      vout_() {
+  // do nothing
+}
+
+TransactionView::TransactionView(const uint8_t *buffer, size_t size)
+    : TransactionView() {
+  if ((buffer == nullptr) || (size == 0) ||
+      (size > std::numeric_limits<uint32_t>::max())) {
+    warn(CFD_LOG_SOURCE, "Invalid transaction buffer.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  // marker(0x00) + flag(0x01) means segwit, unless it is a transaction
+  // without txin that fails the witness format (same as Transaction).
+  bool is_witness_format = (size > 6) && (buffer[4] == 0) && (buffer[5] == 1);
+  try {
+    Parse(buffer, size, is_witness_format);
+  } catch (const CfdException &except) {
+    if (!is_witness_format) {
+      warn(CFD_LOG_SOURCE, "Failed to parse transaction. {}", except.what());
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+    try {
+      Parse(buffer, size, false);
+    } catch (const CfdException &retry_except) {
+      warn(
+          CFD_LOG_SOURCE, "Failed to parse transaction. {}",
+          retry_except.what());
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+  }
+}
+
+TransactionView::TransactionView(const ByteDataView &buffer)
+    : TransactionView(buffer.data(), buffer.size()) {
+  // do nothing
+}
+
+void TransactionView::Parse(
+    const uint8_t *buffer, size_t size, bool has_witness) {
+  Deserializer dec(ByteDataView(buffer, size));
+  std::vector<TxInView> vin;
+  std::vector<TxOutView> vout;
+  int32_t version = static_cast<int32_t>(dec.ReadUint32());
+  if (has_witness) dec.SkipBytes(2);  // marker + flag
+
+  uint64_t txin_count = dec.ReadVariableInt();
+  // each txin needs at least outpoint + script size + sequence.
+  if (txin_count > (size / (kOutPointSize + 1 + 4))) {
+    warn(CFD_LOG_SOURCE, "txin count too large.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  vin.resize(static_cast<size_t>(txin_count));
+  for (auto &txin : vin) {
+    txin.outpoint_ = dec.ReadView(kOutPointSize).data();
+    txin.unlocking_script_ = dec.ReadVariableView();
+    txin.sequence_ = dec.ReadUint32();
+  }
+
+  uint64_t txout_count = dec.ReadVariableInt();
+  // each txout needs at least value + script size.
+  if (txout_count > (size / (8 + 1))) {
+    warn(CFD_LOG_SOURCE, "txout count too large.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+  vout.resize(static_cast<size_t>(txout_count));
+  for (auto &txout : vout) {
+    txout.value_ = static_cast<int64_t>(dec.ReadUint64());
+    txout.locking_script_ = dec.ReadVariableView();
+  }
+
+  uint32_t witness_offset = 0;
+  if (has_witness) {
+    witness_offset = dec.GetReadSize();
+    bool exist_witness = false;
+    for (auto &txin : vin) {
+      txin.witness_ = ReadWitnessStackArea(&dec, buffer, &txin.witness_num_);
+      if (txin.witness_num_ != 0) exist_witness = true;
+    }
+    if (!exist_witness) {
+      warn(CFD_LOG_SOURCE, "witness flag set without witness.");
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+    }
+  }
+  uint32_t lock_time = dec.ReadUint32();
+  if (dec.GetReadSize() != size) {
+    warn(CFD_LOG_SOURCE, "transaction has unread data.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "transaction data invalid.");
+  }
+
+  buffer_ = buffer;
+  size_ = static_cast<uint32_t>(size);
+  version_ = version;
+  lock_time_ = lock_time;
+  witness_offset_ = witness_offset;
+  vin_.swap(vin);
+  vout_.swap(vout);
+}
+
+bool TransactionView::IsValid() const { return buffer_ != nullptr; }
+
+int32_t TransactionView::GetVersion() const { return version_; }
+
+uint32_t TransactionView::GetLockTime() const { return lock_time_; }
+
+uint32_t TransactionView::GetTxInCount() const {
+  return static_cast<uint32_t>(vin_.size());
+}
+
+const TxInView &TransactionView::GetTxIn(uint32_t index) const {
+  if (index >= vin_.size()) {
+    warn(CFD_LOG_SOURCE, "vin[{}] out_of_range.", index);
+    throw CfdException(kCfdOutOfRangeError, "vin out_of_range error.");
+  }
+  return vin_[index];
+}
+
+const std::vector<TxInView> &TransactionView::GetTxInList() const {
+  return vin_;
+}
+
+uint32_t TransactionView::GetTxOutCount() const {
+  return static_cast<uint32_t>(vout_.size());
+}
+
+const TxOutView &TransactionView::GetTxOut(uint32_t index) const {
+  if (index >= vout_.size()) {
+    warn(CFD_LOG_SOURCE, "vout[{}] out_of_range.", index);
+    throw CfdException(kCfdOutOfRangeError, "vout out_of_range error.");
+  }
+  return vout_[index];
+}
+
+const std::vector<TxOutView> &TransactionView::GetTxOutList() const {
+  return vout_;
+}
+
+bool TransactionView::HasWitness() const { return witness_offset_ != 0; }
+
+ByteDataView TransactionView::GetData() const {
+  return ByteDataView(buffer_, size_);
+}
+
+uint32_t TransactionView::GetTotalSize() const { return size_; }
+
+uint32_t TransactionView::GetVsize() const {
+  if (witness_offset_ == 0) return size_;
+  uint32_t no_witness_size = GetWitnessExcludedSize();
+  return AbstractTransaction::GetVsizeFromSize(
+      no_witness_size, size_ - no_witness_size);
+}
+
+uint32_t TransactionView::GetWeight() const {
+  uint32_t no_witness_size = GetWitnessExcludedSize();
+  return (no_witness_size * 4) + (size_ - no_witness_size);
+}
+
+Txid TransactionView::GetTxid() const {
+  if (witness_offset_ == 0) return Txid(GetWitnessHash());
+  static constexpr uint32_t kBodyOffset = 4 + 2;  // version + marker/flag
+  uint8_t hash[Sha256Hasher::kOutputSize];
+  Sha256Hasher()
+      .Write(buffer_, 4)
+      .Write(buffer_ + kBodyOffset, witness_offset_ - kBodyOffset)
+      .Write(buffer_ + size_ - 4, 4)
+      .Finalize(hash);
+  return Txid(Sha256Hasher().Write(hash, sizeof(hash)).Finalize());
+}
+
+ByteData256 TransactionView::GetWitnessHash() const {
+  return HashUtil::Sha256D(GetData());
+}
+
+Transaction TransactionView::GetTransaction() const {
+  return Transaction(GetData());
+}
+
+uint32_t TransactionView::GetWitnessExcludedSize() const {
+  if (witness_offset_ == 0) return size_;
+  // exclude marker/flag and witness area (witness_offset_ to locktime).
+  return size_ - 2 - (size_ - 4 - witness_offset_);
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -158,196 +158,182 @@ bool SigHashType::IsValid() const {
 //////////////////////////////////
 /// HashUtil
 //////////////////////////////////
-// Ripemd160 --------------------------------------------------------------
-ByteData160 HashUtil::Ripemd160(const std::string &str) {
-  std::vector<uint8_t> output(RIPEMD160_LEN);
-  int ret = wally_ripemd160(
-      reinterpret_cast<const uint8_t *>(str.data()), str.size(), output.data(),
-      output.size());
+// Ripemd160 ----------------------------------------------------------------
+/**
+ * @brief calculate ripemd160.
+ * @param[in] buffer  buffer
+ * @param[in] size    buffer size
+ * @return ripemd160 hash
+ */
+static ByteData160 CalculateRipemd160(const uint8_t *buffer, size_t size) {
+  uint8_t output[RIPEMD160_LEN];
+  int ret = wally_ripemd160(buffer, size, output, sizeof(output));
   if (ret != WALLY_OK) {
     warn(CFD_LOG_SOURCE, "wally_hash160 NG[{}].", ret);
     throw CfdException(kCfdIllegalStateError, "hash160 calc error.");
   }
+  return ByteData160(output, sizeof(output));
+}
 
-  ByteData160 byte160(output);
-  return byte160;
+ByteData160 HashUtil::Ripemd160(const std::string &str) {
+  return CalculateRipemd160(
+      reinterpret_cast<const uint8_t *>(str.data()), str.size());
 }
 
 ByteData160 HashUtil::Ripemd160(const std::vector<uint8_t> &bytes) {
-  std::vector<uint8_t> output(RIPEMD160_LEN);
-  int ret = wally_ripemd160(
-      bytes.data(), bytes.size(), output.data(), output.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_hash160 NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "hash160 calc error.");
-  }
-
-  ByteData160 byte160(output);
-  return byte160;
+  return CalculateRipemd160(bytes.data(), bytes.size());
 }
 
 ByteData160 HashUtil::Ripemd160(const ByteData &data) {
-  return Ripemd160(data.GetBytes());
+  return CalculateRipemd160(data.data(), data.size());
 }
 
 ByteData160 HashUtil::Ripemd160(const ByteData160 &data) {
-  return Ripemd160(data.GetBytes());
+  return CalculateRipemd160(data.data(), data.size());
 }
 
 ByteData160 HashUtil::Ripemd160(const ByteData256 &data) {
-  return Ripemd160(data.GetBytes());
+  return CalculateRipemd160(data.data(), data.size());
+}
+
+ByteData160 HashUtil::Ripemd160(const ByteDataView &data) {
+  return CalculateRipemd160(data.data(), data.size());
 }
 
 ByteData160 HashUtil::Ripemd160(const Pubkey &pubkey) {
-  return Ripemd160(pubkey.GetData().GetBytes());
+  return Ripemd160(pubkey.GetData());
 }
 
 ByteData160 HashUtil::Ripemd160(const Script &script) {
-  return Ripemd160(script.GetData().GetBytes());
+  return Ripemd160(script.GetData());
 }
 
-// Hash160 -----------------------------------------------------------------
-ByteData160 HashUtil::Hash160(const std::string &str) {
-  std::vector<uint8_t> output(HASH160_LEN);
-
-  // Hash160
-  int ret = wally_hash160(
-      reinterpret_cast<const uint8_t *>(str.data()), str.size(), output.data(),
-      output.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_hash160 NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "hash160 calc error.");
-  }
+// Hash160 ------------------------------------------------------------------
+/**
+ * @brief calculate hash160.
+ * @param[in] buffer  buffer
+ * @param[in] size    buffer size
+ * @return hash160 hash
+ */
+static ByteData160 CalculateHash160(const uint8_t *buffer, size_t size) {
+  uint8_t hash[Sha256Hasher::kOutputSize];
+  Sha256Hasher().Write(buffer, size).Finalize(hash);
+  return Ripemd160Hasher().Write(hash, sizeof(hash)).Finalize();
+}
 
-  ByteData160 byte160(output);
-  return byte160;
+ByteData160 HashUtil::Hash160(const std::string &str) {
+  return CalculateHash160(
+      reinterpret_cast<const uint8_t *>(str.data()), str.size());
 }
 
 ByteData160 HashUtil::Hash160(const std::vector<uint8_t> &bytes) {
-  std::vector<uint8_t> output(HASH160_LEN);
-
-  // Hash160
-  int ret =
-      wally_hash160(bytes.data(), bytes.size(), output.data(), output.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_hash160 NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "hash160 calc error.");
-  }
-
-  ByteData160 byte160(output);
-  return byte160;
+  return CalculateHash160(bytes.data(), bytes.size());
 }
 
 ByteData160 HashUtil::Hash160(const ByteData &data) {
-  return Hash160(data.GetBytes());
+  return CalculateHash160(data.data(), data.size());
 }
 
 ByteData160 HashUtil::Hash160(const ByteData160 &data) {
-  return Hash160(data.GetBytes());
+  return CalculateHash160(data.data(), data.size());
 }
 
 ByteData160 HashUtil::Hash160(const ByteData256 &data) {
-  return Hash160(data.GetBytes());
+  return CalculateHash160(data.data(), data.size());
+}
+
+ByteData160 HashUtil::Hash160(const ByteDataView &data) {
+  return CalculateHash160(data.data(), data.size());
 }
 
 ByteData160 HashUtil::Hash160(const Pubkey &pubkey) {
-  return Hash160(pubkey.GetData().GetBytes());
+  return Hash160(pubkey.GetData());
 }
 
 ByteData160 HashUtil::Hash160(const Script &script) {
-  return Hash160(script.GetData().GetBytes());
+  return Hash160(script.GetData());
 }
 
-// Sha256 -----------------------------------------------------------------
-ByteData256 HashUtil::Sha256(const std::string &str) {
-  std::vector<uint8_t> output(SHA256_LEN);
-
-  // SHA256
-  int ret = wally_sha256(
-      reinterpret_cast<const uint8_t *>(str.data()), str.size(), output.data(),
-      output.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_sha256 NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "sha256 calc error.");
-  }
+// Sha256 -------------------------------------------------------------------
+/**
+ * @brief calculate sha256.
+ * @param[in] buffer  buffer
+ * @param[in] size    buffer size
+ * @return sha256 hash
+ */
+static ByteData256 CalculateSha256(const uint8_t *buffer, size_t size) {
+  return Sha256Hasher().Write(buffer, size).Finalize();
+}
 
-  return ByteData256(output);
+ByteData256 HashUtil::Sha256(const std::string &str) {
+  return CalculateSha256(
+      reinterpret_cast<const uint8_t *>(str.data()), str.size());
 }
 
 ByteData256 HashUtil::Sha256(const std::vector<uint8_t> &bytes) {
-  std::vector<uint8_t> output(SHA256_LEN);
-
-  // SHA256
-  int ret =
-      wally_sha256(bytes.data(), bytes.size(), output.data(), output.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_sha256 NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "sha256 calc error.");
-  }
-
-  return ByteData256(output);
+  return CalculateSha256(bytes.data(), bytes.size());
 }
 
 ByteData256 HashUtil::Sha256(const ByteData &data) {
-  return Sha256(data.GetBytes());
+  return CalculateSha256(data.data(), data.size());
 }
 
 ByteData256 HashUtil::Sha256(const ByteData160 &data) {
-  return Sha256(data.GetBytes());
+  return CalculateSha256(data.data(), data.size());
 }
 
 ByteData256 HashUtil::Sha256(const ByteData256 &data) {
-  return Sha256(data.GetBytes());
+  return CalculateSha256(data.data(), data.size());
+}
+
+ByteData256 HashUtil::Sha256(const ByteDataView &data) {
+  return CalculateSha256(data.data(), data.size());
 }
 
 ByteData256 HashUtil::Sha256(const Pubkey &pubkey) {
-  return Sha256(pubkey.GetData().GetBytes());
+  return Sha256(pubkey.GetData());
 }
 
 ByteData256 HashUtil::Sha256(const Script &script) {
-  return Sha256(script.GetData().GetBytes());
+  return Sha256(script.GetData());
 }
 
-// Sha256D -----------------------------------------------------------------
-ByteData256 HashUtil::Sha256D(const std::string &str) {
-  std::vector<uint8_t> output(SHA256_LEN);
-
-  // SHA256D
-  int ret = wally_sha256d(
-      reinterpret_cast<const uint8_t *>(str.data()), str.size(), output.data(),
-      output.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_sha256d NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "sha256d calc error.");
-  }
+// Sha256D ------------------------------------------------------------------
+/**
+ * @brief calculate sha256d.
+ * @param[in] buffer  buffer
+ * @param[in] size    buffer size
+ * @return sha256d hash
+ */
+static ByteData256 CalculateSha256D(const uint8_t *buffer, size_t size) {
+  uint8_t hash[Sha256Hasher::kOutputSize];
+  Sha256Hasher().Write(buffer, size).Finalize(hash);
+  return Sha256Hasher().Write(hash, sizeof(hash)).Finalize();
+}
 
-  return ByteData256(output);
+ByteData256 HashUtil::Sha256D(const std::string &str) {
+  return CalculateSha256D(
+      reinterpret_cast<const uint8_t *>(str.data()), str.size());
 }
 
 ByteData256 HashUtil::Sha256D(const std::vector<uint8_t> &bytes) {
-  std::vector<uint8_t> output(SHA256_LEN);
-
-  // SHA256D
-  int ret =
-      wally_sha256d(bytes.data(), bytes.size(), output.data(), output.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_sha256d NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "sha256d calc error.");
-  }
-
-  return ByteData256(output);
+  return CalculateSha256D(bytes.data(), bytes.size());
 }
 
 ByteData256 HashUtil::Sha256D(const ByteData &data) {
-  return Sha256D(data.GetBytes());
+  return CalculateSha256D(data.data(), data.size());
 }
 
 ByteData256 HashUtil::Sha256D(const ByteData160 &data) {
-  return Sha256D(data.GetBytes());
+  return CalculateSha256D(data.data(), data.size());
 }
 
 ByteData256 HashUtil::Sha256D(const ByteData256 &data) {
-  return Sha256D(data.GetBytes());
+  return CalculateSha256D(data.data(), data.size());
+}
+
+ByteData256 HashUtil::Sha256D(const ByteDataView &data) {
+  return CalculateSha256D(data.data(), data.size());
 }
 
 ByteData256 HashUtil::Sha256D(const Pubkey &pubkey) {
@@ -358,6 +344,67 @@ ByteData256 HashUtil::Sha256D(const Script &script) {
   return Sha256D(script.GetData());
 }
 
+// Batch --------------------------------------------------------------------
+/**
+ * @brief Hash the message list with Sha256 into the contiguous buffer.
+ * @param[in] inputs  message list
+ * @return digest buffer (inputs.size() * 32 bytes)
+ */
+static std::vector<uint8_t> CalculateSha256Batch(
+    const std::vector<ByteDataView> &inputs) {
+  std::vector<uint8_t> digests(inputs.size() * Sha256Hasher::kOutputSize);
+  Sha256Hasher::HashBatch(inputs.data(), inputs.size(), digests.data());
+  return digests;
+}
+
+std::vector<ByteData256> HashUtil::Sha256Batch(
+    const std::vector<ByteDataView> &inputs) {
+  std::vector<uint8_t> digests = CalculateSha256Batch(inputs);
+  std::vector<ByteData256> result;
+  result.reserve(inputs.size());
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    result.emplace_back(
+        digests.data() + (index * Sha256Hasher::kOutputSize),
+        Sha256Hasher::kOutputSize);
+  }
+  return result;
+}
+
+std::vector<ByteData256> HashUtil::Sha256DBatch(
+    const std::vector<ByteDataView> &inputs) {
+  static constexpr size_t kOutputSize = Sha256Hasher::kOutputSize;
+  std::vector<uint8_t> digests = CalculateSha256Batch(inputs);
+  std::vector<ByteDataView> second;
+  second.reserve(inputs.size());
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    second.emplace_back(digests.data() + (index * kOutputSize), kOutputSize);
+  }
+  std::vector<uint8_t> outputs(digests.size());
+  Sha256Hasher::HashBatch(second.data(), second.size(), outputs.data());
+  std::vector<ByteData256> result;
+  result.reserve(inputs.size());
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    result.emplace_back(outputs.data() + (index * kOutputSize), kOutputSize);
+  }
+  return result;
+}
+
+std::vector<ByteData160> HashUtil::Hash160Batch(
+    const std::vector<ByteDataView> &inputs) {
+  std::vector<uint8_t> digests = CalculateSha256Batch(inputs);
+  std::vector<ByteData160> result;
+  result.reserve(inputs.size());
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    result.push_back(
+        Ripemd160Hasher()
+            .Write(
+                digests.data() + (index * Sha256Hasher::kOutputSize),
+                Sha256Hasher::kOutputSize)
+            .Finalize());
+  }
+  return result;
+}
+
 // Sha512 -----------------------------------------------------------------
 ByteData HashUtil::Sha512(const std::string &str) {
   std::vector<uint8_t> output(SHA512_LEN);
@@ -408,6 +455,18 @@ ByteData HashUtil::Sha512(const Script &script) {
   return Sha512(script.GetData());
 }
 
+HashUtil HashUtil::CreateTaggedHash(TaggedHashTag tag) {
+  HashUtil hash_util(kSha256);
+  hash_util.sha256_ = Sha256Hasher::CreateTaggedHasher(tag);
+  return hash_util;
+}
+
+HashUtil HashUtil::CreateTaggedHash(const std::string &tag) {
+  HashUtil hash_util(kSha256);
+  hash_util.sha256_ = Sha256Hasher::CreateTaggedHasher(tag);
+  return hash_util;
+}
+
 HashUtil::HashUtil(uint8_t hash_type) : hash_type_(hash_type) {
   for (const auto &item : kFormatList) {
     if (item.type == 0) break;
@@ -436,68 +495,84 @@ HashUtil::HashUtil(const std::string &hash_type) {
   throw CfdException(kCfdIllegalArgumentError, "unsupported hash type.");
 }
 
-HashUtil::HashUtil(const HashUtil &object) {
-  hash_type_ = object.hash_type_;
-  buffer_ = object.buffer_;
+HashUtil::HashUtil(const HashUtil &object)
+    : hash_type_(object.hash_type_),
+      sha256_(object.sha256_),
+      sha512_(object.sha512_),
+      ripemd160_(object.ripemd160_) {
+  // do nothing
 }
 
 HashUtil &HashUtil::operator=(const HashUtil &object) {
   if (this != &object) {
     hash_type_ = object.hash_type_;
-    buffer_ = object.buffer_;
+    sha256_ = object.sha256_;
+    sha512_ = object.sha512_;
+    ripemd160_ = object.ripemd160_;
   }
   return *this;
 }
 
-HashUtil &HashUtil::operator<<(const std::string &str) {
-  buffer_.Push(ByteData(
-      reinterpret_cast<const uint8_t *>(str.data()),
-      static_cast<uint32_t>(str.size())));
+HashUtil &HashUtil::Write(const uint8_t *data, size_t size) {
+  switch (hash_type_) {
+    case kRipemd160:
+      ripemd160_.Write(data, size);
+      break;
+    case kSha512:
+      sha512_.Write(data, size);
+      break;
+    default:
+      // Hash160 / Sha256 / Sha256D start from sha256.
+      sha256_.Write(data, size);
+      break;
+  }
   return *this;
 }
 
+HashUtil &HashUtil::operator<<(const std::string &str) {
+  return Write(reinterpret_cast<const uint8_t *>(str.data()), str.size());
+}
+
 HashUtil &HashUtil::operator<<(const std::vector<uint8_t> &bytes) {
-  if (!bytes.empty()) buffer_.Push(ByteData(bytes));
-  return *this;
+  return Write(bytes.data(), bytes.size());
 }
 
 HashUtil &HashUtil::operator<<(const ByteData &data) {
-  if (!data.IsEmpty()) buffer_.Push(data);
-  return *this;
+  return Write(data.data(), data.size());
 }
 
 HashUtil &HashUtil::operator<<(const ByteData160 &data) {
-  buffer_.Push(data);
-  return *this;
+  return Write(data.data(), data.size());
 }
 
 HashUtil &HashUtil::operator<<(const ByteData256 &data) {
-  buffer_.Push(data);
-  return *this;
+  return Write(data.data(), data.size());
+}
+
+HashUtil &HashUtil::operator<<(const ByteDataView &data) {
+  return Write(data.data(), data.size());
 }
 
 HashUtil &HashUtil::operator<<(const Pubkey &pubkey) {
-  buffer_.Push(pubkey.GetData());
-  return *this;
+  return *this << pubkey.GetData();
 }
 
 HashUtil &HashUtil::operator<<(const Script &script) {
-  buffer_.Push(script.GetData());
-  return *this;
+  return *this << script.GetData();
 }
 
 ByteData HashUtil::Output() {
   switch (hash_type_) {
     case kRipemd160:
-      return Ripemd160(buffer_.GetBytes()).GetData();
+      // fall-through
     case kHash160:
-      return Hash160(buffer_.GetBytes()).GetData();
+      return Output160().GetData();
     case kSha256:
-      return Sha256(buffer_.GetBytes()).GetData();
+      // fall-through
     case kSha256D:
-      return Sha256D(buffer_.GetBytes()).GetData();
+      return Output256().GetData();
     case kSha512:
-      return Sha512(buffer_.GetBytes());
+      return sha512_.Finalize();
     default:
       throw CfdException(kCfdInternalError, "unknown hash type.");
   }
@@ -506,9 +581,12 @@ ByteData HashUtil::Output() {
 ByteData160 HashUtil::Output160() {
   switch (hash_type_) {
     case kRipemd160:
-      return Ripemd160(buffer_.GetBytes());
-    case kHash160:
-      return Hash160(buffer_.GetBytes());
+      return ripemd160_.Finalize();
+    case kHash160: {
+      uint8_t hash[Sha256Hasher::kOutputSize];
+      sha256_.Finalize(hash);
+      return Ripemd160Hasher().Write(hash, sizeof(hash)).Finalize();
+    }
     case kSha256:
       // fall-through
     case kSha256D:
@@ -523,9 +601,12 @@ ByteData160 HashUtil::Output160() {
 ByteData256 HashUtil::Output256() {
   switch (hash_type_) {
     case kSha256:
-      return Sha256(buffer_);
-    case kSha256D:
-      return Sha256D(buffer_);
+      return sha256_.Finalize();
+    case kSha256D: {
+      uint8_t hash[Sha256Hasher::kOutputSize];
+      sha256_.Finalize(hash);
+      return Sha256Hasher().Write(hash, sizeof(hash)).Finalize();
+    }
     case kRipemd160:
       // fall-through
     case kHash160:
@@ -861,186 +942,6 @@ ByteData CryptoUtil::ConvertSignatureFromDer(
   return ByteData(output);
 }
 
-/**
- * \~english
- * @brief Table info used for Base64encode
- * @return Character string used in Base64
- * \~japanese
- * @brief Base64encodeに用いるtable情報
- * @return Base64で利用する文字列
- */
-static const std::string kBase64EncodeTable(
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
-
-std::string CryptoUtil::EncodeBase64(const ByteData &data) {
-  std::vector<uint8_t> src(data.GetBytes());
-  std::string dst;
-  std::string cdst;
-
-  for (std::size_t i = 0; i < src.size(); ++i) {
-    switch (i % 3) {
-      case 0:
-        cdst.push_back(kBase64EncodeTable[(src[i] & 0xFC) >> 2]);
-        if (i + 1 == src.size()) {
-          cdst.push_back(kBase64EncodeTable[(src[i] & 0x03) << 4]);
-          cdst.push_back('=');
-          cdst.push_back('=');
-        }
-
-        break;
-      case 1:
-        cdst.push_back(
-            kBase64EncodeTable
-                [((src[i - 1] & 0x03) << 4) | ((src[i + 0] & 0xF0) >> 4)]);
-        if (i + 1 == src.size()) {
-          cdst.push_back(kBase64EncodeTable[(src[i] & 0x0F) << 2]);
-          cdst.push_back('=');
-        }
-
-        break;
-      case 2:
-        cdst.push_back(
-            kBase64EncodeTable
-                [((src[i - 1] & 0x0F) << 2) | ((src[i + 0] & 0xC0) >> 6)]);
-        cdst.push_back(kBase64EncodeTable[src[i] & 0x3F]);
-
-        break;
-    }
-  }
-
-  dst.swap(cdst);
-  return dst;
-}
-
-ByteData CryptoUtil::DecodeBase64(const std::string &str) {
-  std::vector<uint8_t> dst;
-  if (str.size() & 0x00000003) {
-    ByteData byteData(dst);
-    return byteData;
-  }
-
-  std::vector<uint8_t> cdst;
-  for (std::size_t i = 0; i < str.size(); i += 4) {
-    if (str[i + 0] == '=') {
-      ByteData byteData(dst);
-      return byteData;
-
-    } else if (str[i + 1] == '=') {
-      ByteData byteData(dst);
-      return byteData;
-
-    } else if (str[i + 2] == '=') {
-      const std::string::size_type s1 = kBase64EncodeTable.find(str[i + 0]);
-      const std::string::size_type s2 = kBase64EncodeTable.find(str[i + 1]);
-
-      if (s1 == std::string::npos || s2 == std::string::npos) {
-        ByteData byteData(dst);
-        return byteData;
-      }
-
-      cdst.push_back(
-          static_cast<uint8_t>(((s1 & 0x3F) << 2) | ((s2 & 0x30) >> 4)));
-
-      break;
-    } else if (str[i + 3] == '=') {
-      const std::string::size_type s1 = kBase64EncodeTable.find(str[i + 0]);
-      const std::string::size_type s2 = kBase64EncodeTable.find(str[i + 1]);
-      const std::string::size_type s3 = kBase64EncodeTable.find(str[i + 2]);
-
-      if (s1 == std::string::npos || s2 == std::string::npos ||
-          s3 == std::string::npos) {
-        ByteData byteData(dst);
-        return byteData;
-      }
-
-      cdst.push_back(
-          static_cast<uint8_t>(((s1 & 0x3F) << 2) | ((s2 & 0x30) >> 4)));
-      cdst.push_back(
-          static_cast<uint8_t>(((s2 & 0x0F) << 4) | ((s3 & 0x3C) >> 2)));
-
-      break;
-    } else {
-      const std::string::size_type s1 = kBase64EncodeTable.find(str[i + 0]);
-      const std::string::size_type s2 = kBase64EncodeTable.find(str[i + 1]);
-      const std::string::size_type s3 = kBase64EncodeTable.find(str[i + 2]);
-      const std::string::size_type s4 = kBase64EncodeTable.find(str[i + 3]);
-
-      if (s1 == std::string::npos || s2 == std::string::npos ||
-          s3 == std::string::npos || s4 == std::string::npos) {
-        ByteData byteData(dst);
-        return byteData;
-      }
-
-      cdst.push_back(
-          static_cast<uint8_t>(((s1 & 0x3F) << 2) | ((s2 & 0x30) >> 4)));
-      cdst.push_back(
-          static_cast<uint8_t>(((s2 & 0x0F) << 4) | ((s3 & 0x3C) >> 2)));
-      cdst.push_back(
-          static_cast<uint8_t>(((s3 & 0x03) << 6) | ((s4 & 0x3F) >> 0)));
-    }
-  }
-  dst.swap(cdst);
-  ByteData byteData(dst);
-  return byteData;
-}
-
-ByteData CryptoUtil::DecodeBase58(const std::string &str) {
-  std::vector<uint8_t> output(1024);
-  size_t written = 0;
-
-  int ret = wally_base58_to_bytes(
-      str.data(), 0, output.data(), output.size(), &written);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_to_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
-  }
-
-  output.resize(written);
-  return ByteData(output);
-}
-
-ByteData CryptoUtil::DecodeBase58Check(const std::string &str) {
-  std::vector<uint8_t> output(1024);
-  size_t written = 0;
-
-  int ret = wally_base58_to_bytes(
-      str.data(), BASE58_FLAG_CHECKSUM, output.data(), output.size(),
-      &written);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_to_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
-  }
-
-  output.resize(written);
-  return ByteData(output);
-}
-
-std::string CryptoUtil::EncodeBase58(const ByteData &data) {
-  std::vector<uint8_t> byte_array = data.GetBytes();
-  char *output = nullptr;
-
-  int ret = wally_base58_from_bytes(
-      byte_array.data(), byte_array.size(), 0, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_from_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
-  }
-  return WallyUtil::ConvertStringAndFree(output);
-}
-
-std::string CryptoUtil::EncodeBase58Check(const ByteData &data) {
-  std::vector<uint8_t> byte_array = data.GetBytes();
-  char *output = nullptr;
-
-  int ret = wally_base58_from_bytes(
-      byte_array.data(), byte_array.size(), BASE58_FLAG_CHECKSUM, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_from_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
-  }
-  return WallyUtil::ConvertStringAndFree(output);
-}
-
 ByteData256 CryptoUtil::ComputeFastMerkleRoot(
     const std::vector<ByteData256> &hashes) {
   static constexpr uint32_t kUintValue1 = 1;
@@ -1214,53 +1115,6 @@ bool RandomNumberUtil::GetRandomBool(std::vector<bool> *random_cache) {
 //////////////////////////////////
 /// StringUtil
 //////////////////////////////////
-bool StringUtil::IsValidHexString(const std::string &hex_str) {
-  if (hex_str.empty()) return true;
-
-  std::vector<uint8_t> buffer(hex_str.size() + 1);
-  size_t buf_size = 0;
-  int ret = wally_hex_to_bytes(
-      hex_str.data(), buffer.data(), buffer.size(), &buf_size);
-  return (ret == WALLY_OK);
-}
-
-std::vector<uint8_t> StringUtil::StringToByte(const std::string &hex_str) {
-  if (hex_str.empty()) {
-    info(CFD_LOG_SOURCE, "hex_str empty. return empty buffer.");
-    return std::vector<uint8_t>();
-  }
-  std::vector<uint8_t> buffer(hex_str.size() + 1);
-  size_t buf_size = 0;
-  int ret = wally_hex_to_bytes(
-      hex_str.data(), buffer.data(), buffer.size(), &buf_size);
-  if (ret == WALLY_OK) {
-    buffer.resize(buf_size);
-  } else {
-    warn(CFD_LOG_SOURCE, "wally_hex_to_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
-  }
-
-  return buffer;
-}
-
-std::string StringUtil::ByteToString(const std::vector<uint8_t> &bytes) {
-  std::string byte_str;
-  if (bytes.empty()) {
-    info(CFD_LOG_SOURCE, "bytes empty. return empty string.");
-  } else {
-    char *buffer = NULL;
-    int ret = wally_hex_from_bytes(bytes.data(), bytes.size(), &buffer);
-    if (ret == WALLY_OK) {
-      byte_str = WallyUtil::ConvertStringAndFree(buffer);
-    } else {
-      warn(CFD_LOG_SOURCE, "wally_hex_from_bytes NG[{}].", ret);
-      throw CfdException(
-          kCfdIllegalArgumentError, "byte to hex convert error.");
-    }
-  }
-  return byte_str;
-}
-
 std::string StringUtil::ToLower(const std::string &str) {
   static auto tolower_func = [](const char &c_value) -> char {
     return static_cast<char>(std::tolower(static_cast<char>(c_value)));
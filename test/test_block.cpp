@@ -1,8 +1,11 @@
 #include "gtest/gtest.h"
 #include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "cfdcore/cfdcore_common.h"
 #include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_script.h"
 
 #include "cfdcore/cfdcore_block.h"
@@ -11,6 +14,8 @@
 using cfd::core::ByteData;
 using cfd::core::Block;
 using cfd::core::BlockHash;
+using cfd::core::BlockTxRange;
+using cfd::core::BlockView;
 using cfd::core::Txid;
 using cfd::core::Script;
 
@@ -138,3 +143,135 @@ TEST(Block, GetTransaction) {
   EXPECT_EQ(block.GetBlockHeader().prev_block_hash.GetHex(),
       block3.GetBlockHeader().prev_block_hash.GetHex());
 }
+
+TEST(Block, ParseWitnessAndLegacyTransaction) {
+  // coinbase (witness) + p2pkh spend (non-witness)
+  std::string block_hex = "00000030957958949bad814d1666ed0d4a005c8aed6b7fd56df5d12c81d584c71e5fae2dfe391f9150dcfb06d54d4eb6621672590bf46bed6893da825c076b841794cec5414e2660ffff7f200000000002020000000001010000000000000000000000000000000000000000000000000000000000000000ffffffff0502d5000101ffffffff0200f9029500000000160014164e985d0fc92c927a66c0cbaf78e6ea389629d50000000000000000266a24aa21a9ede2f61c3f71d1defd3fa999dfa36953755c690689799962b48bebd836974e8cf901200000000000000000000000000000000000000000000000000000000000000000000000000200000001c6d2ea36e2e802b52ddac665dacbed2f831b5263459e1ca734f5c945d7515e40000000006a47304402205a2f94921f645669b2b4e073da43e6a5d32335b50207f9d27f0e8a8c0a24e75902205dea52d27ad747f2df786e0ad737595cf9c5a489143170668399764a5b4be44a01210229e026bab56c1c41d16e67f084362aef204b5b7ea08dafc2fb2e0db89d9c9551feffffff0178de052a0100000017a914d8de653e7763cc37305a00fc79a491ab70e2e5cb8700000000";
+  Block block(block_hex);
+  EXPECT_EQ(2, block.GetTransactionCount());
+  EXPECT_EQ(
+    "c5ce9417846b075c82da9368ed6bf40b59721662b64e4dd506fbdc50911f39fe",
+    block.GetTxid(0).GetHex());
+  EXPECT_EQ(
+    "85a37a01f7924c7ee95e948274c306fee1b6a0731722da5039c900d43561a590",
+    block.GetTxid(1).GetHex());
+  for (const auto& txid : block.GetTxids()) {
+    EXPECT_EQ(txid.GetHex(), block.GetTransaction(txid).GetTxid().GetHex());
+  }
+
+  // truncated block
+  EXPECT_THROW(
+    Block(block_hex.substr(0, block_hex.size() - 2)),
+    cfd::core::CfdException);
+}
+
+TEST(Block, BlockView) {
+  // coinbase (witness) + p2pkh spend (non-witness)
+  std::string block_hex = "00000030957958949bad814d1666ed0d4a005c8aed6b7fd56df5d12c81d584c71e5fae2dfe391f9150dcfb06d54d4eb6621672590bf46bed6893da825c076b841794cec5414e2660ffff7f200000000002020000000001010000000000000000000000000000000000000000000000000000000000000000ffffffff0502d5000101ffffffff0200f9029500000000160014164e985d0fc92c927a66c0cbaf78e6ea389629d50000000000000000266a24aa21a9ede2f61c3f71d1defd3fa999dfa36953755c690689799962b48bebd836974e8cf901200000000000000000000000000000000000000000000000000000000000000000000000000200000001c6d2ea36e2e802b52ddac665dacbed2f831b5263459e1ca734f5c945d7515e40000000006a47304402205a2f94921f645669b2b4e073da43e6a5d32335b50207f9d27f0e8a8c0a24e75902205dea52d27ad747f2df786e0ad737595cf9c5a489143170668399764a5b4be44a01210229e026bab56c1c41d16e67f084362aef204b5b7ea08dafc2fb2e0db89d9c9551feffffff0178de052a0100000017a914d8de653e7763cc37305a00fc79a491ab70e2e5cb8700000000";
+  std::vector<uint8_t> buffer = ByteData(block_hex).GetBytes();
+  BlockView view(buffer.data(), buffer.size());
+  EXPECT_TRUE(view.IsValid());
+  EXPECT_EQ(2, view.GetTransactionCount());
+  EXPECT_EQ(
+    "85a37a01f7924c7ee95e948274c306fee1b6a0731722da5039c900d43561a590",
+    view.GetTxid(1).GetHex());
+  EXPECT_TRUE(view.ExistTxid(Txid(
+    "c5ce9417846b075c82da9368ed6bf40b59721662b64e4dd506fbdc50911f39fe")));
+
+  const BlockTxRange& range0 = view.GetTransactionRange(0);
+  const BlockTxRange& range1 = view.GetTransactionRange(1);
+  EXPECT_EQ(81, range0.offset);
+  EXPECT_NE(0, range0.witness_offset);
+  EXPECT_EQ(range0.offset + range0.size, range1.offset);
+  EXPECT_EQ(0, range1.witness_offset);
+  EXPECT_EQ(buffer.size(), range1.offset + range1.size);
+  EXPECT_EQ(
+    view.GetTransaction(1).GetHex(), view.GetTransactionData(1).GetHex());
+  EXPECT_THROW(view.GetTxid(2), cfd::core::CfdException);
+
+  Block block(block_hex);
+  EXPECT_EQ(block.GetBlockHash().GetHex(), view.GetBlockHash().GetHex());
+
+  // the copied block keeps its own buffer.
+  Block copy_block;
+  {
+    Block temp_block(block_hex);
+    copy_block = temp_block;
+  }
+  EXPECT_EQ(block_hex, copy_block.GetHex());
+  EXPECT_EQ(
+    view.GetTransaction(0).GetHex(), copy_block.GetTransaction(0).GetHex());
+}
+
+TEST(Block, VerifyMerkleRoot) {
+  Block block("00000030957958949bad814d1666ed0d4a005c8aed6b7fd56df5d12c81d584c71e5fae2dfe391f9150dcfb06d54d4eb6621672590bf46bed6893da825c076b841794cec5414e2660ffff7f200000000001020000000001010000000000000000000000000000000000000000000000000000000000000000ffffffff0502d5000101ffffffff0200f9029500000000160014164e985d0fc92c927a66c0cbaf78e6ea389629d50000000000000000266a24aa21a9ede2f61c3f71d1defd3fa999dfa36953755c690689799962b48bebd836974e8cf90120000000000000000000000000000000000000000000000000000000000000000000000000");
+  EXPECT_TRUE(block.VerifyMerkleRoot());
+  EXPECT_TRUE(block.VerifyWitnessCommitment());
+  EXPECT_EQ(block.GetBlockHeader().merkle_root_hash.GetHex(),
+      block.CalculateMerkleRoot().GetHex());
+
+  // The merkle root is not updated for the appended transaction.
+  Block invalid_block("00000030957958949bad814d1666ed0d4a005c8aed6b7fd56df5d12c81d584c71e5fae2dfe391f9150dcfb06d54d4eb6621672590bf46bed6893da825c076b841794cec5414e2660ffff7f200000000002020000000001010000000000000000000000000000000000000000000000000000000000000000ffffffff0502d5000101ffffffff0200f9029500000000160014164e985d0fc92c927a66c0cbaf78e6ea389629d50000000000000000266a24aa21a9ede2f61c3f71d1defd3fa999dfa36953755c690689799962b48bebd836974e8cf901200000000000000000000000000000000000000000000000000000000000000000000000000200000001c6d2ea36e2e802b52ddac665dacbed2f831b5263459e1ca734f5c945d7515e40000000006a47304402205a2f94921f645669b2b4e073da43e6a5d32335b50207f9d27f0e8a8c0a24e75902205dea52d27ad747f2df786e0ad737595cf9c5a489143170668399764a5b4be44a01210229e026bab56c1c41d16e67f084362aef204b5b7ea08dafc2fb2e0db89d9c9551feffffff0178de052a0100000017a914d8de653e7763cc37305a00fc79a491ab70e2e5cb8700000000");
+  EXPECT_FALSE(invalid_block.VerifyMerkleRoot());
+  EXPECT_FALSE(invalid_block.VerifyWitnessCommitment());
+}
+
+TEST(Block, VerifyMerkleRootWithThreads) {
+  std::string block_hex = "00000020d987e1f7cc030f4272beda5a081f8f8969f044ef72a3b2c2e544afc8230b9642d8b5de43b746fa65aaab7cfa0b521b41e4eb0d7c0e2fb834380259df581daf03157eb360ffff7f200100000015020000000001010000000000000000000000000000000000000000000000000000000000000000ffffffff050277020101ffffffff02246aa01200000000160014aef2e2877c45ada6b9eaef2bdb9131630ae12dca0000000000000000266a24aa21a9ed2af9d1c54b61988d37ce9bcde367fba7f3c5910cecaf8be1b6b443e937e39cec0120000000000000000000000000000000000000000000000000000000000000000000000000020000000001013d067178968e8e7469a61a82c365508ee3615bed93ed421ddefe19da412171080000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f2500000000160014a9b62806472c7b70c9f753bf41573e1506534dc40247304402205de2d7b0acf8e6027fcb1e197745ca8d23c1a4a7f4dc449762265e2aab2022f202204d35e5866f31595616b44f77e218fbddbfed702b830eb4c2aac087c5c1ad0648012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001019421ca1de8781f070262511333197ab44f1629dbb704bd923f48bae4fa67a9f90000000000feffffff0213373f250000000016001455d6fbae5d95d2b03e5210abbe5a15ddbdb62c47a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee0247304402206f590ce48f6f7a93821c116c3a4a9659d9739d8a9bc62fcae12e34cf0e4b26500220361867ad6dcd30af0bec09a9571a8888452d2812275201f4878de296a78e8627012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001018e4212da7a883762b80efdf512263fd8d412771515b8b81cf992c01314fc93210000000000feffffff0213373f2500000000160014563423d5881cddbb72a1d6fea1af5c56bbea6a3fa0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee024730440220185d48c45b2e83f56249bfda4e2f0e1a211165c3c1175bd358cc7e4024e4764202201835811415ee2e5efbf42445b0113f54ae87b99e77e59252a69960759fdd8cf7012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d46302000002000000000101f0d8cef892eb52f81ac0e86bce4df8eeb9d0c1336cb62a069626c173e65321f80000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f2500000000160014e53cad733f173a80f1402d16123321535454048e0247304402207bbea0204f17fb98370ada2158666b4554d1354409efbd326835413041cd24410220323a16ee7b50f298446db61cd197cc44dd27fd90d45adb1a4fd780574300be7b012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d47602000002000000000101106a9ee2f6bbc4e58cbff2b1c99a53cdddec1a153f8a699350c00969500097210000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f2500000000160014f0321c988998afdb2b8788ce862402110792be8c0247304402207f6e3931036bb80b127b3d25ecf92bf5507cf057ec5af7c3a70b37e0c74575eb02205da9e647d92c86b2e17533050edd95e7eb887981e6145ade05728e0447a357bf012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d47602000002000000000101ea826992d745371bd6d762692369b94b2ac047df92d8b83cf9f46f6c9dbb13450000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f2500000000160014008e9141e1a0fd29384d41585598d2d1dc90ad380247304402202aeae79aa171eb28d21ee22fff4b58794d77e1ceda4c0bdd02fe87b4b6260c17022067184229e67f0ac2729e30206700fb50f0691e248690b6b103788552ebfb8b37012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001011723ce44d3f606a6fbd3de7e5204ad22f6b48154e19e0e37fdb547c84e57bdfe0000000000feffffff0213373f2500000000160014b30e6003f0a61a3c594678af24bfe170894c15cca0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee0247304402202876093a9dec94f9ce1fb3b7c487a8cf38b09a9f3e438c2a1e56d2ff8e2287df02204bba8b7936cccad0302d4f0e39da4b27779a2e8a5ba5a506fe00907544224633012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001016de1c5853fd550cb2fdd67f25b32496bb182404e2f127b5e82e48c587622eabc0000000000feffffff0213373f250000000016001496864cef7241cc0c24e8914f4ec75e34da0a70a6a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee0247304402207dde78431c3e5ede2a90af0b3e3d32fadb5712e5ec04e3fac2dc6137d747187902202fc5603f63ce4498ad9062ed35b37ca5fc9a19fc90a9ef40ddec55b30820862c012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001013e22c22ad4afedfac4642f54ebc1fb93f94f3af1c7cedd78fb17242975e00e650000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f250000000016001485fe6084fcec5323e4647ccb6781f2975ce78a690247304402202d4676c01c0f5f39d98f3e0435101c283baff3f2168bb20fccc99ef514abc77c02205703439a4ca4c289f9ab36e31ba88b81d5503ad705a30b036b628e505ef2b07f012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001018e637219b2c53a395f6b61b85ff720e7380161b31473556d470878ccc9077fe80000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f2500000000160014d9a72d531686342f1f81a447f9643d22ec7bd0ab02473044022010df9caa2ae04bf2b04cce039d859e8fe9f04add799ce02ce4f5848a48eebb9802204e11ae33d32a7c99af8dcc85797b5dc0b7a864c5f9848be41604740fac2bdb89012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d4760200000200000000010124c74f712076cb581a3ee4ae502e094487139ca3da724edb9c0acfd905bd8d340000000000feffffff0213373f250000000016001465eab055d88f1ac853fe1f790740ce24c8623e4ea0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee02473044022053373da5b4b0583d7ef8e743b0fad5688d5a81c82dd33fb6a614a0cf7234431a0220192e5802c1bf8d2e05bca416e3e42b1fb7947169333c40a33bfda2bf1170237d012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d4760200000200000000010145df9bc5da442ff71110c0872dc58939138aba50f2e12bdf13ef7e75ab2f893c0000000000feffffff0213373f250000000016001427880ac035c111a8e8f71e4ae6a5bb4df79518c4a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee0247304402200a13fd5ae3a2dd9bb210316fea853cc8ad9ada202a58c91f53c61a0741b63833022012a15e4bb30938b31da9606d03e2692e12ce87afe816df19ca20934dfadb7641012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d4760200000200000000010140b280318583b4e346fab2a2a126201799ddaffa169d3ac375b9434b3937a0750000000000feffffff0213373f2500000000160014e11569e65a6a7bbe75ca0322070eb0745201b99ca0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee024730440220655e813dcd37ee11f44d82eddc1540225866e3cc730b768c6c5f9b80cd1c447502200e538e03ed2a3c4f5da9396e884890556e42bf5d25ae49eb1b6c8a0101096fb0012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001012fb0c024a0ae79e6217dc8889c6af40853b2b230a0e9f79d765c8b5525e0e2320000000000feffffff0213373f25000000001600147f44238db9775e0e738fb949724a7ffb66f4ac47a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee02473044022032778f2c844abedb675ef947bdc7a11271800b5a11c98be5c0c9fdc6b2037f7302206acf28de27d327dc5a9d93998edad27f7509aa8479a1a2be1cb28f0eee28bf6a012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d47602000002000000000101892c26005096da187a5de107320c08a02e458be0184af915edbacaf5ad898c160000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f250000000016001460524bb60b4dc68abe9ba195376d572dd6cc20fa0247304402206b43d3fcceff2ee92380f6e112b99907b94df56c9ed2ab7df4fa750fd5010ed70220526807188cb56ff1944e19db3910b06d944c8772a76fd91b83cca791c740da14012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d4760200000200000000010128877cbe42170fca382e506d745a333a1e1eed9ed5c3597cf904cd441f7fef050000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f250000000016001462bf5d506758c4075c1484ed199c12b1d070dcc9024730440220514defa364f4cf78355fb64a79f0be487a0515f2c383cca2c7572b862f389b8b022040fb39e0cef457968c22c7a778b3225bf6d95e661c6bfaeea40dc6c9ae7fd9d5012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001019b34c725b2b7de36389cec07b79109d482dab48e1641c2ba143fe1e0ab80f86d0000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f250000000016001437586a889710f537d70d511e41f45ade16ae96b80247304402205e1560130977bf5584e1938c34daa77e3dd0393eff6cfb18fa3d485a622a9f1d02200d55678c7c274442b0aa99d0a047094051b125ff74e8582be20d52dbb1825889012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d476020000020000000001017883189114213697b8adc8069c8bafc80d9972c9fc1949a478c57bde58daacbb0000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f25000000001600144b69012485912f125d6121323d1b2c55e24b3a8f0247304402203bf784686661951078c64dce1410677127d92015d018a1233a9be6351f26ad2302203b6287e552aed0abcf8740cc464d5843dbd3712e58b33dfa2be6947ba88e7b8f012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d4760200000200000000010180143a2ecddd4d3b32eb7c1e6378a054a2a02b278811a5ffbddf4db4e17f0ad70000000000feffffff0213373f2500000000160014fe956a004e01b6cbe82bf6a351f9370a60917abba0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee024730440220769b4f0bc75725b686fcc131af5b31722eeb0e7835bdeb812e16982183045d66022070a2f04e7619e75a9abd62170a1dbffceb11e398119c559bdb66cf49d91d7b43012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d47602000002000000000101f33b3ce193ef8a4450c6b4db2184538c0e5c5c5406e549478d8afe10b3d7e1760000000000feffffff02a0860100000000001600143df45aa3e4c76b1f2f4693675770ba4e3db2acee13373f25000000001600147235fdc337715c994998751dbfb0f3a38e87594e02473044022071323b810bed75c508337a442268503d70ac598f8db2fd0af57fb7ff6b913450022075157811bc930b2a7e2dc2cf5d6b075ca99e3e81bef2992111e43b8aebe9a0ac012102b30fc0ddd4de67700667921a0c73f9e773d473c4827abe8c63b5060725b745d434020000";
+  std::vector<uint8_t> buffer = ByteData(block_hex).GetBytes();
+  BlockView view(buffer.data(), buffer.size());
+  Block block(block_hex);
+  EXPECT_EQ(21, view.GetTransactionCount());
+  for (uint32_t thread_count : std::vector<uint32_t>{0, 1, 4}) {
+    SCOPED_TRACE("thread_count:" + std::to_string(thread_count));
+    BlockView temp_view(buffer.data(), buffer.size());
+    auto txids = temp_view.CalculateTxids(thread_count);
+    auto wtxids = temp_view.CalculateWitnessHashes(thread_count);
+    ASSERT_EQ(21, txids.size());
+    ASSERT_EQ(21, wtxids.size());
+    for (uint32_t index = 0; index < 21; ++index) {
+      auto tx = block.GetTransaction(index);
+      EXPECT_EQ(tx.GetTxid().GetHex(), txids[index].GetHex());
+      EXPECT_EQ(tx.GetWitnessHash().GetHex(), wtxids[index].GetHex());
+    }
+    EXPECT_TRUE(temp_view.VerifyMerkleRoot(thread_count));
+    EXPECT_TRUE(temp_view.VerifyWitnessCommitment(thread_count));
+  }
+  EXPECT_EQ(
+    "7f5fb624f5cdce391362aa6befea307c4e778e008e799b40ca7119046f26ab31",
+    view.GetTxid(0).GetHex());
+
+  // txid index and cached merkle tree
+  auto txids = block.GetTxids();
+  for (uint32_t index = 0; index < txids.size(); ++index) {
+    EXPECT_EQ(index, block.GetTransactionIndex(txids[index]));
+  }
+  EXPECT_THROW(block.GetTransactionIndex(Txid(
+    "695eddd38e01b5f67f93d3dcbdca033e1d8fd3feaefbdbcc2a2bd1326a6b7be4")),
+    cfd::core::CfdException);
+  auto proof = block.GetTxOutProof(txids[20]);
+  EXPECT_EQ(proof.GetHex(), block.GetTxOutProof(txids[20]).GetHex());
+  EXPECT_EQ(proof.GetHex(), Block(block).GetTxOutProof(txids[20]).GetHex());
+  EXPECT_NE(proof.GetHex(), block.GetTxOutProof(txids).GetHex());
+
+  // concurrent const calls on one block fill the caches exactly once.
+  Block shared_block(block_hex);
+  std::vector<std::string> proofs(4);
+  std::vector<std::thread> threads;
+  for (size_t worker = 0; worker < proofs.size(); ++worker) {
+    threads.emplace_back([&shared_block, &txids, &proofs, worker]() {
+      for (uint32_t index = 0; index < txids.size(); ++index) {
+        if (shared_block.GetTxid(index).GetHex() != txids[index].GetHex() ||
+            !shared_block.ExistTxid(txids[index])) {
+          return;
+        }
+      }
+      if (!shared_block.VerifyMerkleRoot(2)) return;
+      proofs[worker] = shared_block.GetTxOutProof(txids[20]).GetHex();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const auto& result : proofs) {
+    EXPECT_EQ(proof.GetHex(), result);
+  }
+}
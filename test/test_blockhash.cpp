@@ -50,4 +50,19 @@ TEST(BlockHash, IsValid) {
   EXPECT_FALSE(empty_blockhash.IsValid());
 }
 
+TEST(BlockHash, OperatorsAndHash) {
+  BlockHash hash1(
+      "0000000000000000000000000000000000000000000000000000000000000001");
+  BlockHash hash2(
+      "0000000000000000000000000000000000000000000000000000000000000001");
+  BlockHash hash3(
+      "0000000000000000000000000000000000000000000000000000000000000002");
+  EXPECT_TRUE(hash1.Equals(hash2));
+  EXPECT_TRUE(hash1 == hash2);
+  EXPECT_TRUE(hash1 != hash3);
+  EXPECT_TRUE(hash1 != BlockHash());
+  EXPECT_TRUE(hash1 < hash3);
+  EXPECT_EQ(std::hash<BlockHash>()(hash1), std::hash<BlockHash>()(hash2));
+}
+
 #endif  // CFD_DISABLE_ELEMENTS
@@ -15,6 +15,7 @@
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::ByteDataView;
 
 TEST(ByteData, DefaultConstructor) {
   ByteData byte_data;
@@ -251,3 +252,27 @@ TEST(ByteData, SplitData) {
     EXPECT_FALSE(sub_data == list[1]);
   }
 }
+
+TEST(ByteDataView, Accessor) {
+  ByteData data("0102030405");
+  ByteDataView view(data);
+  EXPECT_EQ(data.data(), view.data());
+  EXPECT_EQ(5, view.size());
+  EXPECT_FALSE(view.IsEmpty());
+  EXPECT_EQ("0102030405", view.GetHex());
+  EXPECT_TRUE(data.Equals(view.GetData()));
+  EXPECT_EQ(data.GetBytes(), view.GetBytes());
+
+  ByteDataView sub_view = view.GetSubView(1, 3);
+  EXPECT_EQ("020304", sub_view.GetHex());
+  EXPECT_TRUE(sub_view.Equals(ByteDataView(ByteData("020304"))));
+  EXPECT_FALSE(sub_view.Equals(view));
+  EXPECT_TRUE(view.GetSubView(5, 0).IsEmpty());
+  EXPECT_THROW(view.GetSubView(4, 2), cfd::core::CfdException);
+  EXPECT_THROW(view.GetSubView(6, 0), cfd::core::CfdException);
+
+  ByteData256 data256(
+      "1234567890123456789012345678901234567890123456789012345678901234");
+  EXPECT_EQ(data256.GetHex(), ByteDataView(data256).GetHex());
+  EXPECT_TRUE(ByteDataView().IsEmpty());
+}
@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <cstring>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -155,3 +156,19 @@ TEST(ByteData160, Concat) {
   EXPECT_NO_THROW(result = base.Concat(data1, data2, data3));
   EXPECT_STREQ(result.GetHex().c_str(), "1111111111111111111111111111111111111111223344444444444444444444444444444444444444445555555555555555555555555555555555555555555555555555555555555555");
 }
+
+TEST(ByteData160, PointerConstructorAndAccessor) {
+  std::vector<uint8_t> target(20);
+  for (size_t index = 0; index < target.size(); ++index) {
+    target[index] = static_cast<uint8_t>(index);
+  }
+  ByteData160 byte_data(target.data(), target.size());
+  EXPECT_EQ(20, byte_data.size());
+  EXPECT_EQ(target, std::vector<uint8_t>(byte_data.begin(), byte_data.end()));
+  EXPECT_EQ(0, memcmp(target.data(), byte_data.data(), byte_data.size()));
+  EXPECT_TRUE(byte_data.Equals(ByteData160(target)));
+  EXPECT_FALSE(byte_data.IsEmpty());
+
+  EXPECT_THROW(
+      ByteData160(target.data(), target.size() + 1), cfd::core::CfdException);
+}
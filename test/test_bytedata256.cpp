@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <unordered_set>
+#include <cstring>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -162,3 +164,44 @@ TEST(ByteData256, Concat) {
   EXPECT_NO_THROW(result = base.Concat(data1, data2, data3));
   EXPECT_STREQ(result.GetHex().c_str(), "1111111111111111111111111111111111111111111111111111111111111111223344444444444444444444444444444444444444445555555555555555555555555555555555555555555555555555555555555555");
 }
+
+TEST(ByteData256, PointerConstructorAndAccessor) {
+  std::vector<uint8_t> target(32);
+  for (size_t index = 0; index < target.size(); ++index) {
+    target[index] = static_cast<uint8_t>(index);
+  }
+  ByteData256 byte_data(target.data(), target.size());
+  EXPECT_EQ(32, byte_data.size());
+  EXPECT_EQ(target, std::vector<uint8_t>(byte_data.begin(), byte_data.end()));
+  EXPECT_EQ(0, memcmp(target.data(), byte_data.data(), byte_data.size()));
+  EXPECT_TRUE(byte_data.Equals(ByteData256(target)));
+  EXPECT_FALSE(byte_data.IsEmpty());
+
+  EXPECT_THROW(
+      ByteData256(target.data(), target.size() - 1), cfd::core::CfdException);
+}
+
+TEST(ByteData256, OperatorsAndHash) {
+  ByteData256 data1(
+      "1234567890123456789012345678901234567890123456789012345678901234");
+  ByteData256 data2(
+      "1234567890123456789012345678901234567890123456789012345678901234");
+  ByteData256 data3(
+      "1234567890123456789012345678901234567890123456789012345678901235");
+  EXPECT_TRUE(data1 == data2);
+  EXPECT_TRUE(data1 != data3);
+  EXPECT_FALSE(data1 != data2);
+  EXPECT_TRUE(data1 < data3);
+  EXPECT_FALSE(data3 < data1);
+  EXPECT_FALSE(data1 < data2);
+
+  std::hash<ByteData256> hasher;
+  EXPECT_EQ(hasher(data1), hasher(data2));
+  std::unordered_set<ByteData256> set = {data1, data2, data3};
+  EXPECT_EQ(set.size(), static_cast<size_t>(2));
+
+  // the whole value is hashed, not only the first bytes.
+  ByteData256 data4(
+      "1234567890123456789012345678901234567890123456789012345678901230");
+  EXPECT_NE(hasher(data3), hasher(data4));
+}
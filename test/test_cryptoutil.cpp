@@ -10,6 +10,7 @@
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::ByteDataView;
 using cfd::core::CfdException;
 using cfd::core::CryptoUtil;
 using cfd::core::SigHashType;
@@ -640,6 +641,106 @@ TEST(CryptoUtil, DecodeBase58CheckDataEmpty) {
   ASSERT_TRUE(false);
 }
 
+TEST(CryptoUtil, Base58LeadingZero) {
+  ByteData data("0000000102");
+  std::string result = CryptoUtil::EncodeBase58(data);
+  EXPECT_STREQ(result.c_str(), "1115T");
+  EXPECT_STREQ(
+      CryptoUtil::DecodeBase58(result).GetHex().c_str(), data.GetHex().c_str());
+  EXPECT_STREQ(CryptoUtil::EncodeBase58(ByteData("00")).c_str(), "1");
+  EXPECT_THROW(CryptoUtil::DecodeBase58("1110"), CfdException);
+  EXPECT_THROW(CryptoUtil::DecodeBase58Check("1115T"), CfdException);
+}
+
+TEST(CryptoUtil, Base58CheckBatch) {
+  std::vector<ByteData> data_list = {
+      ByteData(
+          "0488b21e051431616f00000000e6ba4088246b104837c62bd01fd8ba1cf2931ad1"
+          "a5376c2360a1f112f2cfc63c02acf89ab4e3daa79bceef2ebecee2af92712e6bf5"
+          "e4b0d10c74bbecc27ac13da8"),
+      ByteData("00"),
+      ByteData("0000f54a5851e9372b87810a8e60cdd2e7cfd80b6e31"),
+  };
+  std::vector<ByteDataView> inputs;
+  for (const auto& data : data_list) inputs.emplace_back(data);
+  std::vector<size_t> offsets;
+  std::string encoded = CryptoUtil::EncodeBase58CheckBatch(inputs, &offsets);
+  ASSERT_EQ(offsets.size(), inputs.size() + 1);
+  EXPECT_EQ(offsets.back(), encoded.size());
+  std::vector<std::string> strings;
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    strings.push_back(encoded.substr(
+        offsets[index], offsets[index + 1] - offsets[index]));
+    EXPECT_EQ(strings[index], CryptoUtil::EncodeBase58Check(data_list[index]));
+  }
+  EXPECT_STREQ(
+      strings[0].c_str(),
+      "xpub6FZeZ5vwcYiT6r7ZYKJhyUqBxMBvzSmb6SpPQCsSenGPrVjKk5SGW4JJpc7cKERN8w9KnJZcMgJA4B2cHnpGq5TahYrDvZSBY2EMLKPRMTT");
+
+  std::vector<uint8_t> decoded =
+      CryptoUtil::DecodeBase58CheckBatch(strings, &offsets);
+  ASSERT_EQ(offsets.size(), strings.size() + 1);
+  for (size_t index = 0; index < strings.size(); ++index) {
+    ByteData data(std::vector<uint8_t>(
+        decoded.begin() + offsets[index], decoded.begin() + offsets[index + 1]));
+    EXPECT_EQ(data.GetHex(), data_list[index].GetHex());
+  }
+
+  strings.push_back("1115T");
+  EXPECT_THROW(
+      CryptoUtil::DecodeBase58CheckBatch(strings, &offsets), CfdException);
+  EXPECT_THROW(
+      CryptoUtil::EncodeBase58CheckBatch(inputs, nullptr), CfdException);
+}
+
+TEST(CryptoUtil, Base64RoundTrip) {
+  // cover the simd blocks and the remaining bytes.
+  for (size_t size = 0; size < 100; ++size) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t index = 0; index < size; ++index) {
+      bytes[index] = static_cast<uint8_t>(index * 71 + size);
+    }
+    std::string encoded = CryptoUtil::EncodeBase64(ByteData(bytes));
+    EXPECT_EQ(encoded.size(), ((size + 2) / 3) * 4);
+    EXPECT_EQ(CryptoUtil::DecodeBase64(encoded).GetBytes(), bytes);
+    if (!encoded.empty()) {
+      encoded[encoded.size() / 2] = '*';
+      EXPECT_TRUE(CryptoUtil::DecodeBase64(encoded).IsEmpty());
+    }
+  }
+  EXPECT_TRUE(CryptoUtil::DecodeBase64("QUJD=").IsEmpty());
+  EXPECT_STREQ(CryptoUtil::DecodeBase64("QUI=").GetHex().c_str(), "4142");
+}
+
+TEST(CryptoUtil, Base64Batch) {
+  std::vector<ByteData> data_list = {
+      ByteData("54686520717569636b2062726f776e20666f78"), ByteData(),
+      ByteData("0102"), ByteData("010203")};
+  std::vector<ByteDataView> inputs;
+  for (const auto& data : data_list) inputs.emplace_back(data);
+  std::vector<size_t> offsets;
+  std::string encoded = CryptoUtil::EncodeBase64Batch(inputs, &offsets);
+  ASSERT_EQ(offsets.size(), inputs.size() + 1);
+  EXPECT_EQ(offsets.back(), encoded.size());
+  std::vector<std::string> strings;
+  for (size_t index = 0; index < inputs.size(); ++index) {
+    strings.push_back(encoded.substr(
+        offsets[index], offsets[index + 1] - offsets[index]));
+    EXPECT_EQ(strings[index], CryptoUtil::EncodeBase64(data_list[index]));
+  }
+
+  strings.push_back("!!!!");
+  std::vector<uint8_t> decoded =
+      CryptoUtil::DecodeBase64Batch(strings, &offsets);
+  ASSERT_EQ(offsets.size(), strings.size() + 1);
+  for (size_t index = 0; index < data_list.size(); ++index) {
+    ByteData data(std::vector<uint8_t>(
+        decoded.begin() + offsets[index], decoded.begin() + offsets[index + 1]));
+    EXPECT_EQ(data.GetHex(), data_list[index].GetHex());
+  }
+  EXPECT_EQ(offsets[4], offsets[5]);
+}
+
 TEST(CryptoUtil, ComputeFastMerkleRootTest0) {
   // test_vectors from 
   // https://github.com/ElementsProject/elements/blob/66c015529e7846f8491bcafd986326bcafc1bfcb/src/test/merkle_tests.cpp#L256
@@ -8,6 +8,7 @@
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::ByteDataView;
 using cfd::core::Deserializer;
 
 TEST(Deserializer, Normal) {
@@ -54,3 +55,29 @@ TEST(Deserializer, BigEndian) {
   EXPECT_EQ(16, parser.GetReadSize());
   EXPECT_TRUE(parser.HasEof());
 }
+
+TEST(Deserializer, View) {
+  std::vector<uint8_t> buffer =
+      ByteData("010203040506070808090a0b0c0d0e0f").GetBytes();
+  Deserializer parser(ByteDataView(buffer.data(), buffer.size()));
+  EXPECT_EQ(1, parser.ReadUint8());
+  ByteDataView view = parser.ReadView(2);
+  EXPECT_EQ(buffer.data() + 1, view.data());
+  EXPECT_EQ("0203", view.GetHex());
+  parser.SkipBytes(4);
+
+  Deserializer parser2(parser);
+  ByteDataView data_view = parser.ReadVariableView();
+  EXPECT_EQ(buffer.data() + 8, data_view.data());
+  EXPECT_EQ("08090a0b0c0d0e0f", data_view.GetHex());
+  EXPECT_TRUE(parser.HasEof());
+  EXPECT_EQ(8, parser2.SkipVariableBuffer());
+  EXPECT_TRUE(parser2.HasEof());
+  EXPECT_THROW(parser2.SkipBytes(1), cfd::core::CfdException);
+
+  // owned buffer is rebound on copy.
+  Deserializer owned_parser(buffer);
+  Deserializer copy_parser(owned_parser);
+  buffer[0] = 0xff;
+  EXPECT_EQ(1, copy_parser.ReadUint8());
+}
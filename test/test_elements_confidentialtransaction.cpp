@@ -14,6 +14,7 @@ using cfd::core::CfdException;
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::ByteDataView;
 using cfd::core::BlindData;
 using cfd::core::BlindFactor;
 using cfd::core::Amount;
@@ -29,6 +30,7 @@ using cfd::core::ScriptOperator;
 using cfd::core::ScriptBuilder;
 using cfd::core::ScriptUtil;
 using cfd::core::ScriptWitness;
+using cfd::core::StringUtil;
 using cfd::core::ConfidentialValue;
 using cfd::core::ConfidentialAssetId;
 using cfd::core::ConfidentialNonce;
@@ -37,6 +39,9 @@ using cfd::core::ConfidentialTxInReference;
 using cfd::core::ConfidentialTxOut;
 using cfd::core::ConfidentialTxOutReference;
 using cfd::core::ConfidentialTransaction;
+using cfd::core::ConfidentialTransactionView;
+using cfd::core::ConfidentialTxInView;
+using cfd::core::ConfidentialTxOutView;
 using cfd::core::IssuanceParameter;
 using cfd::core::IssuanceBlindingKeyPair;
 using cfd::core::BlindParameter;
@@ -150,6 +155,21 @@ TEST(ConfidentialTransaction, ConstructorTest) {
   EXPECT_NO_THROW((tx = ConfidentialTransaction(tx_empty)));
   EXPECT_STREQ(tx.GetHex().c_str(), "0200000000000000000000");
 
+  // moved-from object holds no libwally tx.
+  ConfidentialTransaction tx_move(std::move(tx_null));
+  EXPECT_EQ(0, tx_null.GetVersion());
+  EXPECT_EQ(0, tx_null.GetTxInCount());
+  EXPECT_THROW(tx_null.GetHex(), CfdException);
+  tx = std::move(tx_move);
+  EXPECT_EQ(0, tx_move.GetLockTime());
+  EXPECT_NO_THROW(tx_move.AddTxOutFee(
+      Amount(int64_t{500}), ConfidentialAssetId(
+          "6f1a4b6bd5571b5f08ab79c314dc6483f9b952af2f5ef206cd6f8e68eb1186f3")));
+  EXPECT_EQ(1, tx_move.GetTxOutCount());
+  EXPECT_EQ(0, tx_move.GetVersion());
+  tx_null = tx_move;
+  EXPECT_EQ(tx_move.GetHex(), tx_null.GetHex());
+
   // illegal transaction
   //const std::string txout_empty = "";
   //EXPECT_NO_THROW((tx = ConfidentialTransaction(txout_empty)));
@@ -1991,4 +2011,117 @@ TEST(ConfidentialTransaction, SetTxInSequence) {
       tx.GetHex());
 }
 
+TEST(ConfidentialTransactionView, ParseTx) {
+  ByteData data(exp_tx_hex);
+  ConfidentialTransaction tx(data);
+  ConfidentialTransactionView view(data.GetBytes().data(), data.GetDataSize());
+  EXPECT_TRUE(view.IsValid());
+  EXPECT_EQ(tx.GetVersion(), view.GetVersion());
+  EXPECT_EQ(tx.GetLockTime(), view.GetLockTime());
+  EXPECT_FALSE(view.HasWitness());
+  EXPECT_EQ(tx.GetTxid().GetHex(), view.GetTxid().GetHex());
+  EXPECT_EQ(tx.GetVsize(), view.GetVsize());
+  EXPECT_EQ(tx.GetWeight(), view.GetWeight());
+
+  ASSERT_EQ(1, view.GetTxInCount());
+  const ConfidentialTxInView& txin = view.GetTxIn(0);
+  EXPECT_EQ(tx.GetTxIn(0).GetTxid().GetHex(), txin.GetTxid().GetHex());
+  EXPECT_EQ(1, txin.GetVout());
+  EXPECT_EQ(0xffffffff, txin.GetSequence());
+  EXPECT_FALSE(txin.HasIssuance());
+  EXPECT_FALSE(txin.IsPegin());
+  EXPECT_EQ(0, txin.GetBlindingNonceView().size());
+  EXPECT_EQ("", txin.GetIssuanceAmount().GetHex());
+
+  ASSERT_EQ(tx.GetTxOutCount(), view.GetTxOutCount());
+  uint32_t index = 0;
+  for (const ConfidentialTxOutView& txout : view.GetTxOutList()) {
+    const auto txout_ref = tx.GetTxOut(index);
+    EXPECT_EQ(txout_ref.GetAsset().GetHex(), txout.GetAsset().GetHex());
+    EXPECT_EQ(
+        txout_ref.GetConfidentialValue().GetHex(),
+        txout.GetConfidentialValue().GetHex());
+    EXPECT_EQ(txout_ref.GetNonce().GetHex(), txout.GetNonce().GetHex());
+    EXPECT_EQ(
+        txout_ref.GetLockingScript().GetHex(),
+        txout.GetLockingScript().GetHex());
+    EXPECT_EQ(0, txout.GetRangeProofView().size());
+    ++index;
+  }
+  EXPECT_EQ(1, view.GetTxOut(1).GetNonceView().size());
+  EXPECT_EQ(exp_tx_hex, view.GetTransaction().GetHex());
+}
+
+TEST(ConfidentialTransactionView, ParseIssuanceWitnessTx) {
+  ConfidentialTransaction tx(exp_tx_hex);
+  tx.AddTxIn(exp_txid, exp_index, exp_sequence, exp_script);
+  tx.SetIssuance(
+      1, exp_blinding_nonce, exp_asset_entropy, exp_issuance_amount,
+      exp_inflation_keys, exp_issuance_amount_rangeproof,
+      exp_inflation_keys_rangeproof);
+  ScriptWitness witness = GetExpectWitnessStack();
+  for (const auto& stack : witness.GetWitness()) {
+    tx.AddScriptWitnessStack(1, stack);
+  }
+  ByteData data = tx.GetData();
+  ByteDataView data_view(data);
+  ConfidentialTransactionView view(data_view);
+  EXPECT_TRUE(view.HasWitness());
+  EXPECT_EQ(tx.GetTxid().GetHex(), view.GetTxid().GetHex());
+  EXPECT_EQ(tx.GetWitnessHash().GetHex(), view.GetWitnessHash().GetHex());
+  EXPECT_EQ(tx.GetTotalSize(), view.GetTotalSize());
+  EXPECT_EQ(tx.GetVsize(), view.GetVsize());
+  EXPECT_EQ(tx.GetWeight(), view.GetWeight());
+
+  ASSERT_EQ(2, view.GetTxInCount());
+  const ConfidentialTxInView& txin = view.GetTxIn(1);
+  EXPECT_EQ(exp_txid.GetHex(), txin.GetTxid().GetHex());
+  EXPECT_EQ(exp_index, txin.GetVout());
+  EXPECT_EQ(exp_sequence, txin.GetSequence());
+  EXPECT_EQ(
+      exp_script.GetHex(),
+      StringUtil::ByteToString(txin.GetUnlockingScriptView()));
+  EXPECT_TRUE(txin.HasIssuance());
+  EXPECT_EQ(
+      exp_blinding_nonce.GetHex(),
+      StringUtil::ByteToString(txin.GetBlindingNonceView()));
+  EXPECT_EQ(
+      exp_asset_entropy.GetHex(),
+      StringUtil::ByteToString(txin.GetAssetEntropyView()));
+  EXPECT_EQ(exp_issuance_amount.GetHex(), txin.GetIssuanceAmount().GetHex());
+  EXPECT_EQ(exp_inflation_keys.GetHex(), txin.GetInflationKeys().GetHex());
+  EXPECT_EQ(
+      exp_issuance_amount_rangeproof.GetHex(),
+      StringUtil::ByteToString(txin.GetIssuanceAmountRangeproofView()));
+  EXPECT_EQ(
+      exp_inflation_keys_rangeproof.GetHex(),
+      StringUtil::ByteToString(txin.GetInflationKeysRangeproofView()));
+  ASSERT_EQ(witness.GetWitnessNum(), txin.GetScriptWitnessStackNum());
+  EXPECT_EQ(
+      witness.GetWitness()[1].GetHex(),
+      StringUtil::ByteToString(txin.GetScriptWitnessStack(1)));
+  EXPECT_EQ(0, txin.GetPeginWitnessStackNum());
+  EXPECT_THROW(txin.GetPeginWitnessStack(0), CfdException);
+  EXPECT_EQ(0, view.GetTxIn(0).GetScriptWitnessStackNum());
+}
+
+TEST(ConfidentialTransactionView, ParseError) {
+  ConfidentialTransactionView empty_view;
+  EXPECT_FALSE(empty_view.IsValid());
+
+  std::vector<uint8_t> bytes = ByteData(exp_tx_hex).GetBytes();
+  std::vector<uint8_t> short_bytes(bytes.begin(), bytes.end() - 1);
+  EXPECT_THROW(
+      ConfidentialTransactionView(short_bytes.data(), short_bytes.size()),
+      CfdException);
+  bytes.push_back(0);
+  EXPECT_THROW(
+      ConfidentialTransactionView(bytes.data(), bytes.size()), CfdException);
+  // invalid witness flag
+  bytes = ByteData(exp_tx_hex).GetBytes();
+  bytes[4] = 2;
+  EXPECT_THROW(
+      ConfidentialTransactionView(bytes.data(), bytes.size()), CfdException);
+}
+
 #endif  // CFD_DISABLE_ELEMENTS
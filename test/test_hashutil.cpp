@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <string>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -10,9 +11,13 @@
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::ByteDataView;
 using cfd::core::HashUtil;
 using cfd::core::Pubkey;
 using cfd::core::Script;
+using cfd::core::Sha256Hasher;
+using cfd::core::Sha256Implementation;
+using cfd::core::TaggedHashTag;
 
 // Hash tool
 // https://bc-2.jp/tools/txeditor2.html
@@ -347,3 +352,170 @@ TEST(HashUtil, operator) {
       hash_util2.Output().GetHex(),
       "7ad6132c2611fd0496ad42c758edc1bc2a23c3a4c463e139e144e25c35a53765c4c4c99d68d821a1bdd71b10e88afebdba72bfa0ae3877f628f1e2eab5320229");
 }
+
+TEST(HashUtil, ByteDataView) {
+  ByteData data("0102030405060708090a");
+  ByteDataView view(data);
+  EXPECT_EQ(HashUtil::Ripemd160(data).GetHex(),
+      HashUtil::Ripemd160(view).GetHex());
+  EXPECT_EQ(HashUtil::Hash160(data).GetHex(),
+      HashUtil::Hash160(view).GetHex());
+  EXPECT_EQ(HashUtil::Sha256(data).GetHex(), HashUtil::Sha256(view).GetHex());
+  EXPECT_EQ(HashUtil::Sha256D(data).GetHex(),
+      HashUtil::Sha256D(view).GetHex());
+  EXPECT_EQ(HashUtil::Sha256(ByteData("0304")).GetHex(),
+      HashUtil::Sha256(view.GetSubView(2, 2)).GetHex());
+}
+
+TEST(HashUtil, Streaming) {
+  std::vector<uint8_t> bytes(200);
+  for (size_t index = 0; index < bytes.size(); ++index) {
+    bytes[index] = static_cast<uint8_t>(index * 7 + 3);
+  }
+  ByteData data(bytes);
+  ByteDataView view(data);
+  const uint8_t hash_types[] = {
+      HashUtil::kRipemd160, HashUtil::kHash160, HashUtil::kSha256,
+      HashUtil::kSha256D, HashUtil::kSha512};
+  const std::vector<ByteData> expects = {
+      HashUtil::Ripemd160(data).GetData(), HashUtil::Hash160(data).GetData(),
+      HashUtil::Sha256(data).GetData(), HashUtil::Sha256D(data).GetData(),
+      HashUtil::Sha512(data)};
+  for (size_t index = 0; index < expects.size(); ++index) {
+    HashUtil hash_util(hash_types[index]);
+    hash_util << view.GetSubView(0, 1) << view.GetSubView(1, 63)
+              << view.GetSubView(64, 100) << view.GetSubView(164, 36);
+    EXPECT_EQ(hash_util.Output().GetHex(), expects[index].GetHex());
+    // output does not change the running state.
+    EXPECT_EQ(hash_util.Output().GetHex(), expects[index].GetHex());
+  }
+}
+
+TEST(HashUtil, Midstate) {
+  ByteData prefix(std::vector<uint8_t>(64, 0x11));
+  HashUtil hash_util(HashUtil::kSha256);
+  hash_util << prefix;
+  HashUtil branch1(hash_util);
+  HashUtil branch2(hash_util);
+  branch1 << "branch1";
+  branch2 << "branch2";
+  EXPECT_EQ(branch1.Output256().GetHex(),
+      (HashUtil(HashUtil::kSha256) << prefix << "branch1").Output256().GetHex());
+  EXPECT_EQ(branch2.Output256().GetHex(),
+      (HashUtil(HashUtil::kSha256) << prefix << "branch2").Output256().GetHex());
+
+  Sha256Hasher hasher;
+  hasher.Write(prefix.data(), prefix.size());
+  uint32_t midstate[Sha256Hasher::kStateSize];
+  hasher.GetMidstate(midstate);
+  Sha256Hasher restore(midstate, hasher.GetLength());
+  restore.Write(reinterpret_cast<const uint8_t*>("branch1"), 7);
+  EXPECT_EQ(restore.Finalize().GetHex(), branch1.Output256().GetHex());
+
+  try {
+    Sha256Hasher invalid(midstate, 1);
+  } catch (const cfd::core::CfdException& except) {
+    EXPECT_STREQ(except.what(), "Invalid sha256 midstate.");
+    return;
+  }
+  ASSERT_TRUE(false);
+}
+
+TEST(HashUtil, CreateTaggedHash) {
+  const std::vector<std::string> tags = {
+      "TapLeaf", "TapBranch", "TapTweak", "TapSighash",
+      "BIP0340/challenge", "BIP0340/aux", "BIP0340/nonce"};
+  ByteData msg("0102030405060708090a");
+  for (size_t index = 0; index < tags.size(); ++index) {
+    ByteData256 tag_hash = HashUtil::Sha256(tags[index]);
+    ByteData256 expect = HashUtil::Sha256(
+        tag_hash.GetData().Concat(tag_hash, msg));
+    auto tag = static_cast<TaggedHashTag>(index);
+    EXPECT_EQ((HashUtil::CreateTaggedHash(tag) << msg).Output256().GetHex(),
+        expect.GetHex());
+    EXPECT_EQ((HashUtil::CreateTaggedHash(tags[index]) << msg)
+        .Output256().GetHex(), expect.GetHex());
+    EXPECT_EQ(Sha256Hasher::CreateTaggedHasher(tag).GetLength(), 64);
+  }
+  EXPECT_THROW(
+      HashUtil::CreateTaggedHash(cfd::core::kTaggedHashTagCount),
+      cfd::core::CfdException);
+}
+
+TEST(HashUtil, Sha256Implementation) {
+  std::vector<uint8_t> bytes(1000);
+  for (size_t index = 0; index < bytes.size(); ++index) {
+    bytes[index] = static_cast<uint8_t>(index * 13 + 5);
+  }
+  const Sha256Implementation current = Sha256Hasher::GetImplementation();
+  EXPECT_TRUE(Sha256Hasher::IsSupportedImplementation(current));
+  EXPECT_TRUE(
+      Sha256Hasher::IsSupportedImplementation(cfd::core::kSha256Portable));
+
+  Sha256Hasher::SetImplementation(cfd::core::kSha256Portable);
+  std::vector<ByteData256> expects;
+  for (size_t size : {0, 55, 56, 64, 65, 128, 1000}) {
+    expects.push_back(Sha256Hasher().Write(bytes.data(), size).Finalize());
+  }
+  EXPECT_STREQ(expects[0].GetHex().c_str(),
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+  const Sha256Implementation implementations[] = {
+      cfd::core::kSha256X86ShaNi, cfd::core::kSha256ArmV8,
+      cfd::core::kSha256X86Avx2};
+  for (const auto implementation : implementations) {
+    if (!Sha256Hasher::IsSupportedImplementation(implementation)) {
+      EXPECT_THROW(
+          Sha256Hasher::SetImplementation(implementation),
+          cfd::core::CfdException);
+      continue;
+    }
+    Sha256Hasher::SetImplementation(implementation);
+    size_t index = 0;
+    for (size_t size : {0, 55, 56, 64, 65, 128, 1000}) {
+      EXPECT_EQ(Sha256Hasher().Write(bytes.data(), size).Finalize().GetHex(),
+          expects[index].GetHex());
+      ++index;
+    }
+  }
+  Sha256Hasher::SetImplementation(current);
+}
+
+TEST(HashUtil, Batch) {
+  std::vector<uint8_t> bytes(300);
+  for (size_t index = 0; index < bytes.size(); ++index) {
+    bytes[index] = static_cast<uint8_t>(index * 7 + 3);
+  }
+  std::vector<ByteDataView> inputs;
+  for (size_t size = 0; size < bytes.size(); size += 11) {
+    inputs.emplace_back(bytes.data(), size);
+  }
+  inputs.emplace_back(bytes.data(), 64);
+  inputs.emplace_back(bytes.data(), 64);
+
+  const Sha256Implementation current = Sha256Hasher::GetImplementation();
+  const Sha256Implementation implementations[] = {
+      cfd::core::kSha256Portable, cfd::core::kSha256X86ShaNi,
+      cfd::core::kSha256ArmV8, cfd::core::kSha256X86Avx2};
+  for (const auto implementation : implementations) {
+    if (!Sha256Hasher::IsSupportedImplementation(implementation)) continue;
+    Sha256Hasher::SetImplementation(implementation);
+    std::vector<ByteData256> sha256_list = HashUtil::Sha256Batch(inputs);
+    std::vector<ByteData256> sha256d_list = HashUtil::Sha256DBatch(inputs);
+    std::vector<ByteData160> hash160_list = HashUtil::Hash160Batch(inputs);
+    ASSERT_EQ(sha256_list.size(), inputs.size());
+    ASSERT_EQ(sha256d_list.size(), inputs.size());
+    ASSERT_EQ(hash160_list.size(), inputs.size());
+    for (size_t index = 0; index < inputs.size(); ++index) {
+      EXPECT_EQ(sha256_list[index].GetHex(),
+          HashUtil::Sha256(inputs[index]).GetHex());
+      EXPECT_EQ(sha256d_list[index].GetHex(),
+          HashUtil::Sha256D(inputs[index]).GetHex());
+      EXPECT_EQ(hash160_list[index].GetHex(),
+          HashUtil::Hash160(inputs[index]).GetHex());
+    }
+  }
+  Sha256Hasher::SetImplementation(current);
+
+  EXPECT_TRUE(HashUtil::Sha256Batch(std::vector<ByteDataView>()).empty());
+}
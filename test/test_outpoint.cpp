@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <unordered_map>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -94,3 +95,27 @@ TEST(OutPoint, Operators) {
 
   EXPECT_TRUE((outpoint4 < outpoint3));
 }
+
+TEST(OutPoint, CompareAndHash) {
+  Txid txid1("0000000000000000000000000000000000000000000000000000000000000002");
+  Txid txid2("0100000000000000000000000000000000000000000000000000000000000000");
+  OutPoint outpoint1(txid1, 1);
+  OutPoint outpoint2(txid2, 1);
+  // the same order as the txid hex string.
+  EXPECT_LT(outpoint1.Compare(outpoint2), 0);
+  EXPECT_GT(outpoint2.Compare(outpoint1), 0);
+  EXPECT_EQ(outpoint1.Compare(OutPoint(txid1, 1)), 0);
+  EXPECT_LT(OutPoint().Compare(OutPoint(Txid(ByteData256()), 0)), 0);
+  EXPECT_EQ(OutPoint().Compare(OutPoint()), 0);
+
+  std::hash<OutPoint> hasher;
+  EXPECT_EQ(hasher(outpoint1), hasher(OutPoint(txid1, 1)));
+  EXPECT_NE(hasher(outpoint1), hasher(OutPoint(txid1, 2)));
+  std::unordered_map<OutPoint, int> map;
+  map[outpoint1] = 1;
+  map[outpoint2] = 2;
+  map[OutPoint(txid1, 2)] = 3;
+  EXPECT_EQ(map.size(), static_cast<size_t>(3));
+  EXPECT_EQ(map[OutPoint(txid1, 1)], 1);
+  EXPECT_EQ(map[OutPoint(txid2, 1)], 2);
+}
@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <type_traits>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -400,6 +401,44 @@ static const std::string g_psbt_seed1 = "8bc106907003ea0b55f3ed4ce2fcf9a198d8c43
 static const std::string g_psbt_seed2 = "d3e3539eafb6af1f0ae374ecffd33bed394f5eb2e39f8957be63c258ac32ca97";
 // 44'/0'/0': tprv8fbPrDdF7Cdde4fLncessNymvfuvREAzhoMmfs3XqCuLcNVB9didfgXgb5V1NrxkqF7ZKibuyib4n6bujk1L5NfgVYnZZCwuyDdT21JAquv
 
+TEST(Psbt, CopyAndMove) {
+  CfdPsbtTestData data;
+  for (const auto& test_data : g_cfd_psbt_testdata) {
+    if (test_data.error_message.empty()) {
+      data = test_data;
+      break;
+    }
+  }
+  ASSERT_FALSE(data.hex.empty());
+  Psbt base_psbt(data.base64);
+  Psbt copy_psbt(base_psbt);
+  EXPECT_EQ(data.hex, copy_psbt.GetData().GetHex());
+  EXPECT_EQ(base_psbt.GetTransaction().GetHex(),
+      copy_psbt.GetTransaction().GetHex());
+
+  Psbt assign_psbt;
+  assign_psbt = copy_psbt;
+  EXPECT_EQ(data.hex, assign_psbt.GetData().GetHex());
+
+  Psbt move_psbt(std::move(assign_psbt));
+  EXPECT_EQ(data.hex, move_psbt.GetData().GetHex());
+  assign_psbt = Psbt();
+  move_psbt = std::move(assign_psbt);
+  EXPECT_STREQ("70736274ff01000a0200000000000000000000",
+      move_psbt.GetData().GetHex().c_str());
+  EXPECT_EQ(data.hex, base_psbt.GetData().GetHex());
+
+  // moved-from object throws instead of dereferencing null.
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Psbt>::value);
+  EXPECT_THROW(assign_psbt.GetData(), CfdException);
+  EXPECT_THROW(assign_psbt.GetTxInCount(), CfdException);
+  EXPECT_THROW(assign_psbt.AddTxOut(Script("51"), Amount(int64_t{1000})),
+      CfdException);
+  EXPECT_THROW(assign_psbt.GetGlobalRecordKeyList(), CfdException);
+  assign_psbt = base_psbt;
+  EXPECT_EQ(data.hex, assign_psbt.GetData().GetHex());
+}
+
 TEST(Psbt, SetTxInOnly) {
   Psbt psbt;
   EXPECT_EQ(0, psbt.GetTxInCount());
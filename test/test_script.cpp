@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -63,6 +65,26 @@ TEST(Script, Script_bytedata) {
   EXPECT_EQ(script.GetElementList().size(), size);
 }
 
+TEST(Script, MoveAndReferenceAccessor) {
+  size_t size = 25;
+  size_t element_size = 5;
+  Script script("76a91498e977b2259a85278aa51188bd863a3df0ad31ba88ac");
+  const ByteData& data = script.GetData();
+  EXPECT_EQ(&data, &script.GetData());
+  EXPECT_EQ(script.GetData().GetBytes().size(), size);
+
+  Script moved(std::move(script));
+  EXPECT_STREQ(moved.GetHex().c_str(),
+               "76a91498e977b2259a85278aa51188bd863a3df0ad31ba88ac");
+  EXPECT_EQ(moved.GetElementList().size(), element_size);
+
+  Script assigned;
+  assigned = std::move(moved);
+  EXPECT_STREQ(assigned.GetHex().c_str(),
+               "76a91498e977b2259a85278aa51188bd863a3df0ad31ba88ac");
+  EXPECT_EQ(Script(assigned).GetData().GetDataSize(), size);
+}
+
 TEST(Script, SetStackData_OP0) {
   // script作成
   ScriptBuilder builder;
@@ -549,3 +571,29 @@ TEST(Script, ParseCoinbaseScriptsigTest) {
       list[2].GetBinaryData().GetHex());
   }
 }
+
+TEST(Script, OperatorsAndHash) {
+  Script script1("76a914925d4028880bd0c9d68fbc7fc7dfee976698629c88ac");
+  Script script2("76a914925d4028880bd0c9d68fbc7fc7dfee976698629c88ac");
+  Script script3("0014925d4028880bd0c9d68fbc7fc7dfee976698629c");
+  Script script4("76a9");
+  EXPECT_TRUE(script1 == script2);
+  EXPECT_FALSE(script1 != script2);
+  EXPECT_TRUE(script1 != script3);
+  EXPECT_TRUE(script3 < script1);
+  EXPECT_FALSE(script1 < script3);
+  EXPECT_TRUE(script4 < script1);
+  EXPECT_TRUE(Script() < script4);
+  EXPECT_FALSE(script1 < script2);
+
+  std::hash<Script> hasher;
+  EXPECT_EQ(hasher(script1), hasher(script2));
+  EXPECT_NE(hasher(script1), hasher(script3));
+  std::unordered_map<Script, int> map;
+  map[script1] = 1;
+  map[script3] = 3;
+  map[Script()] = 0;
+  EXPECT_EQ(map.size(), static_cast<size_t>(3));
+  EXPECT_EQ(map[script2], 1);
+  EXPECT_EQ(map[Script()], 0);
+}
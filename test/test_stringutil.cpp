@@ -66,6 +66,57 @@ TEST(StringUtil, ByteToStringEmpty) {
   EXPECT_STREQ(result.c_str(), "");
 }
 
+TEST(StringUtil, HexRoundTrip) {
+  // cover the simd blocks and the remaining bytes.
+  for (size_t size = 0; size < 200; ++size) {
+    std::vector<uint8_t> bytes(size);
+    std::string expect;
+    for (size_t index = 0; index < size; ++index) {
+      bytes[index] = static_cast<uint8_t>(index * 37 + size);
+      static const char kHex[] = "0123456789abcdef";
+      expect += kHex[bytes[index] >> 4];
+      expect += kHex[bytes[index] & 0x0f];
+    }
+    std::string hex = StringUtil::ByteToString(bytes);
+    EXPECT_EQ(hex, expect);
+    EXPECT_EQ(StringUtil::StringToByte(hex), bytes);
+    std::string upper_hex = hex;
+    for (auto& character : upper_hex) {
+      if ((character >= 'a') && (character <= 'f')) character -= 0x20;
+    }
+    EXPECT_EQ(StringUtil::StringToByte(upper_hex), bytes);
+    EXPECT_TRUE(StringUtil::IsValidHexString(hex));
+  }
+}
+
+TEST(StringUtil, HexCallerBuffer) {
+  std::string hex =
+      "6AF0D7ADEF48DE1E90DDE0423D4B1ECC72B60EC0A33C716C397BC50F9662B581";
+  uint8_t bytes[32];
+  StringUtil::StringToByte(hex.data(), hex.size(), bytes);
+  char output[64];
+  StringUtil::ByteToString(bytes, sizeof(bytes), output);
+  EXPECT_EQ(std::string(output, sizeof(output)), StringUtil::ToLower(hex));
+  EXPECT_THROW(
+      StringUtil::StringToByte(hex.data(), hex.size() - 1, bytes),
+      cfd::core::CfdException);
+  EXPECT_NO_THROW(StringUtil::StringToByte(hex.data(), 0, nullptr));
+  EXPECT_NO_THROW(StringUtil::ByteToString(bytes, 0, nullptr));
+}
+
+TEST(StringUtil, HexInvalidCharacter) {
+  std::string base(160, 'a');
+  for (size_t index = 0; index < base.size(); index += 13) {
+    for (char character : {'g', 'G', '/', ':', '@', '`', ' ', '\x80'}) {
+      std::string target = base;
+      target[index] = character;
+      EXPECT_FALSE(StringUtil::IsValidHexString(target));
+      EXPECT_THROW(
+          StringUtil::StringToByte(target), cfd::core::CfdException);
+    }
+  }
+}
+
 TEST(StringUtil, ToLower) {
   std::string result = StringUtil::ToLower("AbCdE_1fg");
   EXPECT_STREQ(result.c_str(), "abcde_1fg");
@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <thread>  // NOLINT
+#include <type_traits>
 #include <vector>
 
 #include "cfdcore/cfdcore_address.h"
@@ -19,6 +21,7 @@ using cfd::core::Amount;
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::ByteDataView;
 using cfd::core::CfdException;
 using cfd::core::CryptoUtil;
 using cfd::core::HashType;
@@ -33,11 +36,16 @@ using cfd::core::ScriptOperator;
 using cfd::core::ScriptUtil;
 using cfd::core::SigHashAlgorithm;
 using cfd::core::SigHashType;
+using cfd::core::StringUtil;
 using cfd::core::Transaction;
+using cfd::core::TransactionView;
 using cfd::core::Txid;
+using cfd::core::TxIn;
 using cfd::core::TxInReference;
+using cfd::core::TxInView;
 using cfd::core::TxOut;
 using cfd::core::TxOutReference;
+using cfd::core::TxOutView;
 using cfd::core::WitnessVersion;
 
 static const int32_t exp_version = 2;
@@ -259,6 +267,58 @@ TEST(Transaction, operator_equal) {
   EXPECT_EQ(tx.HasWitness(), false);
 }
 
+TEST(Transaction, CopyAndMove) {
+  Transaction base_tx(exp_tx_witness);
+  Transaction copy_tx(base_tx);
+  EXPECT_EQ(exp_tx_witness, copy_tx.GetHex());
+  EXPECT_EQ(base_tx.GetTxInCount(), copy_tx.GetTxInCount());
+  EXPECT_EQ(base_tx.GetTxOutCount(), copy_tx.GetTxOutCount());
+  EXPECT_EQ(base_tx.GetScriptWitnessStackNum(0),
+      copy_tx.GetScriptWitnessStackNum(0));
+
+  // deep copy
+  copy_tx.RemoveScriptWitnessStackAll(0);
+  copy_tx.SetTxOutValue(0, Amount(int64_t{1000}));
+  EXPECT_EQ(exp_tx_witness, base_tx.GetHex());
+  EXPECT_NE(exp_tx_witness, copy_tx.GetHex());
+
+  Transaction assign_tx(3, 3);
+  assign_tx = base_tx;
+  EXPECT_EQ(exp_tx_witness, assign_tx.GetHex());
+  assign_tx = copy_tx;
+  EXPECT_EQ(copy_tx.GetHex(), assign_tx.GetHex());
+
+  Transaction move_tx(std::move(assign_tx));
+  EXPECT_EQ(copy_tx.GetHex(), move_tx.GetHex());
+  EXPECT_EQ(1, move_tx.GetTxInCount());
+  assign_tx = Transaction(exp_tx_legacy);
+  EXPECT_EQ(exp_tx_legacy, assign_tx.GetHex());
+  move_tx = std::move(assign_tx);
+  EXPECT_EQ(exp_tx_legacy, move_tx.GetHex());
+  EXPECT_EQ("85a37a01f7924c7ee95e948274c306fee1b6a0731722da5039c900d43561a590",
+      move_tx.GetTxid().GetHex());
+
+  // moved-from object reads as an empty transaction with version 0.
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Transaction>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<Transaction>::value);
+  const std::string empty_hex = Transaction(0, 0).GetHex();
+  EXPECT_EQ(0, assign_tx.GetVersion());
+  EXPECT_EQ(0, assign_tx.GetLockTime());
+  EXPECT_EQ(0, assign_tx.GetTxInCount());
+  EXPECT_EQ(empty_hex, assign_tx.GetHex());
+  Transaction moved_tx(std::move(move_tx));
+  EXPECT_EQ(exp_tx_legacy, moved_tx.GetHex());
+  EXPECT_EQ(empty_hex, move_tx.GetHex());
+  Transaction copy_moved_tx(move_tx);
+  EXPECT_EQ(empty_hex, copy_moved_tx.GetHex());
+  move_tx.AddTxOut(Amount(int64_t{1000}), Script("51"));
+  EXPECT_EQ(1, move_tx.GetTxOutCount());
+  EXPECT_EQ(0, move_tx.GetVersion());
+  Transaction expect_tx(0, 0);
+  expect_tx.AddTxOut(Amount(int64_t{1000}), Script("51"));
+  EXPECT_EQ(expect_tx.GetHex(), move_tx.GetHex());
+}
+
 TEST(Transaction, AddTxIn_RemoveTxIn) {
   Transaction tx(exp_version, exp_locktime);
 
@@ -409,6 +469,144 @@ TEST(Transaction, AddTxOut_RemoveTxOut) {
   EXPECT_THROW(tx.GetTxOut(0), CfdException);
 }
 
+TEST(Transaction, GetTxInIndex_GetTxOutIndex_Indexed) {
+  // 20 inputs / outputs: lookups go through the hash index.
+  Transaction tx(exp_version, exp_locktime);
+  Txid txid1("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+  Txid txid2("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f");
+  Script script1("76a9143f1f881ea0e079888a8a9d65025aacf6b98f853588ac");
+  Script script2("a9142699570770f32e0cf3e1d12d81064fbc45899e8a87");
+  Amount amount = Amount::CreateBySatoshiAmount(1000);
+  for (uint32_t index = 0; index < 20; ++index) {
+    tx.AddTxIn(txid1, index, 0xffffffff);
+    tx.AddTxOut(amount, ((index % 4) == 0) ? script2 : script1);
+  }
+
+  EXPECT_EQ(0, tx.GetTxInIndex(txid1, 0));
+  EXPECT_EQ(19, tx.GetTxInIndex(txid1, 19));
+  EXPECT_THROW(tx.GetTxInIndex(txid2, 0), CfdException);
+  EXPECT_EQ(1, tx.GetTxOutIndex(script1));
+  EXPECT_EQ(0, tx.GetTxOutIndex(script2));
+  std::vector<uint32_t> index_list = tx.GetTxOutIndexList(script2);
+  EXPECT_EQ(std::vector<uint32_t>({0, 4, 8, 12, 16}), index_list);
+  EXPECT_THROW(
+      tx.GetTxOutIndex(Script("6a0100")), CfdException);
+
+  // the index follows add / remove.
+  tx.RemoveTxIn(0);
+  tx.AddTxIn(txid2, 0, 0xffffffff);
+  EXPECT_EQ(18, tx.GetTxInIndex(txid1, 19));
+  EXPECT_EQ(19, tx.GetTxInIndex(txid2, 0));
+  EXPECT_THROW(tx.GetTxInIndex(txid1, 0), CfdException);
+  tx.RemoveTxOut(0);
+  tx.AddTxOut(amount, script2);
+  index_list = tx.GetTxOutIndexList(script2);
+  EXPECT_EQ(std::vector<uint32_t>({3, 7, 11, 15, 19}), index_list);
+  EXPECT_EQ(0, tx.GetTxOutIndex(script1));
+
+  // copy / move
+  Transaction copy_tx(tx);
+  EXPECT_EQ(19, copy_tx.GetTxInIndex(txid2, 0));
+  Transaction move_tx(std::move(copy_tx));
+  EXPECT_EQ(19, move_tx.GetTxInIndex(txid2, 0));
+  EXPECT_EQ(3, move_tx.GetTxOutIndex(script2));
+}
+
+TEST(Transaction, LazyWallyTxUpdate) {
+  Transaction tx(exp_version, exp_locktime);
+  Txid txid("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+  Script script("76a9143f1f881ea0e079888a8a9d65025aacf6b98f853588ac");
+  tx.AddTxIn(txid, 0, 0xffffffff);
+  tx.AddTxIn(txid, 1, 0xffffffff);
+  tx.AddTxOut(Amount::CreateBySatoshiAmount(1000), script);
+  tx.AddTxOut(Amount::CreateBySatoshiAmount(2000), script);
+  EXPECT_EQ(3000, tx.GetValueOut().GetSatoshiValue());
+
+  // every read after a mutation reflects vin_ / vout_.
+  tx.SetTxOutValue(1, Amount::CreateBySatoshiAmount(5000));
+  EXPECT_EQ(6000, tx.GetValueOut().GetSatoshiValue());
+  tx.SetTxInSequence(1, 0xfffffffe);
+  tx.AddScriptWitnessStack(0, ByteData("0102"));
+  tx.AddScriptWitnessStack(0, ByteData());
+  tx.RemoveTxIn(1);
+  tx.RemoveTxOut(0);
+  std::string hex = tx.GetHex();
+  Transaction parsed(hex);
+  EXPECT_EQ(hex, parsed.GetHex());
+  EXPECT_EQ(parsed.GetTotalSize(), tx.GetTotalSize());
+  EXPECT_EQ(parsed.GetVsize(), tx.GetVsize());
+  EXPECT_EQ(parsed.GetWeight(), tx.GetWeight());
+  EXPECT_EQ(5000, tx.GetValueOut().GetSatoshiValue());
+  EXPECT_FALSE(tx.IsCoinBase());
+
+  // copy keeps the pending update.
+  tx.SetTxInSequence(0, 0);
+  Transaction copy_tx(tx);
+  EXPECT_EQ(tx.GetHex(), copy_tx.GetHex());
+  EXPECT_EQ(0, Transaction(copy_tx.GetHex()).GetTxIn(0).GetSequence());
+  EXPECT_THROW(tx.SetScriptWitnessStack(0, 2, ByteData("01")), CfdException);
+}
+
+TEST(Transaction, AddTxInList_AddTxOutList) {
+  Txid txid("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+  Script script("76a9143f1f881ea0e079888a8a9d65025aacf6b98f853588ac");
+  std::vector<TxIn> txin_list;
+  std::vector<TxOut> txout_list;
+  Transaction expect_tx(exp_version, exp_locktime);
+  for (uint32_t index = 0; index < 3; ++index) {
+    txin_list.emplace_back(txid, index, 0xfffffffe);
+    txout_list.emplace_back(
+        Amount::CreateBySatoshiAmount(1000 + index), script);
+    expect_tx.AddTxIn(txid, index, 0xfffffffe);
+    expect_tx.AddTxOut(Amount::CreateBySatoshiAmount(1000 + index), script);
+  }
+
+  Transaction tx(exp_version, exp_locktime, txin_list, txout_list);
+  EXPECT_EQ(expect_tx.GetHex(), tx.GetHex());
+
+  Transaction tx2(exp_version, exp_locktime);
+  tx2.Reserve(6, 6);
+  EXPECT_EQ(0, tx2.AddTxInList(txin_list));
+  EXPECT_EQ(0, tx2.AddTxOutList(txout_list));
+  EXPECT_EQ(expect_tx.GetHex(), tx2.GetHex());
+  EXPECT_EQ(3, tx2.AddTxInList(txin_list));
+  EXPECT_EQ(3, tx2.AddTxOutList(txout_list));
+  EXPECT_EQ(6, tx2.AddTxInList(std::vector<TxIn>()));
+  EXPECT_EQ(6, tx2.GetTxInCount());
+  EXPECT_EQ(6, tx2.GetTxOutCount());
+  EXPECT_EQ(4, tx2.GetTxOutIndexList(script)[4]);
+  EXPECT_EQ(6, Transaction(tx2.GetHex()).GetTxOutCount());
+}
+
+TEST(Transaction, CachedTxidAndSize) {
+  Transaction tx(exp_version, exp_locktime);
+  Txid txid("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+  Script script("76a9143f1f881ea0e079888a8a9d65025aacf6b98f853588ac");
+  tx.AddTxIn(txid, 0, 0xffffffff);
+  tx.AddTxOut(Amount::CreateBySatoshiAmount(1000), script);
+  Txid base_txid = tx.GetTxid();
+  EXPECT_TRUE(base_txid.Equals(tx.GetTxid()));
+  EXPECT_EQ(base_txid.GetData().GetHex(), tx.GetWitnessHash().GetHex());
+  uint32_t base_vsize = tx.GetVsize();
+  EXPECT_EQ(base_vsize, tx.GetVsize());
+
+  // each mutation drops the cached values.
+  tx.AddScriptWitnessStack(0, ByteData("0102"));
+  EXPECT_TRUE(base_txid.Equals(tx.GetTxid()));
+  EXPECT_NE(base_txid.GetData().GetHex(), tx.GetWitnessHash().GetHex());
+  EXPECT_EQ(Transaction(tx.GetHex()).GetTotalSize(), tx.GetTotalSize());
+  EXPECT_EQ(Transaction(tx.GetHex()).GetWeight(), tx.GetWeight());
+  tx.SetTxOutValue(0, Amount::CreateBySatoshiAmount(900));
+  EXPECT_FALSE(base_txid.Equals(tx.GetTxid()));
+  EXPECT_STREQ(
+      Transaction(tx.GetHex()).GetTxid().GetHex().c_str(),
+      tx.GetTxid().GetHex().c_str());
+  tx.RemoveScriptWitnessStackAll(0);
+  EXPECT_EQ(base_vsize, tx.GetVsize());
+  EXPECT_EQ(
+      tx.GetTxid().GetData().GetHex(), tx.GetWitnessHash().GetHex());
+}
+
 TEST(Transaction, GetSignatureHash) {
   {
     // witness
@@ -448,6 +646,167 @@ TEST(Transaction, GetSignatureHash) {
   }
 }
 
+TEST(Transaction, GetSignatureHashMultiThread) {
+  static constexpr uint32_t kTxInCount = 64;
+  static constexpr uint32_t kThreadCount = 4;
+  Txid txid("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+  ByteData script("76a9141d0f172a0ecb48aee1be1f2687d2963ae33f71a188ac");
+  Transaction base_tx(2, 0);
+  for (uint32_t index = 0; index < kTxInCount; ++index) {
+    base_tx.AddTxIn(txid, index, 0xffffffff);
+  }
+  base_tx.AddTxOut(Amount(int64_t{10000}), Script(script));
+  base_tx.AddTxOut(Amount(int64_t{20000}), Script(script));
+  SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  Amount amount = Amount::CreateBySatoshiAmount(50000);
+
+  std::vector<std::string> expect_list;
+  for (uint32_t index = 0; index < kTxInCount; ++index) {
+    expect_list.push_back(Transaction(base_tx.GetHex())
+        .GetSignatureHash(index, script, sighash_type, amount,
+            WitnessVersion::kVersion0)
+        .GetHex());
+  }
+
+  // every thread signs all inputs of the shared transaction.
+  const Transaction tx(base_tx.GetHex());
+  std::vector<std::vector<std::string>> result_list(kThreadCount);
+  std::vector<std::thread> workers;
+  for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+    workers.emplace_back([&, thread]() {
+      for (uint32_t count = 0; count < kTxInCount; ++count) {
+        uint32_t index = (count + thread * 16) % kTxInCount;
+        result_list[thread].push_back(tx.GetSignatureHash(
+            index, script, sighash_type, amount, WitnessVersion::kVersion0)
+            .GetHex());
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+    ASSERT_EQ(kTxInCount, result_list[thread].size());
+    for (uint32_t count = 0; count < kTxInCount; ++count) {
+      uint32_t index = (count + thread * 16) % kTxInCount;
+      EXPECT_EQ(expect_list[index], result_list[thread][count]);
+    }
+  }
+}
+
+TEST(Transaction, GetSignatureHashLegacyMultiThread) {
+  static constexpr uint32_t kTxInCount = 32;
+  static constexpr uint32_t kThreadCount = 4;
+  Txid txid("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+  ByteData script("76a9141d0f172a0ecb48aee1be1f2687d2963ae33f71a188ac");
+  SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  Amount amount = Amount::CreateBySatoshiAmount(50000);
+  Transaction tx(2, 0);
+  tx.AddTxOut(Amount(int64_t{10000}), Script(script));
+  std::vector<std::string> expect_list;
+  {
+    Transaction expect_tx(tx);
+    for (uint32_t index = 0; index < kTxInCount; ++index) {
+      expect_tx.AddTxIn(txid, index, 0xffffffff);
+    }
+    expect_tx = Transaction(expect_tx.GetHex());
+    for (uint32_t index = 0; index < kTxInCount; ++index) {
+      expect_list.push_back(expect_tx.GetSignatureHash(
+          index, script, sighash_type, amount, WitnessVersion::kVersionNone)
+          .GetHex());
+    }
+  }
+
+  // the libwally structure is rebuilt by the first of the threads.
+  for (uint32_t index = 0; index < kTxInCount; ++index) {
+    tx.AddTxIn(txid, index, 0xffffffff);
+  }
+  const uint32_t vsize = Transaction(tx.GetHex()).GetVsize();
+  std::vector<std::vector<std::string>> result_list(kThreadCount);
+  std::vector<uint32_t> vsize_list(kThreadCount);
+  std::vector<std::thread> workers;
+  for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+    workers.emplace_back([&, thread]() {
+      for (uint32_t index = 0; index < kTxInCount; ++index) {
+        result_list[thread].push_back(tx.GetSignatureHash(
+            index, script, sighash_type, amount, WitnessVersion::kVersionNone)
+            .GetHex());
+      }
+      vsize_list[thread] = tx.GetVsize();
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+    EXPECT_EQ(expect_list, result_list[thread]);
+    EXPECT_EQ(vsize, vsize_list[thread]);
+  }
+}
+
+TEST(Transaction, GetSignatureHashWitnessV0Cache) {
+  Transaction tx(
+      "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac11000000");
+  ByteData script("76a9141d0f172a0ecb48aee1be1f2687d2963ae33f71a188ac");
+  Amount amount = Amount::CreateByCoinAmount(6);
+  ByteData256 sighash;
+
+  // sighash type variations share the cached hashes.
+  sighash = tx.GetSignatureHash(1, script,
+      SigHashType(SigHashAlgorithm::kSigHashSingle), amount,
+      WitnessVersion::kVersion0);
+  EXPECT_EQ("f4fe57286dd2ca8ac0e3dfccd54c352fcdcacbed80f194e264b75d7a7c74e4ce",
+      sighash.GetHex());
+  sighash = tx.GetSignatureHash(1, script,
+      SigHashType(SigHashAlgorithm::kSigHashNone, true), amount,
+      WitnessVersion::kVersion0);
+  EXPECT_EQ("4abb5ef58a968f8e1ab88a9fb72f2ce74b3022e65d334ac7b8aeda747515dc15",
+      sighash.GetHex());
+  sighash = tx.GetSignatureHash(0, script,
+      SigHashType(SigHashAlgorithm::kSigHashAll, true), amount,
+      WitnessVersion::kVersion0);
+  EXPECT_EQ("bf5cca3b825ebe7471d04cfd2d5f8b718520f5937258397a39fb9482b589a21f",
+      sighash.GetHex());
+  sighash = tx.GetSignatureHash(1, script,
+      SigHashType(SigHashAlgorithm::kSigHashAll), amount,
+      WitnessVersion::kVersion0);
+  EXPECT_EQ("c37af31116d1b27caf68aae9e3ac82f1477929014d5b917657d0eb49478cb670",
+      sighash.GetHex());
+
+  // cache is cleared by the state change.
+  SigHashType sighashtype(SigHashAlgorithm::kSigHashAll);
+  tx.SetTxInSequence(0, 0xfffffffd);
+  Transaction tx2(tx.GetHex());
+  EXPECT_EQ(
+      tx2.GetSignatureHash(1, script, sighashtype, amount,
+          WitnessVersion::kVersion0).GetHex(),
+      tx.GetSignatureHash(1, script, sighashtype, amount,
+          WitnessVersion::kVersion0).GetHex());
+
+  tx.SetTxOutValue(0, Amount(int64_t{10000}));
+  tx.AddTxOut(Amount(int64_t{20000}), Script(script));
+  Transaction tx3(tx.GetHex());
+  EXPECT_EQ(
+      tx3.GetSignatureHash(1, script, sighashtype, amount,
+          WitnessVersion::kVersion0).GetHex(),
+      tx.GetSignatureHash(1, script, sighashtype, amount,
+          WitnessVersion::kVersion0).GetHex());
+
+  tx.AddTxIn(Txid(
+      "1aa8c0ae2bbff67b2e7a0fcd35a4fbba6ed7e1d8dc9a4d5aef7d9acc6b2a3f0e"),
+      1, 0xffffffff);
+  Transaction tx4(tx.GetHex());
+  EXPECT_EQ(
+      tx4.GetSignatureHash(2, script, sighashtype, amount,
+          WitnessVersion::kVersion0).GetHex(),
+      tx.GetSignatureHash(2, script, sighashtype, amount,
+          WitnessVersion::kVersion0).GetHex());
+  EXPECT_NE(sighash.GetHex(),
+      tx.GetSignatureHash(1, script, sighashtype, amount,
+          WitnessVersion::kVersion0).GetHex());
+
+  EXPECT_THROW(tx.GetSignatureHash(3, script, sighashtype, amount,
+      WitnessVersion::kVersion0), CfdException);
+}
+
 TEST(Transaction, CheckTxOutBuffer) {
   Transaction tx(
       "0200000000010000000000000000220020c5ae4ff17cec055e964b573601328f3f879fa441e53ef88acdfd4d8e8df429ef00000000");
@@ -467,6 +826,36 @@ TEST(Transaction, CheckTxOutBuffer) {
   EXPECT_EQ(tx.GetTxOutCount(), 1);
 }
 
+TEST(Transaction, ConstructorFromBytes) {
+  std::vector<std::string> tx_list = {
+      exp_tx_witness,
+      exp_tx_legacy,
+      "0200000000010000000000000000220020c5ae4ff17cec055e964b573601328f3f879fa441e53ef88acdfd4d8e8df429ef00000000",
+      "0200000000000000000000",
+  };
+  for (const auto& tx_hex : tx_list) {
+    SCOPED_TRACE(tx_hex);
+    ByteData tx_data(tx_hex);
+    Transaction tx(tx_data);
+    Transaction hex_tx(tx_hex);
+    EXPECT_EQ(tx_hex, tx.GetHex());
+    EXPECT_EQ(hex_tx.GetTxInCount(), tx.GetTxInCount());
+    EXPECT_EQ(hex_tx.GetTxOutCount(), tx.GetTxOutCount());
+    EXPECT_EQ(hex_tx.GetTxid().GetHex(), tx.GetTxid().GetHex());
+  }
+
+  ByteData empty_data;
+  ByteData short_data("0200000000");
+  EXPECT_THROW(Transaction tx(empty_data), CfdException);
+  EXPECT_THROW(Transaction tx(short_data), CfdException);
+  try {
+    Transaction tx("02000000zz");
+    EXPECT_STREQ("", "not reached");
+  } catch (const CfdException& except) {
+    EXPECT_STREQ("transaction data invalid.", except.what());
+  }
+}
+
 TEST(Transaction, GetSchnorrSignatureHash) {
   Privkey key("305e293b010d29bf3c888b617763a438fee9054c8cab66eb12ad078f819d9f27");
   Pubkey pubkey = key.GeneratePubkey();
@@ -519,6 +908,91 @@ TEST(Transaction, GetSchnorrSignatureHash) {
   EXPECT_TRUE(schnorr_pubkey.Verify(schnorr_sig, sighash2));
 }
 
+TEST(Transaction, GetSchnorrSignatureHashContext) {
+  Script locking_script = ScriptUtil::CreateTaprootLockingScript(
+      ByteData256("1777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb"));
+  Address addr("bcrt1qze8fshg0eykfy7nxcr96778xagufv2w429wx40");
+  Transaction tx(2, 0);
+  std::vector<TxOut> utxo_list;
+  for (uint32_t index = 0; index < 3; ++index) {
+    tx.AddTxIn(
+        Txid("2fea883042440d030ca5929814ead927075a8f52fef5f4720fa3cec2e475d916"),
+        index, 0xffffffff);
+    tx.AddTxOut(Amount(int64_t{1000000} + index), addr.GetLockingScript());
+    utxo_list.emplace_back(Amount(int64_t{2000000} + index), locking_script);
+  }
+  cfd::core::TaprootSigHashContext context(tx, utxo_list);
+  EXPECT_EQ(3, context.GetTxInCount());
+  EXPECT_EQ(3, context.GetTxOutCount());
+
+  cfd::core::TapScriptData script_data;
+  script_data.tap_leaf_hash = ByteData256(
+      "cb3b2d8d3a3bb04d3b5e6a4e8bd1bc8b3b0f5cdde39d0d0e0c2bd3a5bcd4b1f1");
+  std::vector<SigHashType> sighash_types = {
+      SigHashType(),
+      SigHashType(SigHashAlgorithm::kSigHashAll, true),
+      SigHashType(SigHashAlgorithm::kSigHashNone),
+      SigHashType(SigHashAlgorithm::kSigHashSingle, true),
+  };
+  for (const auto& sighash_type : sighash_types) {
+    for (uint32_t index = 0; index < 3; ++index) {
+      EXPECT_EQ(
+          tx.GetSchnorrSignatureHash(index, sighash_type, utxo_list).GetHex(),
+          tx.GetSchnorrSignatureHash(index, sighash_type, context).GetHex());
+      EXPECT_EQ(
+          tx.GetSchnorrSignatureHash(
+              index, sighash_type, utxo_list, &script_data).GetHex(),
+          tx.GetSchnorrSignatureHash(
+              index, sighash_type, context, &script_data).GetHex());
+    }
+  }
+
+  // signing does not change the state the context was built from.
+  tx.AddScriptWitnessStack(0, ByteData("00"));
+  EXPECT_NO_THROW(tx.GetSchnorrSignatureHash(0, SigHashType(), context));
+  cfd::core::TaprootSigHashContext copy_context(Transaction(tx), utxo_list);
+  EXPECT_NO_THROW(tx.GetSchnorrSignatureHash(0, SigHashType(), copy_context));
+
+  // a changed sequence or output value keeps the counts but not the state.
+  const auto before = tx.GetSchnorrSignatureHash(1, SigHashType(), utxo_list);
+  tx.SetTxInSequence(2, 0xfffffffe);
+  EXPECT_THROW(tx.GetSchnorrSignatureHash(0, SigHashType(), context),
+      CfdException);
+  const auto after = tx.GetSchnorrSignatureHash(1, SigHashType(), utxo_list);
+  EXPECT_NE(before.GetHex(), after.GetHex());
+  EXPECT_EQ(
+      cfd::core::TaprootSigHashContext(tx, utxo_list).GetShaSequences()
+          .GetHex(),
+      cfd::core::TaprootSigHashContext(Transaction(tx.GetHex()), utxo_list)
+          .GetShaSequences().GetHex());
+  tx.SetTxOutValue(0, Amount(int64_t{999999}));
+  EXPECT_NE(after.GetHex(),
+      tx.GetSchnorrSignatureHash(1, SigHashType(), utxo_list).GetHex());
+  EXPECT_EQ(
+      Transaction(tx).GetSchnorrSignatureHash(1, SigHashType(), utxo_list)
+          .GetHex(),
+      tx.GetSchnorrSignatureHash(1, SigHashType(), utxo_list).GetHex());
+
+  // the cached hashes follow the utxo list.
+  std::vector<TxOut> other_utxo_list = utxo_list;
+  other_utxo_list[2] = TxOut(Amount(int64_t{5000}), locking_script);
+  Transaction other_tx(tx);
+  EXPECT_EQ(
+      other_tx.GetSchnorrSignatureHash(1, SigHashType(), other_utxo_list)
+          .GetHex(),
+      tx.GetSchnorrSignatureHash(1, SigHashType(), other_utxo_list).GetHex());
+  EXPECT_NE(
+      tx.GetSchnorrSignatureHash(1, SigHashType(), utxo_list).GetHex(),
+      tx.GetSchnorrSignatureHash(1, SigHashType(), other_utxo_list).GetHex());
+
+  // context is not match to updated transaction.
+  tx.AddTxOut(Amount(int64_t{1000}), addr.GetLockingScript());
+  EXPECT_THROW(tx.GetSchnorrSignatureHash(0, SigHashType(), context),
+      CfdException);
+  EXPECT_THROW(cfd::core::TaprootSigHashContext(tx, std::vector<TxOut>(2)),
+      CfdException);
+}
+
 TEST(Transaction, GetSchnorrSignatureHashNonce) {
   Privkey key("305e293b010d29bf3c888b617763a438fee9054c8cab66eb12ad078f819d9f27");
   Pubkey pubkey = key.GeneratePubkey();
@@ -609,3 +1083,84 @@ TEST(Transaction, SetTxInSequence) {
       "02000000000101ffa8db90b81db256874ff7a98fb7202cdc0b91b5b02d7c3427c4190adc66981f0000000000feffffff0118f50295000000002251201777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb02473044022018b10265080f8c491c43595000461a19212239fea9ee4c6fd26498f358b1760d0220223c1389ac26a2ed5f77ad73240af2fa6eb30ef5d19520026c2f7b7e817592530121023179b32721d07deb06cade59f56dedefdc932e89fde56e998f7a0e93a3e30c4400000000",
       tx.GetHex());
 }
+
+TEST(TransactionView, ParseWitnessTx) {
+  ByteData data(exp_tx_witness);
+  Transaction tx(data);
+  TransactionView view(data.GetBytes().data(), data.GetDataSize());
+  EXPECT_TRUE(view.IsValid());
+  EXPECT_EQ(exp_version, view.GetVersion());
+  EXPECT_EQ(exp_locktime, view.GetLockTime());
+  EXPECT_TRUE(view.HasWitness());
+  EXPECT_EQ(tx.GetTxid().GetHex(), view.GetTxid().GetHex());
+  EXPECT_EQ(tx.GetWitnessHash().GetHex(), view.GetWitnessHash().GetHex());
+  EXPECT_EQ(tx.GetTotalSize(), view.GetTotalSize());
+  EXPECT_EQ(tx.GetVsize(), view.GetVsize());
+  EXPECT_EQ(tx.GetWeight(), view.GetWeight());
+
+  ASSERT_EQ(tx.GetTxInCount(), view.GetTxInCount());
+  const TxInView& txin = view.GetTxIn(0);
+  EXPECT_EQ(tx.GetTxIn(0).GetTxid().GetHex(), txin.GetTxid().GetHex());
+  EXPECT_EQ(tx.GetTxIn(0).GetVout(), txin.GetVout());
+  EXPECT_EQ(tx.GetTxIn(0).GetSequence(), txin.GetSequence());
+  EXPECT_EQ(
+      tx.GetTxIn(0).GetUnlockingScript().GetHex(),
+      StringUtil::ByteToString(txin.GetUnlockingScriptView()));
+  EXPECT_FALSE(txin.IsCoinBase());
+  EXPECT_EQ(2, txin.GetScriptWitnessStackNum());
+  EXPECT_EQ(
+      tx.GetTxIn(0).GetScriptWitness().GetWitness()[1].GetHex(),
+      StringUtil::ByteToString(txin.GetScriptWitnessStack(1)));
+  EXPECT_EQ(
+      tx.GetTxIn(0).GetScriptWitness().GetWitness()[0].GetHex(),
+      txin.GetScriptWitness().GetWitness()[0].GetHex());
+  EXPECT_THROW(txin.GetScriptWitnessStack(2), CfdException);
+  EXPECT_THROW(view.GetTxIn(1), CfdException);
+
+  ASSERT_EQ(tx.GetTxOutCount(), view.GetTxOutCount());
+  uint32_t index = 0;
+  for (const TxOutView& txout : view.GetTxOutList()) {
+    EXPECT_EQ(
+        tx.GetTxOut(index).GetValue().GetSatoshiValue(),
+        txout.GetValue().GetSatoshiValue());
+    EXPECT_EQ(
+        tx.GetTxOut(index).GetLockingScript().GetHex(),
+        txout.GetLockingScript().GetHex());
+    ++index;
+  }
+  EXPECT_THROW(view.GetTxOut(2), CfdException);
+  EXPECT_EQ(exp_tx_witness, view.GetTransaction().GetHex());
+}
+
+TEST(TransactionView, ParseLegacyTx) {
+  ByteData data(exp_tx_legacy);
+  Transaction tx(data);
+  TransactionView view(data.GetBytes().data(), data.GetDataSize());
+  EXPECT_FALSE(view.HasWitness());
+  EXPECT_EQ(tx.GetTxid().GetHex(), view.GetTxid().GetHex());
+  EXPECT_EQ(tx.GetVsize(), view.GetVsize());
+  EXPECT_EQ(tx.GetWeight(), view.GetWeight());
+  ASSERT_EQ(1, view.GetTxInCount());
+  EXPECT_EQ(0, view.GetTxIn(0).GetScriptWitnessStackNum());
+  EXPECT_EQ(
+      tx.GetTxIn(0).GetUnlockingScript().GetHex(),
+      StringUtil::ByteToString(view.GetTxIn(0).GetUnlockingScriptView()));
+  ASSERT_EQ(1, view.GetTxOutCount());
+  EXPECT_EQ(
+      tx.GetTxOut(0).GetValue().GetSatoshiValue(),
+      view.GetTxOut(0).GetValue().GetSatoshiValue());
+}
+
+TEST(TransactionView, ParseError) {
+  TransactionView empty_view;
+  EXPECT_FALSE(empty_view.IsValid());
+  EXPECT_EQ(0, empty_view.GetTxInCount());
+
+  std::vector<uint8_t> bytes = ByteData(exp_tx_legacy).GetBytes();
+  std::vector<uint8_t> short_bytes(bytes.begin(), bytes.end() - 1);
+  EXPECT_THROW(
+      TransactionView(short_bytes.data(), short_bytes.size()), CfdException);
+  bytes.push_back(0);
+  EXPECT_THROW(TransactionView(bytes.data(), bytes.size()), CfdException);
+  EXPECT_THROW(TransactionView(nullptr, 0), CfdException);
+}
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_common.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_transaction.h"
+#include "cfdcore/cfdcore_transaction_stream.h"
+
+using cfd::core::ByteData;
+using cfd::core::ByteDataView;
+using cfd::core::CfdError;
+using cfd::core::CfdException;
+using cfd::core::IStreamTransactionStreamSource;
+using cfd::core::MemoryTransactionStreamSource;
+using cfd::core::Transaction;
+using cfd::core::TransactionStreamReader;
+using cfd::core::TransactionStreamSource;
+using cfd::core::TransactionView;
+
+static const std::string exp_tx_witness =
+    "02000000000101f1993fe8e7189542ee4506258e170201be292703cd275acb09ece16672fd848b0000000017160014703e50206e4d27ad1340a7b6a0d94563a3fb768afeffffff02080410240100000017a9141e60c63c6d099ee2b48eded11acfdf3a79a891f48700e1f5050000000017a9142699570770f32e0cf3e1d12d81064fbc45899e8a870247304402202b12edc9a75edd70a0e4261c5816efa2c5256e3f8bcffdd49182bd9f791c74e902201e3ae5c1062a83d787098322b3071fe68c4b181e0088b0e0087020495adaf6e3012102f466d403c0c4057257e7bcbed1d172880fe75f337c77df5490ad9bc8cc2d6a1600000000";
+static const std::string exp_tx_legacy =
+    "0200000001c6d2ea36e2e802b52ddac665dacbed2f831b5263459e1ca734f5c945d7515e40000000006a47304402205a2f94921f645669b2b4e073da43e6a5d32335b50207f9d27f0e8a8c0a24e75902205dea52d27ad747f2df786e0ad737595cf9c5a489143170668399764a5b4be44a01210229e026bab56c1c41d16e67f084362aef204b5b7ea08dafc2fb2e0db89d9c9551feffffff0178de052a0100000017a914d8de653e7763cc37305a00fc79a491ab70e2e5cb8700000000";
+
+// stream source of the prefix followed by endless zero bytes.
+class EndlessTransactionStreamSource : public TransactionStreamSource {
+ public:
+  explicit EndlessTransactionStreamSource(const ByteData& prefix)
+      : prefix_(prefix.GetBytes()), offset_(0), read_count_(0) {}
+  virtual size_t Read(uint8_t* buffer, size_t size) {
+    ++read_count_;
+    memset(buffer, 0, size);
+    size_t prefix_size = std::min(size, prefix_.size() - offset_);
+    if (prefix_size != 0) memcpy(buffer, &prefix_[offset_], prefix_size);
+    offset_ += prefix_size;
+    return size;
+  }
+  size_t GetReadCount() const { return read_count_; }
+
+ private:
+  std::vector<uint8_t> prefix_;
+  size_t offset_;
+  size_t read_count_;
+};
+
+TEST(TransactionStreamReader, ReadConcatenated) {
+  std::vector<std::string> tx_list = {
+      exp_tx_witness, exp_tx_legacy, exp_tx_witness, exp_tx_legacy};
+  std::string stream_hex;
+  for (const auto& tx_hex : tx_list) stream_hex += tx_hex;
+  ByteData stream_data(stream_hex);
+  MemoryTransactionStreamSource source((ByteDataView(stream_data)));
+  // small chunk to read each transaction across several chunks.
+  TransactionStreamReader reader(
+      &source, cfd::core::kTxStreamConcatenated, 16, 1024);
+
+  TransactionView view;
+  uint64_t offset = 0;
+  for (const auto& tx_hex : tx_list) {
+    EXPECT_EQ(offset, reader.GetStreamOffset());
+    ASSERT_TRUE(reader.ReadNext(&view));
+    EXPECT_EQ(tx_hex, ByteData(view.GetData().data(), view.GetTotalSize())
+                          .GetHex());
+    EXPECT_EQ(Transaction(tx_hex).GetTxid().GetHex(), view.GetTxid().GetHex());
+    offset += tx_hex.length() / 2;
+  }
+  EXPECT_FALSE(reader.ReadNext(&view));
+  EXPECT_EQ(tx_list.size(), reader.GetReadCount());
+  EXPECT_EQ(stream_data.GetDataSize(), reader.GetStreamOffset());
+}
+
+TEST(TransactionStreamReader, ReadLengthPrefixed) {
+  ByteData stream_data = ByteData(exp_tx_legacy).Serialize().Concat(
+      ByteData(exp_tx_witness).Serialize());
+  std::istringstream stream(
+      std::string(stream_data.GetBytes().begin(), stream_data.GetBytes().end()),
+      std::ios::in | std::ios::binary);
+  IStreamTransactionStreamSource source(&stream);
+  TransactionStreamReader reader(
+      &source, cfd::core::kTxStreamLengthPrefixed, 32, 1024);
+
+  Transaction tx;
+  ASSERT_TRUE(reader.ReadNext(&tx));
+  EXPECT_EQ(exp_tx_legacy, tx.GetHex());
+  ASSERT_TRUE(reader.ReadNext(&tx));
+  EXPECT_EQ(exp_tx_witness, tx.GetHex());
+  EXPECT_FALSE(reader.ReadNext(&tx));
+  EXPECT_EQ(2, reader.GetReadCount());
+}
+
+TEST(TransactionStreamReader, ReadCountPrefixed) {
+  // transaction count and transactions, followed by other data.
+  ByteData stream_data("02" + exp_tx_witness + exp_tx_legacy + "ffff");
+  MemoryTransactionStreamSource source((ByteDataView(stream_data)));
+  TransactionStreamReader reader(&source, cfd::core::kTxStreamCountPrefixed);
+
+  TransactionView view;
+  ASSERT_TRUE(reader.ReadNext(&view));
+  EXPECT_TRUE(view.HasWitness());
+  ASSERT_TRUE(reader.ReadNext(&view));
+  EXPECT_FALSE(view.HasWitness());
+  EXPECT_FALSE(reader.ReadNext(&view));
+  EXPECT_EQ(2, reader.GetReadCount());
+}
+
+TEST(TransactionStreamReader, ReadError) {
+  TransactionView view;
+  {
+    // truncated transaction
+    ByteData stream_data(exp_tx_legacy + exp_tx_witness.substr(0, 100));
+    MemoryTransactionStreamSource source((ByteDataView(stream_data)));
+    TransactionStreamReader reader(&source);
+    EXPECT_TRUE(reader.ReadNext(&view));
+    EXPECT_THROW(reader.ReadNext(&view), CfdException);
+  }
+  {
+    // transaction exceeds the maximum buffer size
+    ByteData stream_data(exp_tx_legacy);
+    MemoryTransactionStreamSource source((ByteDataView(stream_data)));
+    TransactionStreamReader reader(
+        &source, cfd::core::kTxStreamConcatenated, 16, 64);
+    EXPECT_THROW(reader.ReadNext(&view), CfdException);
+  }
+  {
+    // count prefix larger than the transaction count
+    ByteData stream_data("02" + exp_tx_legacy);
+    MemoryTransactionStreamSource source((ByteDataView(stream_data)));
+    TransactionStreamReader reader(
+        &source, cfd::core::kTxStreamCountPrefixed);
+    EXPECT_TRUE(reader.ReadNext(&view));
+    EXPECT_THROW(reader.ReadNext(&view), CfdException);
+  }
+  {
+    // script length over the maximum buffer size is rejected before
+    // the buffer is filled.
+    ByteData prefix("0200000001" + std::string(72, '0') + "fe00000001");
+    EndlessTransactionStreamSource source(prefix);
+    TransactionStreamReader reader(&source);
+    try {
+      reader.ReadNext(&view);
+      ADD_FAILURE();
+    } catch (const CfdException& except) {
+      EXPECT_EQ(CfdError::kCfdIllegalArgumentError, except.GetErrorCode());
+    }
+    EXPECT_EQ(1, source.GetReadCount());
+  }
+  EXPECT_THROW(TransactionStreamReader(nullptr), CfdException);
+}
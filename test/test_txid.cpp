@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <unordered_map>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -81,3 +82,26 @@ TEST(Txid, IsValid) {
   Txid empty_txid;
   EXPECT_FALSE(empty_txid.IsValid());
 }
+
+TEST(Txid, OperatorsAndHash) {
+  Txid txid1("3412907856341290785634129078563412907856341290785634129078563412");
+  Txid txid2("3412907856341290785634129078563412907856341290785634129078563412");
+  Txid txid3("0000000000000000000000000000000000000000000000000000000000000001");
+  EXPECT_TRUE(txid1 == txid2);
+  EXPECT_FALSE(txid1 != txid2);
+  EXPECT_TRUE(txid1 != txid3);
+  EXPECT_TRUE(txid1 != Txid());
+  EXPECT_FALSE(txid1 < txid2);
+  EXPECT_TRUE((txid1 < txid3) != (txid3 < txid1));
+  EXPECT_TRUE(Txid() < Txid(ByteData256()));
+  EXPECT_EQ(txid1.GetByteData256().GetHex(), txid1.GetData().GetHex());
+
+  std::hash<Txid> hasher;
+  EXPECT_EQ(hasher(txid1), hasher(txid2));
+  std::unordered_map<Txid, int> map;
+  map[txid1] = 1;
+  map[txid3] = 3;
+  EXPECT_EQ(map.size(), static_cast<size_t>(2));
+  EXPECT_EQ(map[txid2], 1);
+  EXPECT_EQ(map.count(Txid()), static_cast<size_t>(0));
+}
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include <string>
+#include <utility>
 
 #include "cfdcore/cfdcore_address.h"
 #include "cfdcore/cfdcore_coin.h"
@@ -46,6 +47,28 @@ TEST(TxIn, Constractor) {
   }
 }
 
+TEST(TxIn, MoveAndReferenceAccessor) {
+  TxIn txin(exp_txid, exp_index, exp_sequence, exp_script);
+  txin.AddScriptWitnessStack(exp_script.GetData());
+  const Script& unlocking_script = txin.GetUnlockingScript();
+  EXPECT_EQ(&unlocking_script, &txin.GetUnlockingScript());
+  EXPECT_EQ(&txin.GetTxid(), &txin.GetTxid());
+
+  TxIn moved(std::move(txin));
+  EXPECT_STREQ(moved.GetTxid().GetHex().c_str(), exp_txid.GetHex().c_str());
+  EXPECT_EQ(moved.GetVout(), exp_index);
+  EXPECT_STREQ(moved.GetUnlockingScript().GetHex().c_str(),
+               exp_script.GetHex().c_str());
+  EXPECT_EQ(moved.GetScriptWitness().GetWitnessNum(), 1);
+
+  TxInReference txin_ref(moved);
+  TxInReference assigned;
+  assigned = std::move(txin_ref);
+  EXPECT_STREQ(assigned.GetUnlockingScript().GetHex().c_str(),
+               exp_script.GetHex().c_str());
+  EXPECT_EQ(assigned.GetScriptWitness().GetWitness().size(), 1);
+}
+
 TEST(TxIn, EstimateTxInSize) {
   static const std::vector<TestEstimateTxInSizeVector> test_vector = {
     {AddressType::kP2pkhAddress, 150, 0, Script()},